@@ -15,6 +15,7 @@ depopt(GZN_BUILD_BENCHMARKS "Build & Run benchmarks" ON GZN_DEV_MODE OFF)
 depopt(GZN_VERBOSE_LOGGING  "Enable verbose logging" ON GZN_DEV_MODE OFF)
 
 option(GZN_DISABLE_ASSERTIONS "Forcely disable assertions in debug mode" OFF)
+option(GZN_INTERNED_NAMES "Store names as ids into a global intern table" OFF)
 
 
 function(gzn_msg status)
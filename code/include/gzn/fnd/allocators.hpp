@@ -2,6 +2,7 @@
 
 #include <array>
 #include <concepts>
+#include <cstdint>
 #include <string_view>
 #include <utility>
 
@@ -10,6 +11,42 @@
 
 namespace gzn::fnd {
 
+namespace constants {
+
+usize static constexpr cache_line_bytes{ 64 };
+
+} // namespace constants
+
+/**
+ * Bits of the `flags` argument of `allocate`. Allocators are free to ignore
+ * the ones they can't honour.
+ */
+namespace allocation_flags {
+
+u32 static constexpr none{ 0 };
+/// Fill the new block with zeroes
+u32 static constexpr zeroed{ 1u << 0 };
+/// Back big blocks with huge pages to cut TLB misses
+u32 static constexpr huge_pages{ 1u << 1 };
+/// The node set with @ref numa_node is valid
+u32 static constexpr numa_bound{ 1u << 2 };
+
+u32 static constexpr numa_node_shift{ 8 };
+u32 static constexpr numa_node_mask{ 0xffu << numa_node_shift };
+
+/// Allocate on the given NUMA node
+[[nodiscard]]
+constexpr auto numa_node(u32 const node) noexcept -> u32 {
+  return numa_bound | ((node << numa_node_shift) & numa_node_mask);
+}
+
+[[nodiscard]]
+constexpr auto numa_node_of(u32 const flags) noexcept -> u32 {
+  return (flags & numa_node_mask) >> numa_node_shift;
+}
+
+} // namespace allocation_flags
+
 namespace util {
 
 template<class T>
@@ -21,6 +58,28 @@ concept allocator_type = requires(T *allocator) {
   { allocator->get_label() } -> std::convertible_to<std::string_view>;
 } && std::constructible_from<cstr>;
 
+/// Allocator able to grow or shrink a block without moving it. Shrinking
+/// succeeds only when the tail is given back. On failure the block is left
+/// untouched.
+template<class T>
+concept expandable_allocator_type =
+  allocator_type<T> && requires(T *allocator) {
+    {
+      allocator->try_expand((void *)0, u32{}, u32{})
+    } -> std::same_as<bool>;
+  };
+
+/// Allocator able to resize a block, moving its bytes if needed. Only valid
+/// for bitwise-relocatable contents. On failure nullptr is returned and the
+/// old block stays valid.
+template<class T>
+concept reallocatable_allocator_type =
+  allocator_type<T> && requires(T *allocator) {
+    {
+      allocator->reallocate((void *)0, u32{}, u32{}, u32{})
+    } -> std::same_as<void *>;
+  };
+
 constexpr auto memory_align(u32 const size, u32 const alignment) noexcept
   -> u32 {
   u32 const alignment_mask{ alignment - 1 };
@@ -121,6 +180,13 @@ public:
   }
 };
 
+/**
+ * mimalloc-backed general purpose allocator. Honours every
+ * @ref allocation_flags bit. NUMA binding needs huge OS pages reserved on
+ * the node, which is opt-in through @ref set_numa_reservation; without
+ * them mimalloc's node-local default applies, a failed reservation is
+ * logged once per node.
+ */
 class base_allocator {
 public:
   constexpr explicit base_allocator(cstr label = "base_allocator") noexcept
@@ -144,6 +210,24 @@ public:
 
   void deallocate(void *memory, u32 count, u32 alignment);
 
+  /// Sets how many pinned 1 GiB huge pages the first @ref numa_node bound
+  /// allocation reserves on its node. 0, the default, skips the
+  /// reservation: binding then falls back to the node-local default. Nodes
+  /// which already tried to reserve keep their arena.
+  static void set_numa_reservation(u32 huge_pages_count);
+
+  /// Grows only: mimalloc keeps the whole block when asked for less
+  [[nodiscard]]
+  auto try_expand(void *memory, u32 bytes_count, u32 new_bytes_count) -> bool;
+
+  [[nodiscard]]
+  auto reallocate(
+    void *memory,
+    u32   bytes_count,
+    u32   new_bytes_count,
+    u32   alignment
+  ) -> void *;
+
   [[nodiscard]]
   constexpr auto get_label() const noexcept -> std::string_view {
     return label;
@@ -178,10 +262,10 @@ public:
   ) -> void * {
 
     gzn_assertion(
-      bytes_count + top >= BytesCount,
+      bytes_count + top <= BytesCount,
       "Not enough stack storage for this allocation"
     );
-    if (bytes_count + top >= BytesCount) { return nullptr; }
+    if (bytes_count + top > BytesCount) { return nullptr; }
     auto const old_top{ std::exchange(top, top + bytes_count) };
     return &data[old_top];
   }
@@ -193,22 +277,40 @@ public:
     u32 const                  offset,
     [[maybe_unused]] u32 const flags = 0
   ) -> void * {
-    auto const aligned_count{ util::memory_align(bytes_count, alignment) };
-    auto const total_memory_required{ offset + aligned_count };
+    auto const address{ reinterpret_cast<uintptr_t>(std::data(data)) + top };
+    auto const misalignment{ (address + offset) & (alignment - 1) };
+    auto const padding{ (alignment - misalignment) & (alignment - 1) };
 
-    if (top + total_memory_required >= BytesCount) {
+    if (top + padding + bytes_count > BytesCount) {
       gzn_do_assertion("Not enough stack storage for this allocation");
       return nullptr;
     }
 
-    auto const old_top{ std::exchange(top, top + total_memory_required) };
-    return &data[offset + old_top];
+    auto const old_top{ std::exchange(top, top + padding + bytes_count) };
+    return &data[old_top + padding];
   }
 
   constexpr void deallocate(void *, u32) {}
 
   constexpr void deallocate(void *, u32, u32) {}
 
+  /// Only the last allocation can change its size
+  [[nodiscard]]
+  constexpr auto try_expand(
+    void     *memory,
+    u32 const bytes_count,
+    u32 const new_bytes_count
+  ) noexcept -> bool {
+    auto const begin{ static_cast<usize>(
+      static_cast<byte *>(memory) - std::data(data)
+    ) };
+    if (begin + bytes_count != top) { return false; }
+    if (begin + new_bytes_count > BytesCount) { return false; }
+
+    top = begin + new_bytes_count;
+    return true;
+  }
+
   constexpr void reset() { top = 0; }
 
   [[nodiscard]]
@@ -0,0 +1,509 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr block_pool_page_bytes_count{ 64 * 1024 };
+
+} // namespace constants
+
+namespace details {
+
+struct block_pool_page {
+  block_pool_page *next{ nullptr };
+  usize            bytes_count{};
+};
+
+/// Rounds the block size up so a block can hold the free-list link and keeps
+/// every block in a page aligned, for the link too: packed types may ask for
+/// less than a pointer's alignment.
+[[nodiscard]]
+constexpr auto block_pool_stride(
+  u32 const block_bytes_count,
+  u32 const block_alignment
+) noexcept -> u32 {
+  auto const bytes_count{ std::max<usize>(block_bytes_count, sizeof(void *)) };
+  return static_cast<u32>(util::memory_align(
+    bytes_count, std::max<usize>(block_alignment, alignof(void *))
+  ));
+}
+
+[[nodiscard]]
+constexpr auto block_pool_header_bytes_count(u32 const block_alignment
+) noexcept -> usize {
+  return util::memory_align(
+    sizeof(block_pool_page),
+    std::max<usize>(block_alignment, alignof(block_pool_page))
+  );
+}
+
+} // namespace details
+
+/**
+ * Fixed-size block allocator with O(1) allocate and deallocate. Freed blocks
+ * are threaded into an intrusive free list, fresh blocks are carved from
+ * pages taken from the parent allocator. Pages are kept until @ref release
+ * or destruction. Requests bigger than a block are forwarded to the parent,
+ * block-sized ones the block alignment can't serve (over-aligned or with an
+ * offset breaking the alignment) get nullptr: deallocation tells pool blocks
+ * apart by size only. Not thread-safe, see @ref shared_block_pool_allocator.
+ */
+template<util::allocator_type Parent = base_allocator>
+class block_pool_allocator {
+  struct free_block {
+    free_block *next{ nullptr };
+  };
+
+public:
+  using parent_type = Parent;
+
+  explicit block_pool_allocator(
+    parent_type &parent,
+    u32 const    block_bytes_count,
+    u32 const    block_alignment  = alignof(std::max_align_t),
+    usize const  page_bytes_count = constants::block_pool_page_bytes_count,
+    cstr const   label            = "block_pool_allocator"
+  ) noexcept
+    : m_parent{ &parent }
+    , m_stride{
+      details::block_pool_stride(block_bytes_count, block_alignment)
+    }
+    , m_block_bytes_count{ block_bytes_count }
+    , m_block_alignment{ block_alignment }
+    , m_page_bytes_count{ page_bytes_count }
+    , m_label{ label } {
+    gzn_assertion(
+      block_alignment != 0 && (block_alignment & (block_alignment - 1)) == 0,
+      "Alignment must be a power of 2"
+    );
+  }
+
+  block_pool_allocator(block_pool_allocator const &) = delete;
+
+  block_pool_allocator(block_pool_allocator &&other) noexcept
+    : m_parent{ other.m_parent }
+    , m_pages{ std::exchange(other.m_pages, nullptr) }
+    , m_free{ std::exchange(other.m_free, nullptr) }
+    , m_bump{ std::exchange(other.m_bump, nullptr) }
+    , m_bump_end{ std::exchange(other.m_bump_end, nullptr) }
+    , m_stride{ other.m_stride }
+    , m_block_bytes_count{ other.m_block_bytes_count }
+    , m_block_alignment{ other.m_block_alignment }
+    , m_page_bytes_count{ other.m_page_bytes_count }
+    , m_label{ other.m_label } {}
+
+  ~block_pool_allocator() { release(); }
+
+  auto operator=(block_pool_allocator const &)
+    -> block_pool_allocator & = delete;
+
+  auto operator=(block_pool_allocator &&other) noexcept
+    -> block_pool_allocator & {
+    if (this != &other) {
+      release();
+      m_parent            = other.m_parent;
+      m_pages             = std::exchange(other.m_pages, nullptr);
+      m_free              = std::exchange(other.m_free, nullptr);
+      m_bump              = std::exchange(other.m_bump, nullptr);
+      m_bump_end          = std::exchange(other.m_bump_end, nullptr);
+      m_stride            = other.m_stride;
+      m_block_bytes_count = other.m_block_bytes_count;
+      m_block_alignment   = other.m_block_alignment;
+      m_page_bytes_count  = other.m_page_bytes_count;
+      m_label             = other.m_label;
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    if (!owns(bytes_count)) [[unlikely]] {
+      return m_parent->allocate(bytes_count, flags);
+    }
+    return allocate_block();
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    if (!owns(bytes_count)) [[unlikely]] {
+      return m_parent->allocate(bytes_count, alignment, offset, flags);
+    }
+    if (!fits(bytes_count, alignment, offset)) [[unlikely]] { return nullptr; }
+    return allocate_block();
+  }
+
+  void deallocate(void *memory, u32 const count) {
+    gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+    if (!owns(count)) [[unlikely]] {
+      m_parent->deallocate(memory, count);
+      return;
+    }
+    m_free = new (memory) free_block{ .next = m_free };
+  }
+
+  void deallocate(void *memory, u32 const count, u32 const alignment) {
+    gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+    if (!owns(count)) [[unlikely]] {
+      m_parent->deallocate(memory, count, alignment);
+      return;
+    }
+    m_free = new (memory) free_block{ .next = m_free };
+  }
+
+  /// Returns all the pages to the parent; blocks are invalidated
+  void release() {
+    auto const header_bytes_count{ details::block_pool_header_bytes_count(
+      m_block_alignment
+    ) };
+    for (auto page{ m_pages }; page != nullptr;) {
+      auto const bytes_count{ header_bytes_count + page->bytes_count };
+      m_parent->deallocate(
+        std::exchange(page, page->next),
+        static_cast<u32>(bytes_count),
+        std::max<u32>(m_block_alignment, alignof(details::block_pool_page))
+      );
+    }
+    m_pages    = nullptr;
+    m_free     = nullptr;
+    m_bump     = nullptr;
+    m_bump_end = nullptr;
+  }
+
+  /// Whether a block can serve the request
+  [[nodiscard]]
+  constexpr auto fits(
+    u32 const bytes_count,
+    u32 const alignment = 1,
+    u32 const offset    = 0
+  ) const noexcept -> bool {
+    return owns(bytes_count) && alignment <= m_block_alignment &&
+           offset % alignment == 0;
+  }
+
+  /// Whether the pool, not its parent, is responsible for such a size
+  [[nodiscard]]
+  constexpr auto owns(u32 const bytes_count) const noexcept -> bool {
+    return bytes_count <= m_block_bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto block_bytes_count() const noexcept -> u32 {
+    return m_block_bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  parent_type              *m_parent{ nullptr };
+  details::block_pool_page *m_pages{ nullptr };
+  free_block               *m_free{ nullptr };
+  byte                     *m_bump{ nullptr };
+  byte                     *m_bump_end{ nullptr };
+  u32                       m_stride{};
+  u32                       m_block_bytes_count{};
+  u32                       m_block_alignment{};
+  usize                     m_page_bytes_count{};
+  cstr                      m_label;
+
+  [[nodiscard]]
+  gzn_inline auto allocate_block() -> void * {
+    if (auto block{ m_free }; block) [[likely]] {
+      m_free = block->next;
+      return block;
+    }
+    if (m_bump == m_bump_end && !grow()) [[unlikely]] { return nullptr; }
+    return std::exchange(m_bump, m_bump + m_stride);
+  }
+
+  [[nodiscard]]
+  auto grow() -> bool {
+    auto const header_bytes_count{ details::block_pool_header_bytes_count(
+      m_block_alignment
+    ) };
+    auto const blocks_count{ std::max<usize>(
+      (m_page_bytes_count - std::min(m_page_bytes_count, header_bytes_count)) /
+        m_stride,
+      1
+    ) };
+    auto const payload_bytes_count{ blocks_count * m_stride };
+    auto       memory{ static_cast<byte *>(m_parent->allocate(
+      static_cast<u32>(header_bytes_count + payload_bytes_count),
+      std::max<u32>(m_block_alignment, alignof(details::block_pool_page)),
+      0u,
+      0u
+    )) };
+    if (memory == nullptr) { return false; }
+
+    m_pages    = new (memory) details::block_pool_page{
+      .next = m_pages, .bytes_count = payload_bytes_count
+    };
+    m_bump     = memory + header_bytes_count;
+    m_bump_end = m_bump + payload_bytes_count;
+    return true;
+  }
+};
+
+/**
+ * Thread-safe @ref block_pool_allocator. The free list is a lock-free
+ * Treiber stack whose head packs a 48-bit pointer with a 16-bit ABA tag
+ * bumped on every update. Only growing the pool takes a lock: a fresh page
+ * is split into blocks and pushed onto the stack in one go.
+ */
+template<util::allocator_type Parent = base_allocator>
+class shared_block_pool_allocator {
+  struct free_block {
+    std::atomic<free_block *> next{ nullptr };
+  };
+
+  u64 static constexpr pointer_mask{ (u64{ 1 } << 48) - 1 };
+  u64 static constexpr tag_step{ u64{ 1 } << 48 };
+
+public:
+  using parent_type = Parent;
+
+  explicit shared_block_pool_allocator(
+    parent_type &parent,
+    u32 const    block_bytes_count,
+    u32 const    block_alignment  = alignof(std::max_align_t),
+    usize const  page_bytes_count = constants::block_pool_page_bytes_count,
+    cstr const   label            = "shared_block_pool_allocator"
+  ) noexcept
+    : m_parent{ &parent }
+    , m_stride{
+      details::block_pool_stride(block_bytes_count, block_alignment)
+    }
+    , m_block_bytes_count{ block_bytes_count }
+    , m_block_alignment{ block_alignment }
+    , m_page_bytes_count{ page_bytes_count }
+    , m_label{ label } {
+    gzn_assertion(
+      block_alignment != 0 && (block_alignment & (block_alignment - 1)) == 0,
+      "Alignment must be a power of 2"
+    );
+  }
+
+  shared_block_pool_allocator(shared_block_pool_allocator const &) = delete;
+  shared_block_pool_allocator(shared_block_pool_allocator &&)      = delete;
+
+  ~shared_block_pool_allocator() { release(); }
+
+  auto operator=(shared_block_pool_allocator const &)
+    -> shared_block_pool_allocator & = delete;
+  auto operator=(shared_block_pool_allocator &&)
+    -> shared_block_pool_allocator & = delete;
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    if (!owns(bytes_count)) [[unlikely]] {
+      std::scoped_lock lock{ m_grow_mutex };
+      return m_parent->allocate(bytes_count, flags);
+    }
+    return allocate_block();
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    if (!owns(bytes_count)) [[unlikely]] {
+      std::scoped_lock lock{ m_grow_mutex };
+      return m_parent->allocate(bytes_count, alignment, offset, flags);
+    }
+    if (!fits(bytes_count, alignment, offset)) [[unlikely]] { return nullptr; }
+    return allocate_block();
+  }
+
+  void deallocate(void *memory, u32 const count) {
+    gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+    if (!owns(count)) [[unlikely]] {
+      std::scoped_lock lock{ m_grow_mutex };
+      m_parent->deallocate(memory, count);
+      return;
+    }
+    auto block{ new (memory) free_block{} };
+    push(block, block);
+  }
+
+  void deallocate(void *memory, u32 const count, u32 const alignment) {
+    gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+    if (!owns(count)) [[unlikely]] {
+      std::scoped_lock lock{ m_grow_mutex };
+      m_parent->deallocate(memory, count, alignment);
+      return;
+    }
+    auto block{ new (memory) free_block{} };
+    push(block, block);
+  }
+
+  /// Not thread-safe: returns all the pages to the parent
+  void release() {
+    auto const header_bytes_count{ details::block_pool_header_bytes_count(
+      m_block_alignment
+    ) };
+    for (auto page{ m_pages }; page != nullptr;) {
+      auto const bytes_count{ header_bytes_count + page->bytes_count };
+      m_parent->deallocate(
+        std::exchange(page, page->next),
+        static_cast<u32>(bytes_count),
+        std::max<u32>(m_block_alignment, alignof(details::block_pool_page))
+      );
+    }
+    m_pages = nullptr;
+    m_head.store(0, std::memory_order_relaxed);
+  }
+
+  /// Whether a block can serve the request
+  [[nodiscard]]
+  constexpr auto fits(
+    u32 const bytes_count,
+    u32 const alignment = 1,
+    u32 const offset    = 0
+  ) const noexcept -> bool {
+    return owns(bytes_count) && alignment <= m_block_alignment &&
+           offset % alignment == 0;
+  }
+
+  /// Whether the pool, not its parent, is responsible for such a size
+  [[nodiscard]]
+  constexpr auto owns(u32 const bytes_count) const noexcept -> bool {
+    return bytes_count <= m_block_bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto block_bytes_count() const noexcept -> u32 {
+    return m_block_bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  alignas(constants::cache_line_bytes) std::atomic<u64> m_head{};
+  alignas(constants::cache_line_bytes) std::mutex m_grow_mutex{};
+  parent_type              *m_parent{ nullptr };
+  details::block_pool_page *m_pages{ nullptr };
+  u32                       m_stride{};
+  u32                       m_block_bytes_count{};
+  u32                       m_block_alignment{};
+  usize                     m_page_bytes_count{};
+  cstr                      m_label;
+
+  [[nodiscard]]
+  static gzn_inline auto pointer_of(u64 const head) noexcept -> free_block * {
+    return reinterpret_cast<free_block *>(head & pointer_mask);
+  }
+
+  [[nodiscard]]
+  static gzn_inline auto pack(free_block *block, u64 const previous) noexcept
+    -> u64 {
+    auto const address{ reinterpret_cast<uintptr_t>(block) };
+    gzn_assertion(
+      (address & ~pointer_mask) == 0, "Pointer doesn't fit into 48 bits"
+    );
+    return ((previous & ~pointer_mask) + tag_step) | address;
+  }
+
+  gzn_inline void push(free_block *first, free_block *last) noexcept {
+    auto head{ m_head.load(std::memory_order_relaxed) };
+    do {
+      last->next.store(pointer_of(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(
+      head, pack(first, head), std::memory_order_release,
+      std::memory_order_relaxed
+    ));
+  }
+
+  /// The blocks are never returned to the parent while the pool is in use,
+  /// so reading `next` of a block popped by another thread is safe: the
+  /// tag makes the following CAS fail.
+  [[nodiscard]]
+  gzn_inline auto pop() noexcept -> free_block * {
+    auto head{ m_head.load(std::memory_order_acquire) };
+    while (auto block{ pointer_of(head) }) {
+      auto next{ block->next.load(std::memory_order_relaxed) };
+      if (m_head.compare_exchange_weak(
+            head, pack(next, head), std::memory_order_acquire,
+            std::memory_order_acquire
+          )) {
+        return block;
+      }
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]]
+  auto allocate_block() -> void * {
+    while (true) {
+      if (auto block{ pop() }; block) [[likely]] { return block; }
+      if (!grow()) [[unlikely]] { return nullptr; }
+    }
+  }
+
+  [[nodiscard]]
+  auto grow() -> bool {
+    std::scoped_lock lock{ m_grow_mutex };
+    if (pointer_of(m_head.load(std::memory_order_acquire)) != nullptr) {
+      return true;
+    }
+
+    auto const header_bytes_count{ details::block_pool_header_bytes_count(
+      m_block_alignment
+    ) };
+    auto const blocks_count{ std::max<usize>(
+      (m_page_bytes_count - std::min(m_page_bytes_count, header_bytes_count)) /
+        m_stride,
+      1
+    ) };
+    auto const payload_bytes_count{ blocks_count * m_stride };
+    auto       memory{ static_cast<byte *>(m_parent->allocate(
+      static_cast<u32>(header_bytes_count + payload_bytes_count),
+      std::max<u32>(m_block_alignment, alignof(details::block_pool_page)),
+      0u,
+      0u
+    )) };
+    if (memory == nullptr) { return false; }
+
+    m_pages = new (memory) details::block_pool_page{
+      .next = m_pages, .bytes_count = payload_bytes_count
+    };
+
+    auto const payload{ memory + header_bytes_count };
+    auto       first{ new (payload) free_block{} };
+    auto       last{ first };
+    for (usize i{ 1 }; i < blocks_count; ++i) {
+      auto block{ new (payload + i * m_stride) free_block{} };
+      last->next.store(block, std::memory_order_relaxed);
+      last = block;
+    }
+    push(first, last);
+    return true;
+  }
+};
+
+} // namespace gzn::fnd
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr buddy_min_block_bytes_count{ 256 };
+usize static constexpr buddy_max_orders_count{ 32 };
+usize static constexpr buddy_invalid_offset{ ~usize{} };
+
+} // namespace constants
+
+struct buddy_stats {
+  usize capacity_bytes_count{};
+  usize allocated_bytes_count{};
+  usize largest_free_block_bytes_count{};
+  usize allocations_count{};
+  usize free_blocks_count{};
+
+  [[nodiscard]]
+  constexpr auto free_bytes_count() const noexcept -> usize {
+    return capacity_bytes_count - allocated_bytes_count;
+  }
+
+  /// 0 when all the free memory is one block, close to 1 when it is split
+  /// into many small ones
+  [[nodiscard]]
+  constexpr auto fragmentation() const noexcept -> f32 {
+    auto const free{ free_bytes_count() };
+    if (free == 0) { return 0.0f; }
+    return 1.0f - static_cast<f32>(largest_free_block_bytes_count) /
+                    static_cast<f32>(free);
+  }
+};
+
+/**
+ * Buddy allocator handing out offsets inside an externally owned range, so
+ * it works for host spans and device-memory heaps alike. All the metadata
+ * lives outside the range: one order byte and one free-list link per
+ * minimal block, taken from the meta allocator. Allocation and deallocation
+ * are O(log n). Ranges which are not a power of two are seeded greedily with
+ * the biggest blocks first, so every block stays aligned to its size
+ * relative to the beginning of the range.
+ */
+template<util::allocator_type MetaAllocator = base_allocator>
+class buddy_offset_allocator {
+  struct link {
+    u32 prev{};
+    u32 next{};
+  };
+
+  u32 static constexpr invalid_index{ ~u32{} };
+  u8 static constexpr free_bit{ 0x80 };
+  u8 static constexpr order_mask{ 0x7f };
+
+public:
+  using meta_allocator_type = MetaAllocator;
+
+  explicit buddy_offset_allocator(
+    meta_allocator_type &meta,
+    usize const          capacity_bytes_count,
+    usize const min_block_bytes_count = constants::buddy_min_block_bytes_count
+  )
+    : m_meta{ &meta }
+    , m_min_block_bytes_count{ min_block_bytes_count }
+    , m_min_block_shift{ static_cast<u32>(
+        std::countr_zero(min_block_bytes_count)
+      ) }
+    , m_blocks_count{ static_cast<u32>(
+        capacity_bytes_count / min_block_bytes_count
+      ) } {
+    gzn_assertion(
+      std::has_single_bit(min_block_bytes_count),
+      "Minimal block size must be a power of 2"
+    );
+    gzn_assertion(
+      capacity_bytes_count / min_block_bytes_count < invalid_index,
+      "Too many blocks, increase the minimal block size"
+    );
+    m_head.fill(invalid_index);
+    if (m_blocks_count == 0) { return; }
+
+    auto memory{ m_meta->allocate(
+      static_cast<u32>(metadata_bytes_count()), alignof(link), 0u, 0u
+    ) };
+    if (memory == nullptr) {
+      gzn_do_assertion("Failed to allocate buddy allocator metadata");
+      m_blocks_count = 0;
+      return;
+    }
+    m_links  = static_cast<link *>(memory);
+    m_orders = reinterpret_cast<u8 *>(m_links + m_blocks_count);
+    std::fill_n(m_orders, m_blocks_count, u8{});
+
+    for (u32 index{}; index < m_blocks_count;) {
+      auto const alignment_order{ std::countr_zero(index | (1u << 31)) };
+      auto const fit_order{ std::bit_width(m_blocks_count - index) - 1 };
+      auto const order{ static_cast<u32>(std::min<usize>(
+        { static_cast<usize>(alignment_order),
+          static_cast<usize>(fit_order),
+          constants::buddy_max_orders_count - 1 }
+      )) };
+      push(index, order);
+      index += 1u << order;
+    }
+  }
+
+  buddy_offset_allocator(buddy_offset_allocator const &) = delete;
+
+  buddy_offset_allocator(buddy_offset_allocator &&other) noexcept
+    : m_meta{ other.m_meta }
+    , m_links{ std::exchange(other.m_links, nullptr) }
+    , m_orders{ std::exchange(other.m_orders, nullptr) }
+    , m_head{ other.m_head }
+    , m_free_counts{ other.m_free_counts }
+    , m_min_block_bytes_count{ other.m_min_block_bytes_count }
+    , m_min_block_shift{ other.m_min_block_shift }
+    , m_blocks_count{ std::exchange(other.m_blocks_count, 0u) }
+    , m_allocated_blocks_count{ std::exchange(
+        other.m_allocated_blocks_count, usize{}
+      ) }
+    , m_allocations_count{
+      std::exchange(other.m_allocations_count, usize{})
+    } {}
+
+  ~buddy_offset_allocator() { release(); }
+
+  auto operator=(buddy_offset_allocator const &)
+    -> buddy_offset_allocator & = delete;
+
+  auto operator=(buddy_offset_allocator &&other) noexcept
+    -> buddy_offset_allocator & {
+    if (this != &other) {
+      release();
+      m_meta                   = other.m_meta;
+      m_links                  = std::exchange(other.m_links, nullptr);
+      m_orders                 = std::exchange(other.m_orders, nullptr);
+      m_head                   = other.m_head;
+      m_free_counts            = other.m_free_counts;
+      m_min_block_bytes_count  = other.m_min_block_bytes_count;
+      m_min_block_shift        = other.m_min_block_shift;
+      m_blocks_count           = std::exchange(other.m_blocks_count, 0u);
+      m_allocated_blocks_count = std::exchange(
+        other.m_allocated_blocks_count, usize{}
+      );
+      m_allocations_count = std::exchange(other.m_allocations_count, usize{});
+    }
+    return *this;
+  }
+
+  /// @returns @ref constants::buddy_invalid_offset when out of memory.
+  /// The offset is aligned to `alignment` relative to the range begin.
+  [[nodiscard]]
+  auto allocate(usize const bytes_count, usize const alignment = 1) -> usize {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    gzn_assertion(std::has_single_bit(alignment), "Alignment must be 2^n");
+
+    auto const blocks{
+      (std::max(bytes_count, alignment) + m_min_block_bytes_count - 1) >>
+      m_min_block_shift
+    };
+    auto const order{ static_cast<u32>(std::bit_width(blocks - 1)) };
+    if (order >= constants::buddy_max_orders_count) {
+      return constants::buddy_invalid_offset;
+    }
+
+    auto found{ order };
+    while (found < constants::buddy_max_orders_count &&
+           m_head[found] == invalid_index) {
+      ++found;
+    }
+    if (found == constants::buddy_max_orders_count) {
+      return constants::buddy_invalid_offset;
+    }
+
+    auto const index{ m_head[found] };
+    remove(index, found);
+    while (found > order) {
+      --found;
+      push(index + (1u << found), found);
+    }
+
+    m_orders[index]          = static_cast<u8>(order);
+    m_allocated_blocks_count += usize{ 1 } << order;
+    ++m_allocations_count;
+    return usize{ index } << m_min_block_shift;
+  }
+
+  void deallocate(usize const offset) {
+    gzn_assertion(
+      offset < (usize{ m_blocks_count } << m_min_block_shift),
+      "Offset is out of range"
+    );
+    auto index{ static_cast<u32>(offset >> m_min_block_shift) };
+    gzn_assertion(
+      (m_orders[index] & free_bit) == 0, "Double free of a buddy block"
+    );
+
+    auto order{ static_cast<u32>(m_orders[index] & order_mask) };
+    m_allocated_blocks_count -= usize{ 1 } << order;
+    --m_allocations_count;
+
+    while (order + 1 < constants::buddy_max_orders_count) {
+      auto const buddy{ index ^ (1u << order) };
+      if (buddy >= m_blocks_count ||
+          m_orders[buddy] != (free_bit | static_cast<u8>(order))) {
+        break;
+      }
+      remove(buddy, order);
+      m_orders[std::max(index, buddy)] = 0;
+      index                            = std::min(index, buddy);
+      ++order;
+    }
+    push(index, order);
+  }
+
+  /// Size of the block backing the allocation at `offset`
+  [[nodiscard]]
+  auto block_bytes_count(usize const offset) const noexcept -> usize {
+    auto const index{ offset >> m_min_block_shift };
+    return m_min_block_bytes_count << (m_orders[index] & order_mask);
+  }
+
+  [[nodiscard]]
+  auto stats() const noexcept -> buddy_stats {
+    buddy_stats result{
+      .capacity_bytes_count  = capacity_bytes_count(),
+      .allocated_bytes_count = m_allocated_blocks_count << m_min_block_shift,
+      .allocations_count     = m_allocations_count,
+    };
+    for (usize order{}; order < constants::buddy_max_orders_count; ++order) {
+      result.free_blocks_count += m_free_counts[order];
+      if (m_free_counts[order] != 0) {
+        result.largest_free_block_bytes_count = m_min_block_bytes_count
+                                             << order;
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity_bytes_count() const noexcept -> usize {
+    return usize{ m_blocks_count } << m_min_block_shift;
+  }
+
+  [[nodiscard]]
+  constexpr auto min_block_bytes_count() const noexcept -> usize {
+    return m_min_block_bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto metadata_bytes_count() const noexcept -> usize {
+    return usize{ m_blocks_count } * (sizeof(link) + sizeof(u8));
+  }
+
+private:
+  using free_heads  = std::array<u32, constants::buddy_max_orders_count>;
+  using free_counts = std::array<usize, constants::buddy_max_orders_count>;
+
+  meta_allocator_type *m_meta{ nullptr };
+  link                *m_links{ nullptr };
+  u8                  *m_orders{ nullptr };
+  free_heads           m_head{};
+  free_counts          m_free_counts{};
+  usize                m_min_block_bytes_count{};
+  u32                  m_min_block_shift{};
+  u32                  m_blocks_count{};
+  usize                m_allocated_blocks_count{};
+  usize                m_allocations_count{};
+
+  void push(u32 const index, u32 const order) noexcept {
+    m_orders[index] = free_bit | static_cast<u8>(order);
+    m_links[index]  = link{ .prev = invalid_index, .next = m_head[order] };
+    if (m_head[order] != invalid_index) {
+      m_links[m_head[order]].prev = index;
+    }
+    m_head[order] = index;
+    ++m_free_counts[order];
+  }
+
+  void remove(u32 const index, u32 const order) noexcept {
+    auto const [prev, next]{ m_links[index] };
+    if (prev != invalid_index) {
+      m_links[prev].next = next;
+    } else {
+      m_head[order] = next;
+    }
+    if (next != invalid_index) { m_links[next].prev = prev; }
+    m_orders[index] = 0;
+    --m_free_counts[order];
+  }
+
+  void release() {
+    if (m_links != nullptr) {
+      m_meta->deallocate(
+        m_links, static_cast<u32>(metadata_bytes_count()), alignof(link)
+      );
+    }
+    m_links        = nullptr;
+    m_orders       = nullptr;
+    m_blocks_count = 0;
+  }
+};
+
+/**
+ * @ref buddy_offset_allocator over a host memory span, exposed as an
+ * allocator. Alignment stricter than the minimal block is honoured as long
+ * as the span itself is aligned to it. An offset breaking the alignment is
+ * served by padding the block, requests whose padding may not fit into the
+ * minimal block get nullptr.
+ */
+template<util::allocator_type MetaAllocator = base_allocator>
+class buddy_allocator {
+public:
+  using meta_allocator_type = MetaAllocator;
+  using offset_allocator    = buddy_offset_allocator<MetaAllocator>;
+
+  explicit buddy_allocator(
+    meta_allocator_type &meta,
+    std::span<byte>      memory,
+    usize const min_block_bytes_count = constants::buddy_min_block_bytes_count,
+    cstr const  label                 = "buddy_allocator"
+  )
+    : m_offsets{ meta, std::size(memory), min_block_bytes_count }
+    , m_data{ std::data(memory) }
+    , m_label{ label } {}
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    return allocate(bytes_count, alignof(std::max_align_t), 0, flags);
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const                  bytes_count,
+    u32 const                  alignment,
+    u32 const                  offset,
+    [[maybe_unused]] u32 const flags = 0
+  ) -> void * {
+    auto const base{ reinterpret_cast<uintptr_t>(m_data) };
+    auto const is_aligned{ (base + offset) % alignment == 0 };
+    auto const padding_limit{ is_aligned ? usize{} : usize{ alignment } - 1 };
+    // A deallocated pointer is mapped back to its block by the minimal block
+    if (padding_limit >= m_offsets.min_block_bytes_count()) [[unlikely]] {
+      return nullptr;
+    }
+
+    auto const block{ m_offsets.allocate(
+      bytes_count + padding_limit,
+      is_aligned ? alignment : usize{ 1 }
+    ) };
+    if (block == constants::buddy_invalid_offset) { return nullptr; }
+
+    auto const misalignment{ (base + block + offset) & (alignment - 1) };
+    auto const padding{ (alignment - misalignment) & (alignment - 1) };
+    return m_data + block + padding;
+  }
+
+  void deallocate(void *memory, u32) { deallocate_block(memory); }
+
+  void deallocate(void *memory, u32, u32) { deallocate_block(memory); }
+
+  [[nodiscard]]
+  auto stats() const noexcept -> buddy_stats {
+    return m_offsets.stats();
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  offset_allocator m_offsets;
+  byte            *m_data{ nullptr };
+  cstr             m_label;
+
+  void deallocate_block(void *memory) {
+    gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+    auto const offset{ static_cast<usize>(static_cast<byte *>(memory) - m_data)
+    };
+    auto const mask{ m_offsets.min_block_bytes_count() - 1 };
+    m_offsets.deallocate(offset & ~mask);
+  }
+};
+
+} // namespace gzn::fnd
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr allocator_context_max_depth{ 32 };
+
+} // namespace constants
+
+/**
+ * Type-erased, non-owning reference to an allocator. An empty reference
+ * stands for @ref base_allocator and calls it directly, without the
+ * indirection, so the common case costs nothing extra.
+ */
+class any_allocator {
+  struct vtable {
+    auto (*allocate)(void *, u32, u32, u32, u32) -> void *;
+    void (*deallocate)(void *, void *, u32, u32);
+    auto (*get_label)(void const *) -> std::string_view;
+  };
+
+  template<class Allocator>
+  static constexpr vtable vtable_for{
+    .allocate = [](
+                  void     *allocator,
+                  u32 const bytes_count,
+                  u32 const alignment,
+                  u32 const offset,
+                  u32 const flags
+                ) -> void * {
+      return static_cast<Allocator *>(allocator)->allocate(
+        bytes_count, alignment, offset, flags
+      );
+    },
+    .deallocate =
+      [](void *allocator, void *memory, u32 const count, u32 const alignment) {
+        static_cast<Allocator *>(allocator)->deallocate(
+          memory, count, alignment
+        );
+      },
+    .get_label = [](void const *allocator) -> std::string_view {
+      return static_cast<Allocator const *>(allocator)->get_label();
+    },
+  };
+
+public:
+  /// Containers store this type by value instead of by pointer
+  bool static constexpr is_allocator_reference{ true };
+
+  constexpr any_allocator() noexcept = default;
+
+  template<util::allocator_type Allocator>
+    requires(!std::same_as<std::remove_cv_t<Allocator>, any_allocator>)
+  constexpr any_allocator(Allocator &allocator) noexcept
+    : m_allocator{ &allocator }
+    , m_vtable{ &vtable_for<Allocator> } {}
+
+  constexpr any_allocator(base_allocator &) noexcept {}
+
+  [[nodiscard]]
+  gzn_inline auto allocate(u32 const bytes_count, u32 const flags = 0)
+    -> void * {
+    return allocate(bytes_count, alignof(std::max_align_t), 0, flags);
+  }
+
+  [[nodiscard]]
+  gzn_inline auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    if (m_vtable == nullptr) [[likely]] {
+      return base_allocator{}.allocate(bytes_count, alignment, offset, flags);
+    }
+    return m_vtable->allocate(
+      m_allocator, bytes_count, alignment, offset, flags
+    );
+  }
+
+  gzn_inline void deallocate(void *memory, u32 const count) {
+    deallocate(memory, count, alignof(std::max_align_t));
+  }
+
+  gzn_inline void deallocate(
+    void     *memory,
+    u32 const count,
+    u32 const alignment
+  ) {
+    if (m_vtable == nullptr) [[likely]] {
+      base_allocator{}.deallocate(memory, count, alignment);
+      return;
+    }
+    m_vtable->deallocate(m_allocator, memory, count, alignment);
+  }
+
+  [[nodiscard]]
+  auto get_label() const noexcept -> std::string_view {
+    if (m_vtable == nullptr) { return "base_allocator"; }
+    return m_vtable->get_label(m_allocator);
+  }
+
+  [[nodiscard]]
+  constexpr auto is_default() const noexcept -> bool {
+    return m_vtable == nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto operator==(any_allocator const &) const noexcept
+    -> bool = default;
+
+private:
+  void         *m_allocator{ nullptr };
+  vtable const *m_vtable{ nullptr };
+};
+
+namespace util {
+
+/// Allocator handles which are cheap to copy and are stored by value
+template<class T>
+concept allocator_reference_type =
+  allocator_type<T> && std::remove_cvref_t<T>::is_allocator_reference;
+
+} // namespace util
+
+/**
+ * Per-thread stack of default allocators. Containers constructed without an
+ * explicit allocator take @ref current, so a whole call tree can be moved
+ * onto e.g. a frame arena without changing any signature.
+ *
+ * The funcs and `heap_owner` don't consult it: they keep a pointer to the
+ * allocator they are given, and the value returned by @ref current is a
+ * temporary. Pass them an `any_allocator` which outlives them instead.
+ */
+class allocator_context {
+public:
+  allocator_context() = delete;
+
+  /// The top of the stack, or @ref base_allocator when the stack is empty
+  [[nodiscard]]
+  static auto current() noexcept -> any_allocator;
+
+  /// Past @ref constants::allocator_context_max_depth the push is ignored,
+  /// the current allocator stays, and the matching pop undoes nothing
+  static void push(any_allocator allocator) noexcept;
+
+  /// Does nothing on an empty stack
+  static void pop() noexcept;
+
+  [[nodiscard]]
+  static auto depth() noexcept -> usize;
+};
+
+/// Makes `allocator` the current one until the end of the scope
+class scoped_allocator {
+public:
+  explicit scoped_allocator(any_allocator const allocator) noexcept {
+    allocator_context::push(allocator);
+  }
+
+  ~scoped_allocator() { allocator_context::pop(); }
+
+  scoped_allocator(scoped_allocator const &)                     = delete;
+  scoped_allocator(scoped_allocator &&)                          = delete;
+  auto operator=(scoped_allocator const &) -> scoped_allocator & = delete;
+  auto operator=(scoped_allocator &&) -> scoped_allocator &      = delete;
+};
+
+} // namespace gzn::fnd
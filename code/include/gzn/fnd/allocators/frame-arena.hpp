@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr frame_arena_chunk_bytes_count{ 256 * 1024 };
+
+} // namespace constants
+
+/**
+ * Growable linear allocator. Memory is taken from the parent allocator in
+ * big chunks which are chained together and bump-allocated. Individual
+ * deallocations are no-ops; memory is reclaimed with @ref rewind to a
+ * previously taken @ref mark or with @ref reset. Both keep the chunks, so a
+ * warmed-up arena never calls the parent allocator again. Alignment follows
+ * the @ref base_allocator convention: `ptr + offset` is aligned.
+ */
+template<util::allocator_type Parent = base_allocator>
+class frame_arena_allocator {
+  struct chunk_header {
+    chunk_header *next{ nullptr };
+    usize         capacity{};
+  };
+
+  usize static constexpr header_bytes_count{
+    util::memory_align(sizeof(chunk_header), constants::cache_line_bytes)
+  };
+
+public:
+  using parent_type = Parent;
+
+  struct marker {
+    chunk_header *chunk{ nullptr };
+    usize         top{};
+  };
+
+  explicit frame_arena_allocator(
+    parent_type &parent,
+    usize const  chunk_bytes_count = constants::frame_arena_chunk_bytes_count,
+    cstr const   label             = "frame_arena_allocator"
+  ) noexcept
+    : m_parent{ &parent }
+    , m_chunk_bytes_count{ chunk_bytes_count }
+    , m_label{ label } {}
+
+  frame_arena_allocator(frame_arena_allocator const &) = delete;
+
+  frame_arena_allocator(frame_arena_allocator &&other) noexcept
+    : m_parent{ other.m_parent }
+    , m_head{ std::exchange(other.m_head, nullptr) }
+    , m_current{ std::exchange(other.m_current, nullptr) }
+    , m_top{ std::exchange(other.m_top, usize{}) }
+    , m_chunk_bytes_count{ other.m_chunk_bytes_count }
+    , m_label{ other.m_label } {}
+
+  ~frame_arena_allocator() { release(); }
+
+  auto operator=(frame_arena_allocator const &)
+    -> frame_arena_allocator & = delete;
+
+  auto operator=(frame_arena_allocator &&other) noexcept
+    -> frame_arena_allocator & {
+    if (this != &other) {
+      release();
+      m_parent            = other.m_parent;
+      m_head              = std::exchange(other.m_head, nullptr);
+      m_current           = std::exchange(other.m_current, nullptr);
+      m_top               = std::exchange(other.m_top, usize{});
+      m_chunk_bytes_count = other.m_chunk_bytes_count;
+      m_label             = other.m_label;
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    return allocate(bytes_count, alignof(std::max_align_t), 0, flags);
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const                  bytes_count,
+    u32 const                  alignment,
+    u32 const                  offset,
+    [[maybe_unused]] u32 const flags = 0
+  ) -> void * {
+    gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+    gzn_assertion(
+      alignment != 0 && (alignment & (alignment - 1)) == 0,
+      "Alignment must be a power of 2"
+    );
+
+    if (m_current == nullptr) {
+      m_current = m_head;
+      m_top     = 0;
+    }
+
+    for (auto chunk{ m_current }; chunk != nullptr; chunk = chunk->next) {
+      auto const top{ chunk == m_current ? m_top : usize{} };
+      if (auto memory{ bump(chunk, top, bytes_count, alignment, offset) };
+          memory) {
+        return memory;
+      }
+    }
+
+    auto const required{ usize{ bytes_count } + offset + alignment };
+    auto       chunk{ make_chunk(std::max(required, m_chunk_bytes_count)) };
+    if (chunk == nullptr) { return nullptr; }
+    return bump(chunk, 0, bytes_count, alignment, offset);
+  }
+
+  constexpr void deallocate(void *, u32) {}
+
+  constexpr void deallocate(void *, u32, u32) {}
+
+  /// Only the last allocation can change its size, within its chunk
+  [[nodiscard]]
+  auto try_expand(
+    void     *memory,
+    u32 const bytes_count,
+    u32 const new_bytes_count
+  ) noexcept -> bool {
+    if (m_current == nullptr) { return false; }
+
+    auto const begin{ static_cast<byte *>(memory) - data_of(m_current) };
+    if (begin < 0 || static_cast<usize>(begin) + bytes_count != m_top) {
+      return false;
+    }
+    if (static_cast<usize>(begin) + new_bytes_count > m_current->capacity) {
+      return false;
+    }
+
+    m_top = static_cast<usize>(begin) + new_bytes_count;
+    return true;
+  }
+
+  [[nodiscard]]
+  constexpr auto mark() const noexcept -> marker {
+    return marker{ .chunk = m_current, .top = m_top };
+  }
+
+  constexpr void rewind(marker const mark) noexcept {
+    m_current = mark.chunk;
+    m_top     = mark.top;
+  }
+
+  /// O(1): the chunks are kept and reused by the following allocations
+  constexpr void reset() noexcept { rewind(marker{}); }
+
+  /// Returns all the chunks to the parent allocator
+  void release() {
+    for (auto chunk{ m_head }; chunk != nullptr;) {
+      auto const bytes_count{ header_bytes_count + chunk->capacity };
+      m_parent->deallocate(
+        std::exchange(chunk, chunk->next),
+        static_cast<u32>(bytes_count),
+        constants::cache_line_bytes
+      );
+    }
+    m_head    = nullptr;
+    m_current = nullptr;
+    m_top     = 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto reserved_bytes_count() const noexcept -> usize {
+    usize bytes_count{};
+    for (auto chunk{ m_head }; chunk != nullptr; chunk = chunk->next) {
+      bytes_count += chunk->capacity;
+    }
+    return bytes_count;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  parent_type  *m_parent{ nullptr };
+  chunk_header *m_head{ nullptr };
+  chunk_header *m_current{ nullptr };
+  usize         m_top{};
+  usize         m_chunk_bytes_count{};
+  cstr          m_label;
+
+  [[nodiscard]]
+  static gzn_inline auto data_of(chunk_header *chunk) noexcept -> byte * {
+    return reinterpret_cast<byte *>(chunk) + header_bytes_count;
+  }
+
+  [[nodiscard]]
+  auto bump(
+    chunk_header *chunk,
+    usize const   top,
+    u32 const     bytes_count,
+    u32 const     alignment,
+    u32 const     offset
+  ) noexcept -> void * {
+    auto const address{ reinterpret_cast<uintptr_t>(data_of(chunk)) + top };
+    auto const misalignment{ (address + offset) & (alignment - 1) };
+    auto const padding{ (alignment - misalignment) & (alignment - 1) };
+    auto const new_top{ top + padding + bytes_count };
+    if (new_top > chunk->capacity) { return nullptr; }
+
+    m_current = chunk;
+    m_top     = new_top;
+    return data_of(chunk) + top + padding;
+  }
+
+  /// Appends a new chunk to the end of the chain, so the chunks between the
+  /// current one and the tail are still reused after a rewind.
+  [[nodiscard]]
+  auto make_chunk(usize const capacity) -> chunk_header * {
+    auto const bytes_count{ header_bytes_count + capacity };
+    auto       memory{ m_parent->allocate(
+      static_cast<u32>(bytes_count), constants::cache_line_bytes, 0u, 0u
+    ) };
+    if (memory == nullptr) { return nullptr; }
+
+    auto chunk{ new (memory) chunk_header{ .capacity = capacity } };
+    if (m_head == nullptr) {
+      m_head = chunk;
+    } else {
+      auto tail{ m_current ? m_current : m_head };
+      while (tail->next != nullptr) { tail = tail->next; }
+      tail->next = chunk;
+    }
+    return chunk;
+  }
+};
+
+/**
+ * N-buffered frame allocator. Every frame allocates from its own
+ * @ref frame_arena_allocator; @ref next_frame switches to the arena used
+ * N frames ago and resets it in O(1), so the data of the previous N - 1
+ * frames stays valid (e.g. while the GPU is still reading it).
+ */
+template<usize FramesCount = 2, util::allocator_type Parent = base_allocator>
+class frame_allocator {
+  gzn_static_assert(FramesCount != 0, "At least one frame is required");
+
+public:
+  using parent_type = Parent;
+  using arena_type  = frame_arena_allocator<Parent>;
+
+  explicit frame_allocator(
+    parent_type &parent,
+    usize const  chunk_bytes_count = constants::frame_arena_chunk_bytes_count,
+    cstr const   label             = "frame_allocator"
+  ) noexcept
+    : m_frames{ make_frames(
+        parent,
+        chunk_bytes_count,
+        label,
+        std::make_index_sequence<FramesCount>{}
+      ) }
+    , m_label{ label } {}
+
+  frame_allocator(frame_allocator const &)                     = delete;
+  frame_allocator(frame_allocator &&) noexcept                 = default;
+  auto operator=(frame_allocator const &) -> frame_allocator & = delete;
+  auto operator=(frame_allocator &&) noexcept -> frame_allocator & = default;
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    return current().allocate(bytes_count, flags);
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    return current().allocate(bytes_count, alignment, offset, flags);
+  }
+
+  constexpr void deallocate(void *, u32) {}
+
+  constexpr void deallocate(void *, u32, u32) {}
+
+  void next_frame() noexcept {
+    m_frame_index = (m_frame_index + 1) % FramesCount;
+    current().reset();
+  }
+
+  [[nodiscard]]
+  constexpr auto current() noexcept -> arena_type & {
+    return m_frames[m_frame_index];
+  }
+
+  [[nodiscard]]
+  constexpr auto current() const noexcept -> arena_type const & {
+    return m_frames[m_frame_index];
+  }
+
+  [[nodiscard]]
+  constexpr auto frame_index() const noexcept -> usize {
+    return m_frame_index;
+  }
+
+  [[nodiscard]]
+  static constexpr auto frames_count() noexcept -> usize {
+    return FramesCount;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  std::array<arena_type, FramesCount> m_frames;
+  usize                               m_frame_index{};
+  cstr                                m_label;
+
+  template<usize... Indices>
+  [[nodiscard]]
+  static auto make_frames(
+    parent_type &parent,
+    usize const  chunk_bytes_count,
+    cstr const   label,
+    std::index_sequence<Indices...>
+  ) noexcept -> std::array<arena_type, FramesCount> {
+    return { ((void)Indices, arena_type{ parent, chunk_bytes_count, label })...
+    };
+  }
+};
+
+} // namespace gzn::fnd
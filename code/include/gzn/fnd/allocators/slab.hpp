@@ -0,0 +1,74 @@
+#pragma once
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr slab_bytes_count{ 64 * 1024 };
+u32 static constexpr slab_max_block_bytes_count{ 1024 };
+u32 static constexpr slab_block_alignment{ 16 };
+
+} // namespace constants
+
+/**
+ * Size-class allocator for small, short-living objects.
+ *
+ * Every thread owns a heap with one free list per size class. Blocks are
+ * carved from 64 KiB slabs and always return to the heap they were taken
+ * from: frees made by the owner thread go straight to the local free list,
+ * frees made by other threads are pushed onto a lock-free remote list which
+ * the owner drains once its local list runs dry. Heaps of exited threads are
+ * kept alive and handed over to the next thread, so remote frees never
+ * dangle.
+ *
+ * Blocks larger than @ref constants::slab_max_block_bytes_count, aligned
+ * stricter than @ref constants::slab_block_alignment or requested with an
+ * offset which breaks the alignment are forwarded to @ref base_allocator.
+ * The latter are told apart on deallocation by their address: unlike slab
+ * blocks, they are never aligned to `slab_block_alignment`.
+ */
+class slab_allocator {
+public:
+  constexpr explicit slab_allocator(cstr label = "slab_allocator") noexcept
+    : label{ label } {}
+
+  slab_allocator(slab_allocator const &other)                     = default;
+  slab_allocator(slab_allocator &&other) noexcept                 = default;
+
+  auto operator=(slab_allocator const &other) -> slab_allocator & = default;
+  auto operator=(slab_allocator &&other) noexcept
+    -> slab_allocator & = default;
+
+  [[nodiscard]]
+  auto allocate(u32 bytes_count, u32 flags = 0) -> void *;
+
+  [[nodiscard]]
+  auto allocate(u32 bytes_count, u32 alignment, u32 offset, u32 flags = 0)
+    -> void *;
+
+  void deallocate(void *memory, u32 count);
+
+  void deallocate(void *memory, u32 count, u32 alignment);
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return label;
+  }
+
+  [[nodiscard]]
+  static constexpr auto is_slab_sized(
+    u32 const bytes_count,
+    u32 const alignment = constants::slab_block_alignment
+  ) noexcept -> bool {
+    return bytes_count != 0 &&
+           bytes_count <= constants::slab_max_block_bytes_count &&
+           alignment <= constants::slab_block_alignment;
+  }
+
+private:
+  cstr label;
+};
+
+} // namespace gzn::fnd
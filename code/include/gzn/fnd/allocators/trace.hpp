@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdio>
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+enum class allocation_event_kind : u8 {
+  allocate,
+  deallocate,
+};
+
+/// `id` is the address of the block: it pairs a deallocation with its
+/// allocation when a trace is replayed.
+struct allocation_event {
+  allocation_event_kind kind{};
+  u32                   thread_index{};
+  u32                   bytes_count{};
+  u32                   alignment{};
+  u64                   id{};
+  u64                   timestamp_ns{};
+};
+
+using allocation_trace_sink = void (*)(
+  allocation_event const &event,
+  void                   *user_data
+);
+
+/**
+ * Process-wide hook receiving the events of every @ref tracing_allocator.
+ * Install the sink before the traced threads start; with no sink installed
+ * tracing costs one relaxed load per call.
+ */
+class allocation_trace {
+public:
+  allocation_trace() = delete;
+
+  static void set_sink(allocation_trace_sink sink, void *user_data = nullptr);
+
+  [[nodiscard]]
+  static auto is_enabled() noexcept -> bool;
+
+  static void emit(
+    allocation_event_kind kind,
+    void const           *memory,
+    u32                   bytes_count,
+    u32                   alignment
+  );
+
+  /// Text sink: one `a|d <id> <bytes> <alignment> <thread> <ns>` line per
+  /// event, `user_data` must be a `std::FILE *`.
+  static void write_to_file(allocation_event const &event, void *user_data);
+
+  /// Parses a line written by @ref write_to_file
+  [[nodiscard]]
+  static auto read_from_file(std::FILE *file, allocation_event &event)
+    -> bool;
+};
+
+/// Decorator reporting every allocation of the wrapped allocator to the
+/// installed @ref allocation_trace sink.
+template<util::allocator_type Allocator>
+class tracing_allocator {
+public:
+  using allocator_type = Allocator;
+
+  template<class... Args>
+    requires std::constructible_from<allocator_type, Args &&...>
+  explicit tracing_allocator(Args &&...args)
+    : m_allocator{ std::forward<Args>(args)... } {}
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    auto memory{ m_allocator.allocate(bytes_count, flags) };
+    if (memory != nullptr && allocation_trace::is_enabled()) [[unlikely]] {
+      allocation_trace::emit(
+        allocation_event_kind::allocate,
+        memory,
+        bytes_count,
+        alignof(std::max_align_t)
+      );
+    }
+    return memory;
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    auto memory{ m_allocator.allocate(bytes_count, alignment, offset, flags) };
+    if (memory != nullptr && allocation_trace::is_enabled()) [[unlikely]] {
+      allocation_trace::emit(
+        allocation_event_kind::allocate, memory, bytes_count, alignment
+      );
+    }
+    return memory;
+  }
+
+  void deallocate(void *memory, u32 const count) {
+    if (allocation_trace::is_enabled()) [[unlikely]] {
+      allocation_trace::emit(
+        allocation_event_kind::deallocate,
+        memory,
+        count,
+        alignof(std::max_align_t)
+      );
+    }
+    m_allocator.deallocate(memory, count);
+  }
+
+  void deallocate(void *memory, u32 const count, u32 const alignment) {
+    if (allocation_trace::is_enabled()) [[unlikely]] {
+      allocation_trace::emit(
+        allocation_event_kind::deallocate, memory, count, alignment
+      );
+    }
+    m_allocator.deallocate(memory, count, alignment);
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_allocator.get_label();
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    return m_allocator;
+  }
+
+private:
+  allocator_type m_allocator;
+};
+
+} // namespace gzn::fnd
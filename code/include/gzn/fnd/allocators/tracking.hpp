@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <string_view>
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr allocation_histogram_buckets_count{ 16 };
+usize static constexpr allocation_histogram_min_bytes_count{ 16 };
+usize static constexpr allocation_registry_capacity{ 64 };
+usize static constexpr allocation_label_max_length{ 63 };
+
+} // namespace constants
+
+/**
+ * Per-label allocation counters. All updates are relaxed atomics, cheap
+ * enough to stay enabled in release builds. Histogram bucket `i` counts
+ * allocations of up to `16 << i` bytes, the last bucket counts the rest.
+ */
+struct allocation_stats {
+  using histogram_type = std::array<
+    std::atomic<u64>,
+    constants::allocation_histogram_buckets_count>;
+
+  std::array<char, constants::allocation_label_max_length + 1> label{};
+
+  std::atomic<u64> live_bytes_count{};
+  std::atomic<u64> peak_bytes_count{};
+  std::atomic<u64> total_bytes_count{};
+  std::atomic<u64> allocations_count{};
+  std::atomic<u64> deallocations_count{};
+  histogram_type   histogram{};
+
+  gzn_inline void on_allocate(usize const bytes_count) noexcept {
+    auto const live{
+      live_bytes_count.fetch_add(bytes_count, std::memory_order_relaxed) +
+      bytes_count
+    };
+    auto peak{ peak_bytes_count.load(std::memory_order_relaxed) };
+    while (live > peak && !peak_bytes_count.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed
+                          )) {}
+
+    total_bytes_count.fetch_add(bytes_count, std::memory_order_relaxed);
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    histogram[bucket_of(bytes_count)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  gzn_inline void on_deallocate(usize const bytes_count) noexcept {
+    live_bytes_count.fetch_sub(bytes_count, std::memory_order_relaxed);
+    deallocations_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]]
+  auto get_label() const noexcept -> std::string_view {
+    return std::data(label);
+  }
+
+  [[nodiscard]]
+  auto has_leaks() const noexcept -> bool {
+    return live_bytes_count.load(std::memory_order_relaxed) != 0 ||
+           allocations_count.load(std::memory_order_relaxed) !=
+             deallocations_count.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]]
+  static constexpr auto bucket_of(usize const bytes_count) noexcept -> usize {
+    auto constexpr min_width{ std::bit_width(
+      constants::allocation_histogram_min_bytes_count - 1
+    ) };
+    auto const width{ static_cast<usize>(std::bit_width(bytes_count - 1)) };
+    auto const bucket{ width > min_width ? width - min_width : usize{} };
+    return std::min(bucket, constants::allocation_histogram_buckets_count - 1);
+  }
+};
+
+/**
+ * Global table of @ref allocation_stats keyed by allocator label. Lookups
+ * are lock-free, registration of a new label takes a lock once.
+ */
+class allocation_registry {
+public:
+  allocation_registry() = delete;
+
+  /// @returns nullptr when the registry is full
+  [[nodiscard]]
+  static auto find_or_register(std::string_view label) -> allocation_stats *;
+
+  /// Labels are cut to @ref constants::allocation_label_max_length first
+  [[nodiscard]]
+  static auto find(std::string_view label) noexcept -> allocation_stats *;
+
+  static void report(std::FILE *out = stdout);
+
+  /// @returns the number of labels which still own memory
+  static auto report_leaks(std::FILE *out = stderr) -> usize;
+
+  /// Runs @ref report_leaks from `std::atexit`
+  static void enable_leak_report_at_exit();
+};
+
+/**
+ * Decorator recording every allocation of the wrapped allocator into the
+ * @ref allocation_stats of its label. The counters follow the calls, not
+ * the memory: an arena with no-op deallocations drops its live bytes on
+ * every deallocate while it keeps the memory until reset, its high
+ * watermark is `peak_bytes_count`.
+ */
+template<util::allocator_type Allocator>
+class tracking_allocator {
+public:
+  using allocator_type = Allocator;
+
+  template<class... Args>
+    requires std::constructible_from<allocator_type, Args &&...>
+  explicit tracking_allocator(Args &&...args)
+    : m_allocator{ std::forward<Args>(args)... }
+    , m_stats{ allocation_registry::find_or_register(
+        m_allocator.get_label()
+      ) } {}
+
+  tracking_allocator(tracking_allocator const &)                     = delete;
+  tracking_allocator(tracking_allocator &&) noexcept                 = default;
+  auto operator=(tracking_allocator const &) -> tracking_allocator & = delete;
+  auto operator=(tracking_allocator &&) noexcept
+    -> tracking_allocator & = default;
+
+  [[nodiscard]]
+  auto allocate(u32 const bytes_count, u32 const flags = 0) -> void * {
+    auto memory{ m_allocator.allocate(bytes_count, flags) };
+    if (memory != nullptr && m_stats != nullptr) {
+      m_stats->on_allocate(bytes_count);
+    }
+    return memory;
+  }
+
+  [[nodiscard]]
+  auto allocate(
+    u32 const bytes_count,
+    u32 const alignment,
+    u32 const offset,
+    u32 const flags = 0
+  ) -> void * {
+    auto memory{ m_allocator.allocate(bytes_count, alignment, offset, flags) };
+    if (memory != nullptr && m_stats != nullptr) {
+      m_stats->on_allocate(bytes_count);
+    }
+    return memory;
+  }
+
+  void deallocate(void *memory, u32 const count) {
+    if (m_stats != nullptr) { m_stats->on_deallocate(count); }
+    m_allocator.deallocate(memory, count);
+  }
+
+  void deallocate(void *memory, u32 const count, u32 const alignment) {
+    if (m_stats != nullptr) { m_stats->on_deallocate(count); }
+    m_allocator.deallocate(memory, count, alignment);
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_allocator.get_label();
+  }
+
+  [[nodiscard]]
+  constexpr auto get_stats() const noexcept -> allocation_stats const * {
+    return m_stats;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    return m_allocator;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    return m_allocator;
+  }
+
+private:
+  allocator_type    m_allocator;
+  allocation_stats *m_stats{ nullptr };
+};
+
+} // namespace gzn::fnd
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <utility>
+
+#include "gzn/fnd/allocators.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+usize static constexpr virtual_arena_reserve_bytes_count{ usize{ 64 } << 30 };
+usize static constexpr virtual_arena_commit_bytes_count{ 64 * 1024 };
+
+} // namespace constants
+
+/**
+ * Linear allocator over a reserved range of virtual address space. The
+ * range is reserved once without backing memory and pages are committed in
+ * @ref constants::virtual_arena_commit_bytes_count steps as the top grows,
+ * so pointers stay stable for the whole life of the arena. @ref reset gives
+ * the physical memory back to the OS while keeping the reservation.
+ * Alignment follows the @ref base_allocator convention: `ptr + offset` is
+ * aligned.
+ */
+class virtual_arena_allocator {
+public:
+  struct marker {
+    usize top{};
+  };
+
+  explicit virtual_arena_allocator(
+    usize reserve_bytes_count = constants::virtual_arena_reserve_bytes_count,
+    cstr  label               = "virtual_arena_allocator"
+  ) noexcept;
+
+  virtual_arena_allocator(virtual_arena_allocator const &) = delete;
+
+  virtual_arena_allocator(virtual_arena_allocator &&other) noexcept
+    : m_data{ std::exchange(other.m_data, nullptr) }
+    , m_top{ std::exchange(other.m_top, usize{}) }
+    , m_committed{ std::exchange(other.m_committed, usize{}) }
+    , m_reserved{ std::exchange(other.m_reserved, usize{}) }
+    , m_label{ other.m_label } {}
+
+  ~virtual_arena_allocator();
+
+  auto operator=(virtual_arena_allocator const &)
+    -> virtual_arena_allocator & = delete;
+
+  auto operator=(virtual_arena_allocator &&other) noexcept
+    -> virtual_arena_allocator &;
+
+  [[nodiscard]]
+  auto allocate(u32 bytes_count, u32 flags = 0) -> void *;
+
+  [[nodiscard]]
+  auto allocate(u32 bytes_count, u32 alignment, u32 offset, u32 flags = 0)
+    -> void *;
+
+  constexpr void deallocate(void *, u32) {}
+
+  constexpr void deallocate(void *, u32, u32) {}
+
+  /// Only the last allocation can change its size, committing pages on demand
+  [[nodiscard]]
+  auto try_expand(void *memory, u32 bytes_count, u32 new_bytes_count) -> bool;
+
+  [[nodiscard]]
+  constexpr auto mark() const noexcept -> marker {
+    return marker{ .top = m_top };
+  }
+
+  /// Keeps the committed pages for the following allocations
+  constexpr void rewind(marker const mark) noexcept {
+    gzn_assertion(mark.top <= m_top, "Rewind past the top of the arena");
+    m_top = mark.top;
+  }
+
+  /// Rewinds to the beginning and decommits every page
+  void reset();
+
+  [[nodiscard]]
+  constexpr auto allocated_bytes_count() const noexcept -> usize {
+    return m_top;
+  }
+
+  [[nodiscard]]
+  constexpr auto committed_bytes_count() const noexcept -> usize {
+    return m_committed;
+  }
+
+  [[nodiscard]]
+  constexpr auto reserved_bytes_count() const noexcept -> usize {
+    return m_reserved;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_label() const noexcept -> std::string_view {
+    return m_label;
+  }
+
+private:
+  byte *m_data{ nullptr };
+  usize m_top{};
+  usize m_committed{};
+  usize m_reserved{};
+  cstr  m_label;
+
+  [[nodiscard]]
+  auto commit(usize top) -> bool;
+
+  void release();
+};
+
+} // namespace gzn::fnd
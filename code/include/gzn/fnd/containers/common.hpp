@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstring>
+#include <memory>
 
 #include "gzn/fnd/pointers.hpp"
 #include "gzn/fnd/utility.hpp"
@@ -14,9 +15,13 @@ using pure_pointer_t = std::add_pointer_t<std::remove_all_extents_t<T>>;
 
 template<class T, class Ptr = pure_pointer_t<T>>
 [[nodiscard]]
-auto allocate(util::allocator_type auto &alloc, u32 count) -> Ptr {
+auto allocate(
+  util::allocator_type auto &alloc,
+  u32 const                  count,
+  u32 const                  flags = 0
+) -> Ptr {
   if (count == 0) { return nullptr; }
-  u32 constexpr offset{}, flags{};
+  u32 constexpr offset{};
   return static_cast<Ptr>(
     alloc.allocate(count * sizeof(T), alignof(T), offset, flags)
   );
@@ -28,9 +33,10 @@ auto allocate_move(
   util::allocator_type auto &alloc,
   Ptr                        from,
   Ptr                        to,
-  u32 const                  count
+  u32 const                  count,
+  u32 const                  flags = 0
 ) -> Ptr {
-  if (auto raw{ allocate<T, Ptr>(alloc, count) }; raw) {
+  if (auto raw{ allocate<T, Ptr>(alloc, count, flags) }; raw) {
     if constexpr (std::is_trivially_copyable_v<T>) {
       std::memcpy(raw, from, sizeof(T) * std::distance(from, to));
     } else {
@@ -53,9 +59,10 @@ auto allocate_copy(
   util::allocator_type auto &alloc,
   util::iterator_type auto   from,
   util::iterator_type auto   to,
-  u32 const                  count
+  u32 const                  count,
+  u32 const                  flags = 0
 ) -> Ptr {
-  if (auto raw{ allocate<T, Ptr>(alloc, count) }; raw) {
+  if (auto raw{ allocate<T, Ptr>(alloc, count, flags) }; raw) {
     if constexpr (std::is_trivially_copyable_v<T>) {
       std::memcpy(raw, from, sizeof(T) * std::distance(from, to));
     } else {
@@ -72,6 +79,58 @@ auto allocate_copy(util::allocator_type auto &alloc, Ptr from, Ptr to) -> Ptr {
   return allocate_copy<T, Ptr>(alloc, from, to, std::distance(from, to));
 }
 
+/**
+ * Copy-constructs `[from, to)` into raw memory at `target`. Contiguous
+ * ranges of trivially copyable elements take a single memcpy.
+ * @returns the end of the constructed range
+ */
+template<class T, util::iterator_type Iterator>
+auto construct_copy(Iterator from, Iterator to, T *target) -> T * {
+  using source_type = std::remove_cvref_t<decltype(*from)>;
+  if constexpr (std::is_trivially_copyable_v<T> &&
+                std::same_as<source_type, T> &&
+                std::contiguous_iterator<Iterator>) {
+    auto const count{ static_cast<usize>(to - from) };
+    if (count != 0) {
+      std::memcpy(target, std::to_address(from), count * sizeof(T));
+    }
+    return target + count;
+  } else {
+    return std::uninitialized_copy(from, to, target);
+  }
+}
+
+/**
+ * Moves `[from, to)` to `target` and ends the lifetime of the sources, the
+ * ranges may overlap. Trivially relocatable types take a single memmove.
+ */
+template<class T>
+void relocate(T *from, T *to, T *target) noexcept(
+  std::is_nothrow_move_constructible_v<T>
+) {
+  if (from == target || from == to) { return; }
+
+  if constexpr (util::trivially_relocatable_type<T>) {
+    std::memmove(
+      static_cast<void *>(target),
+      static_cast<void const *>(from),
+      sizeof(T) * static_cast<usize>(to - from)
+    );
+  } else if (target < from) {
+    for (; from != to; ++from, ++target) {
+      std::construct_at(target, std::move(*from));
+      std::destroy_at(from);
+    }
+  } else {
+    for (auto last{ target + (to - from) }; to != from;) {
+      --to;
+      --last;
+      std::construct_at(last, std::move(*to));
+      std::destroy_at(to);
+    }
+  }
+}
+
 } // namespace mem
 
 namespace algo {
@@ -95,44 +154,44 @@ constexpr auto swap_erase(
   return std::prev(std::end(range));
 }
 
+/**
+ * Opens a gap of `count` elements at `target` by relocating the tail up.
+ * The storage past the end of `range` must be raw memory with room for
+ * `count` elements; the returned gap is raw memory as well.
+ */
 [[nodiscard]]
 constexpr auto shift(
   util::range_type auto   &range,
   util::iterator_type auto target,
-  u32                      shift = 1
+  u32                      count = 1
 ) {
-  gzn_assertion(
-    target < std::end(range) && target >= std::begin(range),
-    "'target' is out of range"
-  );
+  auto const first{ std::data(range) };
+  auto const last{ first + std::size(range) };
+  gzn_assertion(target <= last && target >= first, "'target' is out of range");
 
-  for (auto last{ get_last(range) }; last != target; --last) {
-    std::iter_swap(last, last + shift);
-  }
+  mem::relocate(target, last, target + count);
   return target;
 }
 
+/**
+ * Destroys `[from, to)` and relocates the tail down to close the hole.
+ * @returns the new end, storage from it to the old end is raw memory
+ */
 [[nodiscard]]
 constexpr auto shift_erase(
   util::range_type auto   &range,
   util::iterator_type auto from,
   util::iterator_type auto to
 ) {
-  gzn_assertion(from < to, "The iterator pairs 'from' & 'to' are invalid");
-  gzn_assertion(
-    from < std::end(range) && from >= std::begin(range),
-    "'from' is out of range"
-  );
-  gzn_assertion(
-    to < std::end(range) && to >= std::begin(range), "'to' is out of range"
-  );
-
-  auto const last{ get_last(range) };
-  auto const count{ static_cast<usize>(std::distance(from, to)) };
-  for (auto tail{ std::distance(to, last) }; tail; ++from, --tail) {
-    std::iter_swap(from, from + count);
-  }
-  return from;
+  auto const first{ std::data(range) };
+  auto const last{ first + std::size(range) };
+  gzn_assertion(from <= to, "The iterator pairs 'from' & 'to' are invalid");
+  gzn_assertion(from >= first, "'from' is out of range");
+  gzn_assertion(to <= last, "'to' is out of range");
+
+  std::destroy(from, to);
+  mem::relocate(to, last, from);
+  return from + (last - to);
 }
 
 } // namespace algo
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <atomic>
+
+#include "gzn/fnd/containers/pool.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * Thread-safe counterpart of @ref non_owning_pool for resources created and
+ * destroyed by streaming threads while another thread resolves handles.
+ *
+ * Slots are taken from a lock-free free list whose head carries a tag
+ * against ABA, and each slot's generation is bumped with a CAS, so only one
+ * of several racing `remove` calls wins. Handle validation is a single
+ * acquire load. There is no dense array: elements stay in their slots and
+ * iteration isn't offered.
+ *
+ * `get` doesn't keep the element alive: removing an element while another
+ * thread still reads it is a race, defer removals to a point where readers
+ * are done with the handle, e.g. the end of the frame.
+ */
+template<class T, class Generation = gen_counter32>
+class non_owning_concurrent_pool {
+  using generation_value  = typename Generation::value_type;
+  using atomic_generation = std::atomic<generation_value>;
+
+  gzn_static_assert(
+    atomic_generation::is_always_lock_free, "Generation should be lock-free"
+  );
+  gzn_static_assert(
+    std::atomic<u64>::is_always_lock_free, "Free list head should be lock-free"
+  );
+
+public:
+  using value_type      = T;
+  using pointer         = std::add_pointer_t<T>;
+  using const_pointer   = std::add_pointer_t<std::add_const_t<T>>;
+  using size_type       = usize;
+  using generation_type = Generation;
+  using handle_type     = pool_handle<T, Generation>;
+
+  /// Storage passed to the constructor must be aligned to it
+  static constexpr usize storage_alignment{
+    std::max(alignof(value_type), alignof(std::atomic<u32>))
+  };
+
+  constexpr non_owning_concurrent_pool() = default;
+
+  explicit non_owning_concurrent_pool(
+    byte       *storage,
+    usize const elements_count
+  ) noexcept
+    : m_capacity{ static_cast<u32>(elements_count) }
+    , m_data{ reinterpret_cast<value_type *>(storage) }
+    , m_next{ reinterpret_cast<std::atomic<u32> *>(
+        storage + next_offset(elements_count)
+      ) }
+    , m_generations{ reinterpret_cast<atomic_generation *>(
+        storage + generations_offset(elements_count)
+      ) } {
+    gzn_assertion(m_capacity != 0, "pool should not be empty");
+    gzn_assertion(
+      elements_count < handle_type::invalid_location, "pool is too big"
+    );
+    gzn_assertion(
+      std::bit_cast<usize>(storage) % storage_alignment == 0,
+      "pool storage is misaligned"
+    );
+    for (u32 i{}; i < m_capacity; ++i) {
+      auto const next{
+        i + 1 == m_capacity ? handle_type::invalid_location : i + 1
+      };
+      std::construct_at(m_next + i, next);
+      std::construct_at(m_generations + i, generation_value{});
+    }
+    m_free_head.store(0, std::memory_order_relaxed);
+  }
+
+  non_owning_concurrent_pool(non_owning_concurrent_pool const &) = delete;
+  auto operator=(non_owning_concurrent_pool const &)
+    -> non_owning_concurrent_pool & = delete;
+
+  [[nodiscard]]
+  constexpr auto is_valid() const noexcept {
+    return m_data != nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto elements_count() const noexcept -> size_type {
+    return m_capacity;
+  }
+
+  [[nodiscard]]
+  constexpr auto bytes_count() const noexcept {
+    return get_size_for(m_capacity);
+  }
+
+  /// Approximate while other threads insert or remove
+  [[nodiscard]]
+  auto size() const noexcept -> size_type {
+    return m_size.load(std::memory_order_relaxed);
+  }
+
+  /// @returns an invalid handle when the pool is full
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto emplace(Args &&...args) noexcept(
+    std::is_nothrow_constructible_v<value_type, Args &&...>
+  ) -> handle_type {
+    auto const location{ pop_free() };
+    if (location == handle_type::invalid_location) [[unlikely]] { return {}; }
+
+    std::construct_at(m_data + location, std::forward<Args>(args)...);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    Generation generation{
+      m_generations[location].load(std::memory_order_relaxed)
+    };
+    generation.set_alive();
+    // Publishes the element to readers validating the handle
+    m_generations[location].store(generation.value, std::memory_order_release);
+    return { .location = location, .generation = generation };
+  }
+
+  auto insert(value_type value) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>
+  ) -> handle_type {
+    return emplace(std::move(value));
+  }
+
+  /// @returns false if the handle is stale or another thread removed it
+  /// first
+  auto remove(handle_type const handle) noexcept -> bool {
+    if (!handle.generation.is_alive() || handle.location >= m_capacity) {
+      return false;
+    }
+
+    auto expected{ handle.generation.value };
+    auto next{ handle.generation };
+    next.set_dead_and_next_gen();
+    if (!m_generations[handle.location].compare_exchange_strong(
+          expected, next.value, std::memory_order_acq_rel
+        )) {
+      return false;
+    }
+
+    std::destroy_at(m_data + handle.location);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    push_free(handle.location);
+    return true;
+  }
+
+  /// Wait-free
+  [[nodiscard]]
+  auto contains(handle_type const handle) const noexcept -> bool {
+    return handle.location < m_capacity && handle.generation.is_alive() &&
+           m_generations[handle.location].load(std::memory_order_acquire) ==
+             handle.generation.value;
+  }
+
+  /// Wait-free, @returns nullptr for stale handles
+  [[nodiscard]]
+  auto get(handle_type const handle) noexcept -> pointer {
+    return contains(handle) ? m_data + handle.location : nullptr;
+  }
+
+  [[nodiscard]]
+  auto get(handle_type const handle) const noexcept -> const_pointer {
+    return contains(handle) ? m_data + handle.location : nullptr;
+  }
+
+  /// Destroys the elements still alive, not thread-safe
+  void clear() noexcept {
+    for (u32 i{}; i < m_capacity; ++i) {
+      Generation const generation{
+        m_generations[i].load(std::memory_order_relaxed)
+      };
+      if (generation.is_alive()) {
+        [[maybe_unused]] auto const removed{
+          remove({ .location = i, .generation = generation })
+        };
+      }
+    }
+  }
+
+  /// Bytes taken by a pool of `count` elements, a multiple of
+  /// @ref storage_alignment
+  [[nodiscard]]
+  constexpr static auto get_size_for(usize const count) noexcept -> usize {
+    auto const offset{ generations_offset(count) };
+    return align(offset + count * sizeof(atomic_generation));
+  }
+
+protected:
+  [[nodiscard]]
+  constexpr auto storage() const noexcept -> void * {
+    return m_data;
+  }
+
+private:
+  u32                m_capacity{};
+  value_type        *m_data{ nullptr };
+  std::atomic<u32>  *m_next{ nullptr };
+  atomic_generation *m_generations{ nullptr };
+
+  /// Index of the first free slot in the low half, ABA tag in the high one
+  alignas(constants::cache_line_bytes) std::atomic<u64> m_free_head{
+    handle_type::invalid_location
+  };
+  alignas(constants::cache_line_bytes) std::atomic<u32> m_size{};
+
+  u64 static constexpr index_mask{ 0xFFFF'FFFF };
+  u64 static constexpr tag_step{ u64{ 1 } << 32 };
+
+  [[nodiscard]]
+  static gzn_inline constexpr auto index_of(u64 const head) noexcept -> u32 {
+    return static_cast<u32>(head & index_mask);
+  }
+
+  [[nodiscard]]
+  static gzn_inline constexpr auto pack(
+    u32 const index,
+    u64 const previous
+  ) noexcept -> u64 {
+    return ((previous & ~index_mask) + tag_step) | index;
+  }
+
+  void push_free(u32 const index) noexcept {
+    auto head{ m_free_head.load(std::memory_order_relaxed) };
+    do {
+      m_next[index].store(index_of(head), std::memory_order_relaxed);
+    } while (!m_free_head.compare_exchange_weak(
+      head, pack(index, head), std::memory_order_release,
+      std::memory_order_relaxed
+    ));
+  }
+
+  /// Slots are never given back, so reading `next` of a slot popped by
+  /// another thread is safe: the tag makes the following CAS fail.
+  [[nodiscard]]
+  auto pop_free() noexcept -> u32 {
+    auto head{ m_free_head.load(std::memory_order_acquire) };
+    for (auto index{ index_of(head) }; index != handle_type::invalid_location;
+         index = index_of(head)) {
+      auto const next{ m_next[index].load(std::memory_order_relaxed) };
+      if (m_free_head.compare_exchange_weak(
+            head, pack(next, head), std::memory_order_acquire,
+            std::memory_order_acquire
+          )) {
+        return index;
+      }
+    }
+    return handle_type::invalid_location;
+  }
+
+  [[nodiscard]]
+  constexpr static auto align(usize const bytes_count) noexcept -> usize {
+    return (bytes_count + storage_alignment - 1) & ~(storage_alignment - 1);
+  }
+
+  [[nodiscard]]
+  constexpr static auto next_offset(usize const count) noexcept -> usize {
+    auto const offset{ count * sizeof(value_type) };
+    return (offset + alignof(std::atomic<u32>) - 1) &
+           ~(alignof(std::atomic<u32>) - 1);
+  }
+
+  [[nodiscard]]
+  constexpr static auto generations_offset(usize const count) noexcept
+    -> usize {
+    auto const offset{ next_offset(count) + count * sizeof(std::atomic<u32>) };
+    return (offset + alignof(atomic_generation) - 1) &
+           ~(alignof(atomic_generation) - 1);
+  }
+};
+
+/// @ref non_owning_concurrent_pool allocating its own storage
+template<class T, class Generation = gen_counter32>
+class concurrent_pool : public non_owning_concurrent_pool<T, Generation> {
+  using base_type = non_owning_concurrent_pool<T, Generation>;
+
+public:
+  using typename base_type::value_type;
+  using typename base_type::handle_type;
+
+  explicit concurrent_pool(any_allocator allocator, usize const count)
+    : base_type{ allocate_storage(allocator, count), count }
+    , m_allocator{ allocator } {}
+
+  ~concurrent_pool() {
+    base_type::clear();
+    m_allocator.deallocate(
+      base_type::storage(),
+      static_cast<u32>(base_type::bytes_count()),
+      static_cast<u32>(base_type::storage_alignment)
+    );
+  }
+
+  concurrent_pool(concurrent_pool const &)                    = delete;
+  auto operator=(concurrent_pool const &) -> concurrent_pool & = delete;
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> any_allocator {
+    return m_allocator;
+  }
+
+private:
+  any_allocator m_allocator{};
+
+  [[nodiscard]]
+  static auto allocate_storage(any_allocator &allocator, usize const count)
+    -> byte * {
+    return static_cast<byte *>(allocator.allocate(
+      static_cast<u32>(base_type::get_size_for(count)),
+      static_cast<u32>(base_type::storage_alignment),
+      0
+    ));
+  }
+};
+
+} // namespace gzn::fnd
@@ -1,12 +1,127 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
-#include "gzn/fnd/allocators.hpp"
+#include "gzn/fnd/allocators/context.hpp"
+#include "gzn/fnd/bits.hpp"
 #include "gzn/fnd/hash.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) ||                              \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define GZN_HASH_MAP_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#  define GZN_HASH_MAP_NEON
+#  include <arm_neon.h>
+#endif
+
 namespace gzn::fnd {
 
-// auto const location{ hash(key) & (count - 1) };
+namespace util {
+
+/// Keys carrying their own hash, e.g. @ref basic_name
+template<class T>
+concept prehashed_type = requires(T const &value) {
+  { value.hash() } -> std::convertible_to<u64>;
+};
+
+template<class T>
+using string_char_t = std::remove_cvref_t<
+  decltype(*std::begin(std::declval<T const &>()))>;
+
+/// Strings, string views and character arrays
+template<class T>
+concept string_like_type = requires {
+  requires character_type<string_char_t<T>>;
+  requires std::convertible_to<
+    T const &,
+    std::basic_string_view<string_char_t<T>>>;
+};
+
+/// Null-terminated strings, e.g. `char const *`
+template<class T>
+concept c_string_type =
+  std::is_pointer_v<T> &&
+  character_type<std::remove_cv_t<std::remove_pointer_t<T>>>;
+
+} // namespace util
+
+/**
+ * Default hasher of @ref hash_map. Prehashed keys are taken as is, strings
+ * and null-terminated character pointers are hashed by their characters
+ * and everything else by its object representation. Transparent:
+ * `std::string`, `std::string_view` and `char const *`, or `s8name` and
+ * `s8name_view`, hash to the same value.
+ *
+ * A map keyed by `char const *` still compares its keys as pointers, key
+ * it by `std::string_view` to look strings up by content.
+ */
+struct key_hasher {
+  template<class Key>
+  [[nodiscard]]
+  constexpr auto operator()(Key const &key) const noexcept -> u64 {
+    if constexpr (util::prehashed_type<Key>) {
+      return key.hash();
+    } else if constexpr (util::string_like_type<Key>) {
+      using char_type = util::string_char_t<Key>;
+      std::basic_string_view<char_type> const str{ key };
+      return fnd::hash<char_type>({
+        .key{ std::data(str), std::size(str) }
+      });
+    } else if constexpr (util::c_string_type<Key>) {
+      using char_type = std::remove_cv_t<std::remove_pointer_t<Key>>;
+      using view_type = std::basic_string_view<char_type>;
+      auto const str{ key != nullptr ? view_type{ key } : view_type{} };
+      return fnd::hash<char_type>({
+        .key{ std::data(str), std::size(str) }
+      });
+    } else {
+      gzn_static_assert(
+        std::has_unique_object_representations_v<Key>,
+        "Key has padding or no unique representation, provide a hasher"
+      );
+      auto const bytes{ std::bit_cast<std::array<byte, sizeof(Key)>>(key) };
+      return fnd::hash<byte>({ .key = bytes });
+    }
+  }
+};
+
+namespace util {
+
+/// Lookup keys hashed as they are, whatever the key type of the map
+template<class T>
+concept transparent_key_type =
+  prehashed_type<T> || string_like_type<T> || c_string_type<T>;
+
+} // namespace util
+
+/**
+ * Hashes a lookup key the way a stored `Key` hashes. The default hasher
+ * sees the object representation, so `1` and `u64{ 1 }` would differ:
+ * keys which aren't transparent are converted to `Key` first.
+ */
+template<class Key, class Hasher, class K>
+[[nodiscard]]
+constexpr auto hash_lookup_key(Hasher const &hasher, K const &key) noexcept
+  -> u64 {
+  if constexpr (std::same_as<K, Key> || util::transparent_key_type<K>) {
+    return hasher(key);
+  } else {
+    gzn_static_assert(
+      std::convertible_to<K const &, Key>,
+      "Lookup key is neither transparent nor convertible to the key type"
+    );
+    return hasher(static_cast<Key>(key));
+  }
+}
 
 template<class Key, class Value>
 struct record {
@@ -14,21 +129,695 @@ struct record {
   Value value{};
 };
 
+namespace details {
+
+usize static constexpr hash_map_group_width{ 16 };
+
+u8 static constexpr hash_map_ctrl_empty{ 0x80 };
+u8 static constexpr hash_map_ctrl_deleted{ 0xFE };
+
+/// Control bytes of a table without storage, never written to
+alignas(hash_map_group_width) inline constinit u8
+  hash_map_empty_group[hash_map_group_width]{
+    hash_map_ctrl_empty, hash_map_ctrl_empty, hash_map_ctrl_empty,
+    hash_map_ctrl_empty, hash_map_ctrl_empty, hash_map_ctrl_empty,
+    hash_map_ctrl_empty, hash_map_ctrl_empty, hash_map_ctrl_empty,
+    hash_map_ctrl_empty, hash_map_ctrl_empty, hash_map_ctrl_empty,
+    hash_map_ctrl_empty, hash_map_ctrl_empty, hash_map_ctrl_empty,
+    hash_map_ctrl_empty,
+  };
+
+[[nodiscard]]
+gzn_inline constexpr auto hash_map_h1(u64 const hash) noexcept -> u64 {
+  return hash >> 7;
+}
+
+/// The 7 hash bits stored in the control byte of a full slot
+[[nodiscard]]
+gzn_inline constexpr auto hash_map_h2(u64 const hash) noexcept -> u8 {
+  return static_cast<u8>(hash & 0x7F);
+}
+
+[[nodiscard]]
+gzn_inline constexpr auto hash_map_is_full(u8 const ctrl) noexcept -> bool {
+  return (ctrl & 0x80) == 0;
+}
+
+/**
+ * 16 control bytes compared at once. Every method returns a bit mask with
+ * bit `i` set when the `i`-th byte of the group matches.
+ */
+class hash_map_group {
+public:
+  explicit hash_map_group(u8 const *ctrl) noexcept
+#if defined(GZN_HASH_MAP_SSE2)
+    : m_ctrl{ _mm_load_si128(reinterpret_cast<__m128i const *>(ctrl)) } {
+  }
+#elif defined(GZN_HASH_MAP_NEON)
+    : m_ctrl{ vld1q_u8(ctrl) } {
+  }
+#else
+    : m_ctrl{ ctrl } {
+  }
+#endif
+
+  [[nodiscard]]
+  gzn_inline auto match(u8 const h2) const noexcept -> u32 {
+#if defined(GZN_HASH_MAP_SSE2)
+    auto const pattern{ _mm_set1_epi8(static_cast<char>(h2)) };
+    return mask_of(_mm_cmpeq_epi8(pattern, m_ctrl));
+#elif defined(GZN_HASH_MAP_NEON)
+    return mask_of(vceqq_u8(vdupq_n_u8(h2), m_ctrl));
+#else
+    return mask_of([h2](u8 const ctrl) { return ctrl == h2; });
+#endif
+  }
+
+  [[nodiscard]]
+  gzn_inline auto match_empty() const noexcept -> u32 {
+    return match(hash_map_ctrl_empty);
+  }
+
+  /// Both special values have the high bit set, full slots don't
+  [[nodiscard]]
+  gzn_inline auto match_empty_or_deleted() const noexcept -> u32 {
+#if defined(GZN_HASH_MAP_SSE2)
+    return static_cast<u32>(_mm_movemask_epi8(m_ctrl));
+#elif defined(GZN_HASH_MAP_NEON)
+    return mask_of(vcltzq_s8(vreinterpretq_s8_u8(m_ctrl)));
+#else
+    return mask_of([](u8 const ctrl) { return !hash_map_is_full(ctrl); });
+#endif
+  }
+
+private:
+#if defined(GZN_HASH_MAP_SSE2)
+  __m128i m_ctrl;
+
+  [[nodiscard]]
+  gzn_inline static auto mask_of(__m128i const matches) noexcept -> u32 {
+    return static_cast<u32>(_mm_movemask_epi8(matches));
+  }
+#elif defined(GZN_HASH_MAP_NEON)
+  uint8x16_t m_ctrl;
+
+  [[nodiscard]]
+  gzn_inline static auto mask_of(uint8x16_t const matches) noexcept -> u32 {
+    alignas(16) u8 static constexpr bits[]{
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128,
+    };
+    auto const masked{ vandq_u8(matches, vld1q_u8(bits)) };
+    return static_cast<u32>(vaddv_u8(vget_low_u8(masked))) |
+           static_cast<u32>(vaddv_u8(vget_high_u8(masked))) << 8;
+  }
+#else
+  u8 const *m_ctrl;
+
+  [[nodiscard]]
+  gzn_inline auto mask_of(auto const predicate) const noexcept -> u32 {
+    u32 mask{};
+    for (u32 i{}; i < hash_map_group_width; ++i) {
+      mask |= static_cast<u32>(predicate(m_ctrl[i])) << i;
+    }
+    return mask;
+  }
+#endif
+};
+
+/// Triangular walk over the groups, visits every group of a power of two
+/// table exactly once.
+class hash_map_probe {
+public:
+  constexpr hash_map_probe(u64 const h1, u64 const group_mask) noexcept
+    : m_mask{ group_mask }
+    , m_group{ h1 & group_mask } {}
+
+  [[nodiscard]]
+  constexpr auto offset() const noexcept -> u64 {
+    return m_group * hash_map_group_width;
+  }
+
+  constexpr void next() noexcept {
+    ++m_step;
+    m_group = (m_group + m_step) & m_mask;
+  }
+
+private:
+  u64 m_mask;
+  u64 m_group;
+  u64 m_step{};
+};
+
+} // namespace details
+
+/**
+ * Open-addressing hash table in the spirit of Swiss tables: one control
+ * byte per slot holding 7 bits of the hash, probed a group of 16 at a
+ * time with SSE2/NEON so most misses are rejected without touching a key.
+ * Records live in a single allocation next to the control bytes.
+ *
+ * Pointers to records stay valid until the next insertion which grows the
+ * table, or the erasure of the record.
+ */
 template<
   class Key,
   class Value,
-  util::allocator_type Allocator = base_allocator>
+  util::allocator_type Allocator = base_allocator,
+  class Hasher                   = key_hasher>
 class hash_map {
+  template<bool Const>
+  class basic_iterator;
+
 public:
-  using record_type    = record<Key, Value>;
-  using allocator_type = Allocator;
+  using key_type          = Key;
+  using mapped_type       = Value;
+  using record_type       = record<Key, Value>;
+  using value_type        = record_type;
+  using pointer           = std::add_pointer_t<record_type>;
+  using const_pointer     = std::add_pointer_t<record_type const>;
+  using reference         = std::add_lvalue_reference_t<record_type>;
+  using const_reference   = std::add_lvalue_reference_t<record_type const>;
+
+  using iterator          = basic_iterator<false>;
+  using const_iterator    = basic_iterator<true>;
+  using size_type         = u32;
+  using hash_type         = u64;
+  using hasher            = Hasher;
+
+  using allocator_type    = Allocator;
+  using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  struct insert_result {
+    pointer record{ nullptr };
+    bool    inserted{};
+  };
+
+  /// Takes the allocator of the current @ref allocator_context
+  hash_map() noexcept
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {}
+
+  explicit hash_map(allocator_type &allocator, size_type const capacity = 0)
+    : m_allocator{ storage_of(allocator) } {
+    reserve(capacity);
+  }
+
+  template<u64 Length>
+  explicit hash_map(
+    allocator_type               &allocator,
+    c_array<record_type, Length> &&records
+  )
+    : m_allocator{ storage_of(allocator) } {
+    insert_records(records);
+  }
+
+  template<u64 Length>
+    requires std::same_as<allocator_type, any_allocator>
+  explicit hash_map(c_array<record_type, Length> &&records)
+    : m_allocator{ allocator_context::current() } {
+    insert_records(records);
+  }
+
+  hash_map(hash_map const &other)
+    : m_allocator{ other.m_allocator }
+    , m_hasher{ other.m_hasher } {
+    reserve(other.m_size);
+    for (auto const &record : other) { try_emplace(record.key, record.value); }
+  }
+
+  hash_map(hash_map &&other) noexcept
+    : m_allocator{ other.m_allocator }
+    , m_ctrl{ std::exchange(other.m_ctrl, details::hash_map_empty_group) }
+    , m_slots{ std::exchange(other.m_slots, nullptr) }
+    , m_capacity{ std::exchange(other.m_capacity, size_type{}) }
+    , m_group_mask{ std::exchange(other.m_group_mask, size_type{}) }
+    , m_size{ std::exchange(other.m_size, size_type{}) }
+    , m_growth_left{ std::exchange(other.m_growth_left, size_type{}) }
+    , m_hasher{ other.m_hasher } {}
+
+  ~hash_map() { reset(); }
+
+  auto operator=(hash_map const &other) -> hash_map & {
+    if (&other != this) {
+      clear();
+      reserve(other.m_size);
+      for (auto const &record : other) {
+        try_emplace(record.key, record.value);
+      }
+    }
+    return *this;
+  }
+
+  auto operator=(hash_map &&other) noexcept -> hash_map & {
+    if (&other != this) {
+      reset();
+      m_allocator   = other.m_allocator;
+      m_ctrl        = std::exchange(
+        other.m_ctrl, details::hash_map_empty_group
+      );
+      m_slots       = std::exchange(other.m_slots, nullptr);
+      m_capacity    = std::exchange(other.m_capacity, size_type{});
+      m_group_mask  = std::exchange(other.m_group_mask, size_type{});
+      m_size        = std::exchange(other.m_size, size_type{});
+      m_growth_left = std::exchange(other.m_growth_left, size_type{});
+      m_hasher      = other.m_hasher;
+    }
+    return *this;
+  }
+
+  /// Inserts a default constructed value when `key` is missing
+  template<class K>
+  [[nodiscard]]
+  auto operator[](K &&key) -> mapped_type & {
+    auto const result{ try_emplace(std::forward<K>(key)) };
+    gzn_assertion(result.record != nullptr, "Failed to grow hash_map");
+    return result.record->value;
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto find(K const &key) noexcept -> pointer {
+    auto const index{ find_index(key, hash_of(key)) };
+    return index != invalid_index ? m_slots + index : nullptr;
+  }
 
-  using size_type      = u32;
+  template<class K>
+  [[nodiscard]]
+  auto find(K const &key) const noexcept -> const_pointer {
+    auto const index{ find_index(key, hash_of(key)) };
+    return index != invalid_index ? m_slots + index : nullptr;
+  }
 
-  explicit hash_map(allocator_type &allocator, size_type capacity);
+  template<class K>
+  [[nodiscard]]
+  auto contains(K const &key) const noexcept -> bool {
+    return find_index(key, hash_of(key)) != invalid_index;
+  }
+
+  /// Constructs the value from `args` only when `key` is missing. On
+  /// allocation failure `record` is null.
+  template<class K, class... Args>
+    requires std::constructible_from<key_type, K &&> &&
+             std::constructible_from<mapped_type, Args &&...>
+  auto try_emplace(K &&key, Args &&...args) -> insert_result {
+    auto const hash{ hash_of(key) };
+    if (auto const index{ find_index(key, hash) }; index != invalid_index) {
+      return { .record = m_slots + index, .inserted = false };
+    }
+
+    auto const index{ prepare_insert(hash) };
+    if (index == invalid_index) [[unlikely]] { return {}; }
+
+    auto const raw{ new (m_slots + index) record_type{
+      .key   = key_type(std::forward<K>(key)),
+      .value = mapped_type(std::forward<Args>(args)...),
+    } };
+    return { .record = raw, .inserted = true };
+  }
+
+  auto insert(key_type key, mapped_type value) -> insert_result {
+    return try_emplace(std::move(key), std::move(value));
+  }
+
+  template<class K, class V>
+  auto insert_or_assign(K &&key, V &&value) -> insert_result {
+    auto result{ try_emplace(std::forward<K>(key), std::forward<V>(value)) };
+    if (!result.inserted && result.record != nullptr) {
+      result.record->value = std::forward<V>(value);
+    }
+    return result;
+  }
+
+  template<class K>
+  auto erase(K const &key) -> bool {
+    auto const index{ find_index(key, hash_of(key)) };
+    if (index == invalid_index) { return false; }
+    erase_at(index);
+    return true;
+  }
+
+  /// Destroys every record and keeps the storage
+  void clear() {
+    if (m_capacity == 0) { return; }
+
+    destroy_records();
+    std::memset(m_ctrl, details::hash_map_ctrl_empty, m_capacity);
+    m_size        = 0;
+    m_growth_left = max_load(m_capacity);
+  }
+
+  void reset() {
+    if (m_capacity == 0) { return; }
+
+    destroy_records();
+    get_allocator().deallocate(
+      m_slots, layout_bytes_count(m_capacity), layout_alignment
+    );
+    m_ctrl        = details::hash_map_empty_group;
+    m_slots       = nullptr;
+    m_capacity    = 0;
+    m_group_mask  = 0;
+    m_size        = 0;
+    m_growth_left = 0;
+  }
+
+  /// Makes room for `count` records without further growth
+  void reserve(size_type const count) {
+    if (auto const capacity{ capacity_for(count) }; capacity > m_capacity) {
+      [[maybe_unused]] auto const rehashed{ rehash(capacity) };
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_capacity;
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return m_size == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  auto begin() noexcept -> iterator {
+    return iterator{ m_ctrl, m_slots, m_ctrl + m_capacity };
+  }
+
+  [[nodiscard]]
+  auto end() noexcept -> iterator {
+    return iterator{ m_ctrl + m_capacity };
+  }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> const_iterator {
+    return const_iterator{ m_ctrl, m_slots, m_ctrl + m_capacity };
+  }
+
+  [[nodiscard]]
+  auto end() const noexcept -> const_iterator {
+    return const_iterator{ m_ctrl + m_capacity };
+  }
+
+private:
+  size_type static constexpr invalid_index{ ~size_type{} };
+  size_type static constexpr group_width{ details::hash_map_group_width };
+  size_type static constexpr layout_alignment{
+    std::max<size_type>(alignof(record_type), group_width)
+  };
+
+  allocator_storage m_allocator{};
+  u8               *m_ctrl{ details::hash_map_empty_group };
+  pointer           m_slots{ nullptr };
+  size_type         m_capacity{};
+  size_type         m_group_mask{};
+  size_type         m_size{};
+  size_type         m_growth_left{};
+  [[no_unique_address]] hasher m_hasher{};
+
+  template<bool Const>
+  class basic_iterator {
+  public:
+    using value_type      = record_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = std::conditional_t<
+      Const,
+      hash_map::const_pointer,
+      hash_map::pointer>;
+    using reference = std::add_lvalue_reference_t<
+      std::conditional_t<Const, record_type const, record_type>>;
+
+    constexpr basic_iterator() noexcept = default;
+
+    constexpr basic_iterator(
+      u8 const *ctrl,
+      pointer   slot,
+      u8 const *last
+    ) noexcept
+      : m_ctrl{ ctrl }
+      , m_slot{ slot }
+      , m_last{ last } {
+      skip_free();
+    }
+
+    constexpr explicit basic_iterator(u8 const *last) noexcept
+      : m_ctrl{ last } {}
+
+    constexpr basic_iterator(basic_iterator<false> const &other) noexcept
+      requires Const
+      : m_ctrl{ other.m_ctrl }
+      , m_slot{ other.m_slot }
+      , m_last{ other.m_last } {}
+
+    [[nodiscard]]
+    constexpr auto operator*() const noexcept -> reference {
+      return *m_slot;
+    }
+
+    [[nodiscard]]
+    constexpr auto operator->() const noexcept -> pointer {
+      return m_slot;
+    }
+
+    constexpr auto operator++() noexcept -> basic_iterator & {
+      ++m_ctrl;
+      ++m_slot;
+      skip_free();
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> basic_iterator {
+      auto copy{ *this };
+      ++*this;
+      return copy;
+    }
+
+    [[nodiscard]]
+    constexpr auto operator==(basic_iterator const &other) const noexcept
+      -> bool {
+      return m_ctrl == other.m_ctrl;
+    }
+
+  private:
+    friend class basic_iterator<true>;
+
+    u8 const *m_ctrl{ nullptr };
+    pointer   m_slot{ nullptr };
+    u8 const *m_last{ nullptr };
+
+    constexpr void skip_free() noexcept {
+      while (m_ctrl != m_last && !details::hash_map_is_full(*m_ctrl)) {
+        ++m_ctrl;
+        ++m_slot;
+      }
+    }
+  };
+
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
+  /// Keeps at least 1/8 of the slots empty so every probe terminates
+  [[nodiscard]]
+  static constexpr auto max_load(size_type const capacity) noexcept
+    -> size_type {
+    return capacity - capacity / 8;
+  }
+
+  [[nodiscard]]
+  static constexpr auto capacity_for(size_type const count) noexcept
+    -> size_type {
+    if (count == 0) { return 0; }
+    auto const slots_count{ (static_cast<u64>(count) * 8 + 6) / 7 };
+    return static_cast<size_type>(std::max<u64>(
+      group_width, bits::closest_upper_power_of_two(slots_count)
+    ));
+  }
+
+  /// Records first, control bytes right after them
+  [[nodiscard]]
+  static constexpr auto slots_bytes_count(size_type const capacity) noexcept
+    -> size_type {
+    auto const bytes_count{ capacity * sizeof(record_type) };
+    return static_cast<size_type>(
+      (bytes_count + group_width - 1) & ~usize{ group_width - 1 }
+    );
+  }
+
+  [[nodiscard]]
+  static constexpr auto layout_bytes_count(size_type const capacity) noexcept
+    -> size_type {
+    return slots_bytes_count(capacity) + capacity;
+  }
+
+  template<class K>
+  [[nodiscard]]
+  gzn_inline auto hash_of(K const &key) const noexcept -> hash_type {
+    return hash_lookup_key<key_type>(m_hasher, key);
+  }
+
+  template<class K>
+  [[nodiscard]]
+  gzn_inline auto find_index(K const &key, hash_type const hash)
+    const noexcept -> size_type {
+    auto const h2{ details::hash_map_h2(hash) };
+    details::hash_map_probe probe{ details::hash_map_h1(hash), m_group_mask };
+    for (;; probe.next()) {
+      details::hash_map_group const group{ m_ctrl + probe.offset() };
+      for (auto mask{ group.match(h2) }; mask != 0; mask &= mask - 1) {
+        auto const index{
+          static_cast<size_type>(probe.offset() + std::countr_zero(mask))
+        };
+        if (m_slots[index].key == key) [[likely]] { return index; }
+      }
+      if (group.match_empty() != 0) [[likely]] { return invalid_index; }
+    }
+  }
+
+  [[nodiscard]]
+  auto find_free_index(hash_type const hash) const noexcept -> size_type {
+    details::hash_map_probe probe{ details::hash_map_h1(hash), m_group_mask };
+    for (;; probe.next()) {
+      details::hash_map_group const group{ m_ctrl + probe.offset() };
+      if (auto const mask{ group.match_empty_or_deleted() }; mask != 0) {
+        return static_cast<size_type>(
+          probe.offset() + std::countr_zero(mask)
+        );
+      }
+    }
+  }
+
+  /// Claims a slot for a new record with `hash`, growing when needed
+  [[nodiscard]]
+  auto prepare_insert(hash_type const hash) -> size_type {
+    auto index{ find_free_index(hash) };
+    if (m_growth_left == 0 &&
+        m_ctrl[index] == details::hash_map_ctrl_empty) [[unlikely]] {
+      // Mostly tombstones: rebuilding at the same size is enough
+      auto const capacity{
+        m_capacity != 0 && m_size <= max_load(m_capacity) / 2
+          ? m_capacity
+          : std::max(m_capacity * 2, group_width)
+      };
+      if (!rehash(capacity)) [[unlikely]] { return invalid_index; }
+      index = find_free_index(hash);
+    }
+
+    m_growth_left -= m_ctrl[index] == details::hash_map_ctrl_empty;
+    m_ctrl[index]  = details::hash_map_h2(hash);
+    ++m_size;
+    return index;
+  }
+
+  /// A slot goes back to empty when its group was never full: no probe
+  /// sequence could have walked past it.
+  void erase_at(size_type const index) {
+    if constexpr (!std::is_trivially_destructible_v<record_type>) {
+      m_slots[index].~record_type();
+    }
+
+    auto const group_offset{ index & ~(group_width - 1) };
+    if (details::hash_map_group{ m_ctrl + group_offset }.match_empty() != 0) {
+      m_ctrl[index] = details::hash_map_ctrl_empty;
+      ++m_growth_left;
+    } else {
+      m_ctrl[index] = details::hash_map_ctrl_deleted;
+    }
+    --m_size;
+  }
+
+  [[nodiscard]]
+  auto rehash(size_type const capacity) -> bool {
+    auto const raw{ get_allocator().allocate(
+      layout_bytes_count(capacity), layout_alignment, 0
+    ) };
+    gzn_assertion(raw != nullptr, "Failed to allocate hash_map storage");
+    if (raw == nullptr) [[unlikely]] { return false; }
+
+    auto const old_ctrl{ m_ctrl };
+    auto const old_slots{ m_slots };
+    auto const old_capacity{ m_capacity };
+
+    m_slots      = static_cast<pointer>(raw);
+    m_ctrl       = static_cast<u8 *>(raw) + slots_bytes_count(capacity);
+    m_capacity   = capacity;
+    m_group_mask = capacity / group_width - 1;
+    std::memset(m_ctrl, details::hash_map_ctrl_empty, capacity);
+
+    for (size_type i{}; i < old_capacity; ++i) {
+      if (!details::hash_map_is_full(old_ctrl[i])) { continue; }
+
+      auto &record{ old_slots[i] };
+      auto const hash{ m_hasher(record.key) };
+      auto const index{ find_free_index(hash) };
+      m_ctrl[index] = details::hash_map_h2(hash);
+      new (m_slots + index) record_type{ std::move(record) };
+      if constexpr (!std::is_trivially_destructible_v<record_type>) {
+        record.~record_type();
+      }
+    }
+    m_growth_left = max_load(capacity) - m_size;
+
+    if (old_capacity != 0) {
+      get_allocator().deallocate(
+        old_slots, layout_bytes_count(old_capacity), layout_alignment
+      );
+    }
+    return true;
+  }
+
+  void destroy_records() {
+    if constexpr (!std::is_trivially_destructible_v<record_type>) {
+      for (size_type i{}; i < m_capacity; ++i) {
+        if (details::hash_map_is_full(m_ctrl[i])) {
+          m_slots[i].~record_type();
+        }
+      }
+    }
+  }
 
   template<u64 Length>
-  explicit hash_map(c_array<record_type, Length> &&arr);
+  void insert_records(c_array<record_type, Length> &records) {
+    reserve(Length);
+    for (auto &record : records) {
+      try_emplace(std::move(record.key), std::move(record.value));
+    }
+  }
 };
 
 } // namespace gzn::fnd
+
+#undef GZN_HASH_MAP_SSE2
+#undef GZN_HASH_MAP_NEON
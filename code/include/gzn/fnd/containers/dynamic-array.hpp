@@ -1,14 +1,12 @@
 #pragma once
 
+#include <functional>
+
+#include "gzn/fnd/allocators/context.hpp"
 #include "gzn/fnd/containers/common.hpp"
 
 namespace gzn::fnd {
 
-/* TODO
- * [ ] Keep allocator copy is the worst ever stupid idea. Keep pointer like in
- *     STD sucks too. what about context?
- */
-
 namespace constants {
 
 u64 static constexpr minimum_grow_factor{ 1 };
@@ -19,6 +17,7 @@ u64 static constexpr default_grow_factor{ 2 };
 template<class T>
 struct dynamic_array_twicks {
   u64 static constexpr grow_factor{ constants::default_grow_factor };
+  u32 static constexpr allocation_flags{ allocation_flags::none };
 };
 
 template<
@@ -44,41 +43,73 @@ public:
 
   using allocator_type    = Allocator;
   using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  /// @ref allocation_flags passed with every storage allocation
+  u32 static constexpr allocation_flags{ [] {
+    if constexpr (requires { Twicks::allocation_flags; }) {
+      return static_cast<u32>(Twicks::allocation_flags);
+    } else {
+      return fnd::allocation_flags::none;
+    }
+  }() };
+
+  /// Takes the allocator of the current @ref allocator_context
+  dynamic_array() noexcept
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {}
+
+  explicit dynamic_array(size_type const reserve_size)
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() }
+    , m_capacity{ reserve_size }
+    , m_data{
+      containers::mem::allocate<value_type>(
+        m_allocator, m_capacity, allocation_flags
+      )
+    } {}
 
   explicit dynamic_array(
     allocator_type &allocator,
     size_type const reserve_size = 0
   )
-    : m_allocator{ &allocator }
+    : m_allocator{ storage_of(allocator) }
     , m_capacity{ reserve_size }
-    , m_data{ containers::mem::allocate<value_type>(allocator, m_capacity) } {}
+    , m_data{ containers::mem::allocate<value_type>(
+        allocator, m_capacity, allocation_flags
+      ) } {}
 
   explicit dynamic_array(
     allocator_type              &allocator,
     util::range_type auto const &range
   )
-    : m_allocator{ &allocator }
+    : m_allocator{ storage_of(allocator) }
     , m_capacity{ static_cast<size_type>(util::size(range)) }
     , m_size{ m_capacity }
     , m_data{ containers::mem::allocate_copy<value_type>(
         allocator,
         std::begin(range),
         std::end(range),
-        m_capacity
+        m_capacity,
+        allocation_flags
       ) } {}
 
   explicit dynamic_array(
     allocator_type         &allocator,
     util::range_type auto &&range
   )
-    : m_allocator{ &allocator }
+    : m_allocator{ storage_of(allocator) }
     , m_capacity{ static_cast<size_type>(util::size(range)) }
     , m_size{ m_capacity }
     , m_data{ containers::mem::allocate_move<value_type>(
         allocator,
         std::begin(range),
         std::end(range),
-        m_capacity
+        m_capacity,
+        allocation_flags
       ) } {}
 
   template<size_type Length>
@@ -86,14 +117,15 @@ public:
     allocator_type      &allocator,
     c_array<T, Length> &&values
   )
-    : m_allocator{ &allocator }
+    : m_allocator{ storage_of(allocator) }
     , m_capacity{ Length }
     , m_size{ m_capacity }
     , m_data{ containers::mem::allocate_move<value_type>(
         allocator,
         values,
         values + m_capacity,
-        m_capacity
+        m_capacity,
+        allocation_flags
       ) } {}
 
   dynamic_array(dynamic_array const &other)
@@ -101,10 +133,11 @@ public:
     , m_capacity{ static_cast<size_type>(std::size(other)) }
     , m_size{ m_capacity }
     , m_data{ containers::mem::allocate_copy<value_type>(
-        *m_allocator,
+        get_allocator(),
         std::begin(other),
         std::end(other),
-        m_capacity
+        m_capacity,
+        allocation_flags
       ) } {}
 
   dynamic_array(dynamic_array &&other) noexcept
@@ -122,13 +155,17 @@ public:
     m_capacity = other.m_capacity;
     m_size     = other.m_size;
     m_data     = containers::mem::allocate_copy<value_type>(
-      *m_allocator, std::begin(other), std::end(other), m_capacity
+      get_allocator(),
+      std::begin(other),
+      std::end(other),
+      m_capacity,
+      allocation_flags
     );
     return *this;
   }
 
   auto operator=(dynamic_array &&other) noexcept -> dynamic_array & {
-    if (other != &this) {
+    if (&other != this) {
       reset();
       m_allocator = other.m_allocator;
       m_capacity  = std::exchange(other.m_capacity, size_type{});
@@ -181,19 +218,22 @@ public:
   }
 
   auto push_back(value_type const &value) -> reference {
-    if (m_capacity <= m_size) [[unlikely]] { grow(); }
-    return m_data[m_size++] = value;
+    return emplace_back(value);
   }
 
   auto push_back(value_type &&value) -> reference {
-    if (m_capacity <= m_size) [[unlikely]] { grow(); }
-    return m_data[m_size++] = std::move(value);
+    return emplace_back(std::move(value));
   }
 
   template<class... Args>
     requires std::constructible_from<value_type, Args &&...>
   auto emplace_back(Args &&...args) -> reference {
-    if (m_capacity <= m_size) [[unlikely]] { grow(); }
+    if (m_capacity <= m_size) [[unlikely]] {
+      // `args` may refer to an element which is about to move
+      value_type value{ std::forward<Args>(args)... };
+      grow();
+      return *std::construct_at(m_data + m_size++, std::move(value));
+    }
     auto raw{ new (m_data + m_size)
                 value_type{ std::forward<Args>(args)... } };
     ++m_size;
@@ -210,49 +250,129 @@ public:
     }
   }
 
+  /// Erases `pos` by relocating the last element into its place
   void fast_erase(iterator pos) {
     gzn_assertion(m_size != 0, "erase called with empty array");
     gzn_assertion(begin() <= pos, "'from' is out of range");
     gzn_assertion(end() > pos, "'to' is out of range");
 
-    std::iter_swap(back(), pos);
-    pop_back();
+    auto const last{ end() - 1 };
+    std::destroy_at(pos);
+    containers::mem::relocate(last, last + 1, pos);
+    --m_size;
   }
 
-  auto erase(iterator pos) -> iterator {
-    gzn_assertion(begin() <= pos, "'from' is out of range");
-    gzn_assertion(end() > pos, "'to' is out of range");
-    if (empty()) [[unlikely]] { return end(); }
+  auto erase(iterator pos) -> iterator { return erase(pos, pos + 1); }
+
+  auto erase(iterator from, iterator to) -> iterator {
+    gzn_assertion(begin() <= from, "'from' is out of range");
+    gzn_assertion(end() >= to, "'to' is out of range");
+    if (from == to) [[unlikely]] { return from; }
+
+    auto const last{ containers::algo::shift_erase(*this, from, to) };
+    m_size = static_cast<size_type>(last - m_data);
+    return from;
+  }
+
+  /// Inserts the element before `pos`
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto emplace(iterator pos, Args &&...args) -> iterator {
+    // `args` may refer to an element which is about to move
+    value_type value{ std::forward<Args>(args)... };
+    auto const gap{ open_gap(pos, 1) };
+    std::construct_at(gap, std::move(value));
+    return gap;
+  }
+
+  auto insert(iterator pos, value_type const &value) -> iterator {
+    return emplace(pos, value);
+  }
+
+  auto insert(iterator pos, value_type &&value) -> iterator {
+    return emplace(pos, std::move(value));
+  }
 
-    auto const last{ end() };
-    auto       cur{ pos };
-    for (; cur + 1 != last; ++cur) { std::iter_swap(cur, cur + 1); }
-    if constexpr (!std::is_trivially_destructible_v<value_type>) {
-      cur->~value_type();
+  /// Inserts `[from, to)` before `pos` with at most one reallocation, the
+  /// source must not be this array
+  template<util::iterator_type Iterator>
+  auto insert(iterator pos, Iterator from, Iterator to) -> iterator {
+    auto const count{ static_cast<size_type>(std::distance(from, to)) };
+    if (count == 0) [[unlikely]] { return pos; }
+
+    auto const gap{ open_gap(pos, count) };
+    containers::mem::construct_copy(from, to, gap);
+    return gap;
+  }
+
+  /// Appends a copy of `range`, e.g. a span over an I/O buffer
+  /// @returns the first appended element
+  auto append_range(util::range_type auto const &range) -> iterator {
+    auto const first{ util::data(range) };
+    return insert(end(), first, first + util::size(range));
+  }
+
+  /// Appends `count` elements constructed from `args`, which must not
+  /// refer to elements of this array
+  /// @returns the first appended element
+  template<class... Args>
+    requires std::constructible_from<value_type, Args const &...>
+  auto emplace_back_n(size_type const count, Args const &...args)
+    -> iterator {
+    if (count == 0) [[unlikely]] { return end(); }
+
+    auto const first{ open_gap(end(), count) };
+    for (auto cur{ first }; cur != end(); ++cur) {
+      new (cur) value_type{ args... };
     }
-    --m_size;
-    return pos;
+    return first;
   }
 
-  void clear() {
-    if (m_capacity == 0) { return; }
+  /// Replaces the content with a copy of `range`, which may be a part of
+  /// this array: the copy is then built in fresh storage
+  void assign(util::range_type auto const &range) {
+    auto const first{ util::data(range) };
+    auto const count{ util::size<decltype(range), size_type>(range) };
 
-    if constexpr (!std::is_trivially_destructible_v<value_type>) {
-      auto const last{ end() };
-      for (auto cur{ begin() }; cur != last; ++cur) { cur->~value_type(); }
+    if (count > m_capacity || is_element(first)) {
+      auto const raw{ containers::mem::allocate<value_type>(
+        get_allocator(), count, allocation_flags
+      ) };
+      containers::mem::construct_copy(first, first + count, raw);
+      reset();
+      m_data     = raw;
+      m_capacity = count;
+      m_size     = count;
+      return;
     }
+
+    clear();
+    containers::mem::construct_copy(first, first + count, m_data);
+    m_size = count;
+  }
+
+  /// Replaces the content with `count` copies of `value`, a copy: it may be
+  /// an element of this array
+  void assign(size_type const count, value_type const value) {
+    clear();
+    reserve(count);
+    std::uninitialized_fill_n(m_data, count, value);
+    m_size = count;
+  }
+
+  /// Destroys the elements and keeps the storage
+  void clear() {
+    std::destroy(begin(), end());
     m_size = 0;
-    m_data = nullptr;
   }
 
   void reset() {
     if (m_capacity == 0) { return; }
 
-    if constexpr (!std::is_trivially_destructible_v<value_type>) {
-      auto const last{ end() };
-      for (auto cur{ begin() }; cur != last; ++cur) { cur->~value_type(); }
-    }
-    m_allocator->deallocate(m_data, m_capacity, alignof(value_type));
+    std::destroy(begin(), end());
+    get_allocator().deallocate(
+      m_data, m_capacity * sizeof(value_type), alignof(value_type)
+    );
     m_capacity = 0;
     m_size     = 0;
     m_data     = nullptr;
@@ -260,48 +380,36 @@ public:
 
   void reserve(size_type const count) {
     if (m_capacity >= count) [[unlikely]] { return; }
+    if (m_data && try_resize_in_place(count)) { return; }
 
-    if (m_data) [[unlikely]] {
-      auto new_values{ containers::mem::allocate_move<value_type>(
-        *m_allocator, begin(), end(), count
-      ) };
-      m_allocator->deallocate(m_data, m_capacity, alignof(value_type));
-      m_data = new_values;
-    } else {
-      m_data = containers::mem::allocate<value_type>(*m_allocator, count);
-    }
-    m_capacity = count;
+    relocate_to(count);
   }
 
-  void resize(size_t const count, value_type default_value = {}) {
-    if (m_size == count) [[unlikely]] { return; }
+  /// `default_value` is a copy: it may be an element moved by the growth
+  void resize(size_t const count, value_type const default_value = {}) {
     if (m_size < count) [[likely]] {
-      auto const old_size{ m_size };
       reserve(count);
-
-      auto const last{ m_data + m_capacity - 1 };
-      auto       cur{ m_data + old_size };
-      for (; cur != last; ++cur) { new (cur) value_type{ default_value }; }
-      new (cur) value_type{ std::move(default_value) };
-    } else if constexpr (!std::is_trivially_destructible_v<value_type>) {
-      auto const last{ end() };
-      for (auto cur{ m_data + count }; cur != last; ++cur) {
-        cur->~value_type();
-      }
+      std::uninitialized_fill(m_data + m_size, m_data + count, default_value);
+    } else {
+      std::destroy(m_data + count, end());
     }
+    m_size = count;
+  }
 
+  /// Grows without constructing the new elements, for buffers filled right
+  /// after, e.g. by a read call
+  void resize_uninitialized(size_type const count)
+    requires std::is_trivially_copyable_v<value_type>
+  {
+    reserve(count);
     m_size = count;
   }
 
   auto shrink_to_fit() -> size_type {
     if (m_size == m_capacity || m_capacity == 0) [[unlikely]] { return 0; }
+    if (m_size != 0 && try_resize_in_place(m_size)) { return m_size; }
 
-    auto raw{ containers::mem::allocate_move<value_type>(
-      *m_allocator, begin(), end(), m_size
-    ) };
-    m_allocator->deallocate(m_data, m_capacity, alignof(value_type));
-    m_data     = raw;
-    m_capacity = m_size;
+    relocate_to(m_size);
     return m_size;
   }
 
@@ -347,12 +455,20 @@ public:
 
   [[nodiscard]]
   constexpr auto get_allocator() noexcept -> allocator_type & {
-    return m_allocator;
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
   }
 
   [[nodiscard]]
   constexpr auto get_allocator() const noexcept -> allocator_type const & {
-    return m_allocator;
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
   }
 
   [[nodiscard]]
@@ -382,12 +498,118 @@ public:
   }
 
 private:
-  allocator_pointer m_allocator{ nullptr };
+  allocator_storage m_allocator{};
   size_type         m_capacity{};
   size_type         m_size{};
   pointer           m_data{ nullptr };
 
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
   void grow() { reserve(get_grown_capacity(m_capacity)); }
+
+  [[nodiscard]]
+  auto is_element(const_pointer const ptr) const noexcept -> bool {
+    return std::less_equal<const_pointer>{}(begin(), ptr) &&
+           std::less<const_pointer>{}(ptr, end());
+  }
+
+  /// Moves the elements into a new block of `count` elements
+  void relocate_to(size_type const count) {
+    auto const raw{ containers::mem::allocate<value_type>(
+      get_allocator(), count, allocation_flags
+    ) };
+    if (m_data != nullptr) {
+      containers::mem::relocate(begin(), end(), raw);
+      get_allocator().deallocate(
+        m_data, m_capacity * sizeof(value_type), alignof(value_type)
+      );
+    }
+    m_data     = raw;
+    m_capacity = count;
+  }
+
+  /// Makes room for `count` elements before `pos`
+  /// @returns the first element of the gap, it is raw memory
+  [[nodiscard]]
+  auto open_gap(iterator pos, size_type const count) -> iterator {
+    gzn_assertion(begin() <= pos && pos <= end(), "'pos' is out of range");
+
+    auto const index{ static_cast<size_type>(pos - m_data) };
+    if (m_capacity < m_size + count) [[unlikely]] {
+      auto const capacity{
+        std::max(get_grown_capacity(m_capacity), m_size + count)
+      };
+      if (m_data == nullptr || !try_resize_in_place(capacity)) {
+        auto const raw{ containers::mem::allocate<value_type>(
+          get_allocator(), capacity, allocation_flags
+        ) };
+        if (m_data != nullptr) {
+          containers::mem::relocate(begin(), begin() + index, raw);
+          containers::mem::relocate(
+            begin() + index, end(), raw + index + count
+          );
+          get_allocator().deallocate(
+            m_data, m_capacity * sizeof(value_type), alignof(value_type)
+          );
+        }
+        m_data     = raw;
+        m_capacity = capacity;
+        m_size    += count;
+        return m_data + index;
+      }
+    }
+
+    auto const gap{ containers::algo::shift(*this, m_data + index, count) };
+    m_size += count;
+    return gap;
+  }
+
+  /// Resizes the storage without the allocate-move-deallocate round trip
+  /// when the allocator can extend the block or relocate it bitwise.
+  [[nodiscard]]
+  auto try_resize_in_place(size_type const count) -> bool {
+    // Neither path knows the flags: a reallocated block loses its huge page
+    // alignment and NUMA node, an expanded tail isn't zeroed
+    if constexpr (allocation_flags != fnd::allocation_flags::none) {
+      return false;
+    }
+
+    [[maybe_unused]] auto const bytes_count{
+      static_cast<u32>(m_capacity * sizeof(value_type))
+    };
+    [[maybe_unused]] auto const new_bytes_count{
+      static_cast<u32>(count * sizeof(value_type))
+    };
+
+    if constexpr (util::expandable_allocator_type<allocator_type>) {
+      if (get_allocator().try_expand(m_data, bytes_count, new_bytes_count)) {
+        m_capacity = count;
+        return true;
+      }
+    }
+
+    if constexpr (util::reallocatable_allocator_type<allocator_type> &&
+                  util::trivially_relocatable_type<value_type>) {
+      if (auto raw{ get_allocator().reallocate(
+            m_data, bytes_count, new_bytes_count, alignof(value_type)
+          ) };
+          raw) {
+        m_data     = static_cast<pointer>(raw);
+        m_capacity = count;
+        return true;
+      }
+    }
+
+    return false;
+  }
 };
 
 } // namespace gzn::fnd
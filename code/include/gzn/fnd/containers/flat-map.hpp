@@ -0,0 +1,479 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "gzn/fnd/containers/dictionary.hpp"
+#include "gzn/fnd/containers/dynamic-array.hpp"
+
+namespace gzn::fnd {
+
+template<class T>
+struct flat_map_twicks : dynamic_array_twicks<T> {
+  /// Searches a copy of the keys laid out in Eytzinger (BFS) order instead
+  /// of the sorted array: the first levels of the implicit tree share cache
+  /// lines, which pays off for big read-mostly tables. Every insert and
+  /// erase rebuilds the copy.
+  bool static constexpr eytzinger_layout{ false };
+};
+
+template<class T>
+struct flat_map_eytzinger_twicks : flat_map_twicks<T> {
+  bool static constexpr eytzinger_layout{ true };
+};
+
+namespace details {
+
+template<class Entry>
+struct flat_key_of {
+  using type = Entry;
+
+  [[nodiscard]]
+  static constexpr auto get(Entry const &entry) noexcept -> Entry const & {
+    return entry;
+  }
+};
+
+template<class Key, class Value>
+struct flat_key_of<record<Key, Value>> {
+  using type = Key;
+
+  [[nodiscard]]
+  static constexpr auto get(record<Key, Value> const &entry) noexcept
+    -> Key const & {
+    return entry.key;
+  }
+};
+
+/// Lower bound without data-dependent branches: the loop runs log2(n)
+/// times whatever the keys are and the step compiles to a cmov.
+template<class Entry, class K>
+[[nodiscard]]
+constexpr auto flat_lower_bound(
+  Entry const  *first,
+  usize         length,
+  K const      &key
+) noexcept -> Entry const * {
+  if (length == 0) { return first; }
+
+  while (length > 1) {
+    auto const half{ length / 2 };
+    first  += std::less{}(flat_key_of<Entry>::get(first[half - 1]), key)
+            * half;
+    length -= half;
+  }
+  return first + std::less{}(flat_key_of<Entry>::get(*first), key);
+}
+
+/// Keys of a sorted array in Eytzinger order, 1-based, with the rank of
+/// each key in the sorted array
+template<class Key, util::allocator_type Allocator, class Twicks>
+class flat_eytzinger_index {
+public:
+  flat_eytzinger_index()
+    requires std::same_as<Allocator, any_allocator>
+  = default;
+
+  explicit flat_eytzinger_index(Allocator &allocator)
+    : m_keys{ allocator }
+    , m_ranks{ allocator } {}
+
+  template<class Entry>
+  void build(Entry const *entries, usize const length) {
+    m_keys.clear();
+    m_ranks.clear();
+    if (length == 0) { return; }
+
+    m_keys.resize(length + 1);
+    m_ranks.resize(length + 1);
+    usize rank{};
+    fill(entries, length, rank, 1);
+  }
+
+  /// @returns the sorted rank of the first key not less than `key`
+  template<class K>
+  [[nodiscard]]
+  auto lower_bound(K const &key, usize const length) const noexcept
+    -> usize {
+    if (length == 0) { return 0; }
+
+    auto const keys{ m_keys.data() };
+    usize      index{ 1 };
+    while (index <= length) {
+      index = 2 * index + std::less{}(keys[index], key);
+    }
+    // Drops the trailing right turns and the last left turn
+    index >>= std::countr_one(index) + 1;
+    return index == 0 ? length : m_ranks[index];
+  }
+
+private:
+  dynamic_array<Key, Allocator, Twicks> m_keys;
+  dynamic_array<u32, Allocator, Twicks> m_ranks;
+
+  template<class Entry>
+  void fill(
+    Entry const *entries,
+    usize const  length,
+    usize       &rank,
+    usize const  index
+  ) {
+    if (index > length) { return; }
+
+    fill(entries, length, rank, 2 * index);
+    m_keys[index]  = flat_key_of<Entry>::get(entries[rank]);
+    m_ranks[index] = static_cast<u32>(rank++);
+    fill(entries, length, rank, 2 * index + 1);
+  }
+};
+
+struct flat_no_index {
+  constexpr flat_no_index() noexcept = default;
+
+  template<class Allocator>
+  explicit constexpr flat_no_index(Allocator &) noexcept {}
+};
+
+} // namespace details
+
+/**
+ * Sorted @ref dynamic_array of unique entries, the storage behind
+ * @ref flat_map and @ref flat_set. Lookups are a branchless binary search
+ * over contiguous memory, which beats node-based and hashed maps for small
+ * and medium read-mostly tables; inserts and erases shift the tail.
+ * Fill it with `insert_range`, which sorts and merges once per batch.
+ */
+template<class Entry, util::allocator_type Allocator, class Twicks>
+class basic_flat_table {
+  using key_of = details::flat_key_of<Entry>;
+
+  bool static constexpr eytzinger_layout{ [] {
+    if constexpr (requires { Twicks::eytzinger_layout; }) {
+      return static_cast<bool>(Twicks::eytzinger_layout);
+    } else {
+      return false;
+    }
+  }() };
+
+public:
+  using key_type        = typename key_of::type;
+  using value_type      = Entry;
+  using storage_type    = dynamic_array<Entry, Allocator, Twicks>;
+  using pointer         = typename storage_type::pointer;
+  using const_pointer   = typename storage_type::const_pointer;
+  using iterator        = typename storage_type::iterator;
+  using const_iterator  = typename storage_type::const_iterator;
+  using size_type       = typename storage_type::size_type;
+  using allocator_type  = Allocator;
+
+  /// Takes the allocator of the current @ref allocator_context
+  basic_flat_table()
+    requires std::same_as<allocator_type, any_allocator>
+  = default;
+
+  explicit basic_flat_table(
+    allocator_type &allocator,
+    size_type const reserve_size = 0
+  )
+    : m_entries{ allocator, reserve_size }
+    , m_index{ allocator } {}
+
+  /// Entries are sorted and merged in one go, see `insert_range`
+  explicit basic_flat_table(
+    allocator_type              &allocator,
+    util::range_type auto const &entries
+  )
+    : basic_flat_table{ allocator } {
+    insert_range(entries);
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto lower_bound(K const &key) noexcept -> iterator {
+    return begin() + lower_bound_rank(key);
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto lower_bound(K const &key) const noexcept -> const_iterator {
+    return begin() + lower_bound_rank(key);
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto find(K const &key) noexcept -> pointer {
+    auto const found{ lower_bound(key) };
+    return found != end() && matches(*found, key) ? found : nullptr;
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto find(K const &key) const noexcept -> const_pointer {
+    auto const found{ lower_bound(key) };
+    return found != end() && matches(*found, key) ? found : nullptr;
+  }
+
+  template<class K>
+  [[nodiscard]]
+  auto contains(K const &key) const noexcept -> bool {
+    return find(key) != nullptr;
+  }
+
+  /// Appends `entries`, sorts them and merges them into the table with a
+  /// single pass. Entries already in the table win over new ones with the
+  /// same key, of duplicates inside `entries` one is kept.
+  void insert_range(util::range_type auto const &entries) {
+    auto const old_size{ size() };
+    m_entries.append_range(entries);
+
+    auto const added{ m_entries.begin() + old_size };
+    std::sort(added, m_entries.end(), by_key);
+    auto const unique_end{ std::unique(added, m_entries.end(), same_key) };
+    m_entries.erase(unique_end, m_entries.end());
+
+    if (old_size != 0 && added != m_entries.end()) {
+      merge_sorted_tail(old_size);
+    }
+    rebuild_index();
+  }
+
+  template<class K>
+  auto erase(K const &key) -> bool {
+    auto const found{ find(key) };
+    if (found == nullptr) { return false; }
+
+    erase(found);
+    return true;
+  }
+
+  auto erase(iterator pos) -> iterator {
+    auto const next{ m_entries.erase(pos) };
+    rebuild_index();
+    return next;
+  }
+
+  void clear() {
+    m_entries.clear();
+    rebuild_index();
+  }
+
+  void reserve(size_type const count) { m_entries.reserve(count); }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    return m_entries.size();
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_entries.capacity();
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return m_entries.empty();
+  }
+
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> const_pointer {
+    return m_entries.data();
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    return m_entries.get_allocator();
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    return m_entries.get_allocator();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() noexcept -> iterator {
+    return m_entries.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() noexcept -> iterator {
+    return m_entries.end();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> const_iterator {
+    return m_entries.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept -> const_iterator {
+    return m_entries.end();
+  }
+
+protected:
+  /// `entry` is the lower bound of `key`, so it matches unless it's greater
+  template<class K>
+  [[nodiscard]]
+  static constexpr auto matches(Entry const &entry, K const &key) noexcept
+    -> bool {
+    return !std::less{}(key, key_of::get(entry));
+  }
+
+  /// `pos` must be the lower bound of the new entry's key
+  template<class... Args>
+  auto emplace_at(iterator pos, Args &&...args) -> iterator {
+    auto const inserted{ m_entries.emplace(pos, std::forward<Args>(args)...) };
+    rebuild_index();
+    return inserted;
+  }
+
+private:
+  using index_type = std::conditional_t<
+    eytzinger_layout,
+    details::flat_eytzinger_index<key_type, Allocator, Twicks>,
+    details::flat_no_index>;
+
+  storage_type                     m_entries{};
+  [[no_unique_address]] index_type m_index{};
+
+  static constexpr auto by_key{ [](Entry const &lhv, Entry const &rhv) {
+    return std::less{}(key_of::get(lhv), key_of::get(rhv));
+  } };
+
+  static constexpr auto same_key{ [](Entry const &lhv, Entry const &rhv) {
+    return !std::less{}(key_of::get(lhv), key_of::get(rhv)) &&
+           !std::less{}(key_of::get(rhv), key_of::get(lhv));
+  } };
+
+  template<class K>
+  [[nodiscard]]
+  auto lower_bound_rank(K const &key) const noexcept -> size_type {
+    if constexpr (eytzinger_layout) {
+      return m_index.lower_bound(key, size());
+    } else {
+      return static_cast<size_type>(
+        details::flat_lower_bound(m_entries.data(), size(), key) -
+        m_entries.data()
+      );
+    }
+  }
+
+  void rebuild_index() {
+    if constexpr (eytzinger_layout) {
+      m_index.build(m_entries.data(), size());
+    }
+  }
+
+  /// Merges the sorted `[old_size, size())` into the sorted prefix through
+  /// a new storage block, dropping new entries whose key is already present
+  void merge_sorted_tail(size_type const old_size) {
+    storage_type merged{ get_allocator(), size() };
+
+    auto       lhv{ m_entries.begin() };
+    auto const middle{ m_entries.begin() + old_size };
+    auto       rhv{ middle };
+    auto const last{ m_entries.end() };
+    while (lhv != middle && rhv != last) {
+      if (by_key(*rhv, *lhv)) {
+        merged.push_back(std::move(*rhv++));
+      } else {
+        rhv += !by_key(*lhv, *rhv);
+        merged.push_back(std::move(*lhv++));
+      }
+    }
+    for (; lhv != middle; ++lhv) { merged.push_back(std::move(*lhv)); }
+    for (; rhv != last; ++rhv) { merged.push_back(std::move(*rhv)); }
+
+    m_entries = std::move(merged);
+  }
+};
+
+/// Sorted map on a @ref dynamic_array of @ref record
+template<
+  class Key,
+  class Value,
+  util::allocator_type Allocator = base_allocator,
+  class Twicks                   = flat_map_twicks<record<Key, Value>>>
+class flat_map
+  : public basic_flat_table<record<Key, Value>, Allocator, Twicks> {
+  using base_type = basic_flat_table<record<Key, Value>, Allocator, Twicks>;
+
+public:
+  using mapped_type = Value;
+  using record_type = record<Key, Value>;
+  using typename base_type::key_type;
+  using typename base_type::pointer;
+
+  struct insert_result {
+    pointer record{ nullptr };
+    bool    inserted{};
+  };
+
+  using base_type::base_type;
+
+  /// Inserts a default constructed value when `key` is missing
+  template<class K>
+  [[nodiscard]]
+  auto operator[](K &&key) -> mapped_type & {
+    return try_emplace(std::forward<K>(key)).record->value;
+  }
+
+  /// Constructs the value from `args` only when `key` is missing
+  template<class K, class... Args>
+    requires std::constructible_from<key_type, K &&> &&
+             std::constructible_from<mapped_type, Args &&...>
+  auto try_emplace(K &&key, Args &&...args) -> insert_result {
+    auto const pos{ base_type::lower_bound(key) };
+    if (pos != base_type::end() && base_type::matches(*pos, key)) {
+      return { .record = pos, .inserted = false };
+    }
+
+    auto const record{ base_type::emplace_at(
+      pos,
+      record_type{
+        .key   = key_type(std::forward<K>(key)),
+        .value = mapped_type(std::forward<Args>(args)...),
+      }
+    ) };
+    return { .record = record, .inserted = true };
+  }
+
+  auto insert(key_type key, mapped_type value) -> insert_result {
+    return try_emplace(std::move(key), std::move(value));
+  }
+
+  template<class K, class V>
+  auto insert_or_assign(K &&key, V &&value) -> insert_result {
+    auto result{ try_emplace(std::forward<K>(key), std::forward<V>(value)) };
+    if (!result.inserted) { result.record->value = std::forward<V>(value); }
+    return result;
+  }
+};
+
+/// Sorted set on a @ref dynamic_array
+template<
+  class Key,
+  util::allocator_type Allocator = base_allocator,
+  class Twicks                   = flat_map_twicks<Key>>
+class flat_set : public basic_flat_table<Key, Allocator, Twicks> {
+  using base_type = basic_flat_table<Key, Allocator, Twicks>;
+
+public:
+  using typename base_type::key_type;
+  using typename base_type::pointer;
+
+  using base_type::base_type;
+
+  /// @returns the stored key and whether it was inserted
+  auto insert(key_type key) -> std::pair<pointer, bool> {
+    auto const pos{ base_type::lower_bound(key) };
+    if (pos != base_type::end() && base_type::matches(*pos, key)) {
+      return { pos, false };
+    }
+    return { base_type::emplace_at(pos, std::move(key)), true };
+  }
+};
+
+} // namespace gzn::fnd
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+#include "gzn/fnd/containers/dictionary.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+u32 static constexpr frozen_map_max_seed{ 1u << 20 };
+
+} // namespace constants
+
+namespace details {
+
+/// Never defined: reaching it while building a @ref frozen_map turns the
+/// failure into a compile error.
+void frozen_map_build_failed(cstr reason);
+
+/// Second level hash: places a key of a bucket using the bucket's seed,
+/// derived from the key hash so the key itself is hashed only once.
+[[nodiscard]]
+gzn_inline constexpr auto frozen_map_slot(
+  u64 const hash,
+  u32 const seed
+) noexcept -> u64 {
+  return hash_mix(hash ^ hash_secret[0], hash_secret[1] + seed);
+}
+
+} // namespace details
+
+/**
+ * Immutable map laid out at compile time with a collision-free (CHD-style)
+ * hash: keys are split into buckets by their hash, and every bucket gets a
+ * seed placing all of its keys into distinct slots. Lookup is one key hash,
+ * one seed and slot read and one key comparison, with no runtime
+ * initialisation. Build it with @ref make_frozen_map.
+ */
+template<class Key, class Value, usize Length, class Hasher = key_hasher>
+class frozen_map {
+  gzn_static_assert(Length > 0, "frozen_map needs at least one record");
+
+public:
+  using key_type       = Key;
+  using mapped_type    = Value;
+  using record_type    = record<Key, Value>;
+  using value_type     = record_type;
+  using const_pointer  = std::add_pointer_t<record_type const>;
+  using const_iterator = const_pointer;
+  using size_type      = usize;
+  using hash_type      = u64;
+  using hasher         = Hasher;
+  using index_type     = std::conditional_t<
+    Length < std::numeric_limits<u16>::max(),
+    u16,
+    u32>;
+
+  consteval explicit frozen_map(c_array<record_type, Length> &&records)
+    : m_records{ std::to_array(std::move(records)) } {
+    build();
+  }
+
+  template<class K>
+  [[nodiscard]]
+  constexpr auto find(K const &key) const noexcept -> const_pointer {
+    auto const hash{ hash_lookup_key<key_type>(hasher{}, key) };
+    auto const seed{ m_seeds[hash & bucket_mask] };
+    auto const slot{ details::frozen_map_slot(hash, seed) & slot_mask };
+    auto const index{ m_slots[slot] };
+    if (index == invalid_index) { return nullptr; }
+
+    auto const &record{ m_records[index] };
+    return record.key == key ? &record : nullptr;
+  }
+
+  template<class K>
+  [[nodiscard]]
+  constexpr auto contains(K const &key) const noexcept -> bool {
+    return find(key) != nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    return Length;
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> const_iterator {
+    return std::data(m_records);
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept -> const_iterator {
+    return std::data(m_records) + Length;
+  }
+
+private:
+  usize static constexpr slots_count{ std::bit_ceil(Length) };
+  usize static constexpr slot_mask{ slots_count - 1 };
+  usize static constexpr buckets_count{ std::bit_ceil((Length + 1) / 2) };
+  usize static constexpr bucket_mask{ buckets_count - 1 };
+  index_type static constexpr invalid_index{
+    std::numeric_limits<index_type>::max()
+  };
+
+  std::array<record_type, Length>     m_records;
+  std::array<u32, buckets_count>      m_seeds{};
+  std::array<index_type, slots_count> m_slots{};
+
+  consteval void build() {
+    std::array<hash_type, Length> hashes{};
+    for (usize i{}; i < Length; ++i) {
+      hashes[i] = hasher{}(m_records[i].key);
+      for (usize j{}; j < i; ++j) {
+        if (hashes[i] == hashes[j]) {
+          details::frozen_map_build_failed("Duplicate key or hash collision");
+        }
+      }
+    }
+
+    // Records grouped by bucket, the biggest buckets are placed first while
+    // the table is still empty
+    std::array<index_type, Length> order{};
+    for (usize i{}; i < Length; ++i) { order[i] = static_cast<index_type>(i); }
+
+    std::array<usize, buckets_count> bucket_sizes{};
+    for (auto const hash : hashes) { ++bucket_sizes[hash & bucket_mask]; }
+
+    std::ranges::sort(order, [&](index_type const lhv, index_type const rhv) {
+      auto const lhv_bucket{ hashes[lhv] & bucket_mask };
+      auto const rhv_bucket{ hashes[rhv] & bucket_mask };
+      if (bucket_sizes[lhv_bucket] != bucket_sizes[rhv_bucket]) {
+        return bucket_sizes[lhv_bucket] > bucket_sizes[rhv_bucket];
+      }
+      return lhv_bucket < rhv_bucket;
+    });
+
+    m_slots.fill(invalid_index);
+    for (usize first{}; first < Length;) {
+      auto const bucket{ hashes[order[first]] & bucket_mask };
+      auto       last{ first };
+      while (last < Length && (hashes[order[last]] & bucket_mask) == bucket) {
+        ++last;
+      }
+
+      m_seeds[bucket] = find_seed(hashes, order, first, last);
+      for (auto i{ first }; i < last; ++i) {
+        auto const slot{
+          details::frozen_map_slot(hashes[order[i]], m_seeds[bucket]) &
+          slot_mask
+        };
+        m_slots[slot] = order[i];
+      }
+      first = last;
+    }
+  }
+
+  /// The first seed sending every key of `order[first, last)` to a distinct
+  /// free slot
+  [[nodiscard]]
+  consteval auto find_seed(
+    std::array<hash_type, Length> const  &hashes,
+    std::array<index_type, Length> const &order,
+    usize const                           first,
+    usize const                           last
+  ) const -> u32 {
+    for (u32 seed{}; seed < constants::frozen_map_max_seed; ++seed) {
+      std::array<usize, Length> taken{};
+      auto                      taken_count{ 0uz };
+      for (auto i{ first }; i < last; ++i) {
+        auto const slot{
+          details::frozen_map_slot(hashes[order[i]], seed) & slot_mask
+        };
+        auto const taken_last{ std::begin(taken) + taken_count };
+        if (m_slots[slot] != invalid_index ||
+            std::find(std::begin(taken), taken_last, slot) != taken_last) {
+          break;
+        }
+        taken[taken_count++] = slot;
+      }
+      if (taken_count == last - first) { return seed; }
+    }
+    details::frozen_map_build_failed("No seed found for a bucket");
+    return 0;
+  }
+};
+
+/// `make_frozen_map<Key, Value>({ { key, value }, ... })`, evaluated at
+/// compile time
+template<
+  class Key,
+  class Value,
+  class Hasher = key_hasher,
+  usize Length>
+[[nodiscard]]
+consteval auto make_frozen_map(
+  c_array<record<Key, Value>, Length> &&records
+) -> frozen_map<Key, Value, Length, Hasher> {
+  return frozen_map<Key, Value, Length, Hasher>{ std::move(records) };
+}
+
+} // namespace gzn::fnd
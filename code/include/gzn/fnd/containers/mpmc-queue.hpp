@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+#include "gzn/fnd/allocators/context.hpp"
+#include "gzn/fnd/containers/common.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * Bounded lock-free queue for any number of producers and consumers, e.g.
+ * gfx command submission and asset streaming (Vyukov's design). Every cell
+ * carries a sequence number telling whose turn it is: a producer claims
+ * position `p` once the cell's sequence equals `p`, a consumer once it
+ * equals `p + 1`. Contention is limited to one CAS on the shared position
+ * per operation.
+ *
+ * The capacity is rounded up to a power of 2.
+ */
+template<class T, util::allocator_type Allocator = base_allocator>
+class mpmc_queue {
+  struct cell {
+    std::atomic<usize> sequence{};
+    alignas(T) byte storage[sizeof(T)];
+
+    [[nodiscard]]
+    gzn_inline auto value() noexcept -> T * {
+      return std::launder(reinterpret_cast<T *>(storage));
+    }
+  };
+
+public:
+  using value_type        = T;
+  using size_type         = usize;
+
+  using allocator_type    = Allocator;
+  using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  /// Takes the allocator of the current @ref allocator_context
+  explicit mpmc_queue(size_type const capacity)
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() }
+    , m_mask{ mask_for(capacity) }
+    , m_cells{ allocate_cells() } {}
+
+  explicit mpmc_queue(allocator_type &allocator, size_type const capacity)
+    : m_allocator{ storage_of(allocator) }
+    , m_mask{ mask_for(capacity) }
+    , m_cells{ allocate_cells() } {}
+
+  mpmc_queue(mpmc_queue const &) = delete;
+  mpmc_queue(mpmc_queue &&)      = delete;
+
+  ~mpmc_queue() {
+    auto const tail{ m_enqueue.position.load(std::memory_order_relaxed) };
+    auto const head{ m_dequeue.position.load(std::memory_order_relaxed) };
+    for (auto i{ head }; i != tail; ++i) {
+      std::destroy_at(m_cells[i & m_mask].value());
+    }
+    get_allocator().deallocate(
+      m_cells, static_cast<u32>(capacity() * sizeof(cell)), alignof(cell)
+    );
+  }
+
+  auto operator=(mpmc_queue const &) -> mpmc_queue & = delete;
+  auto operator=(mpmc_queue &&) -> mpmc_queue &      = delete;
+
+  /// @returns false when the queue is full
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto try_emplace(Args &&...args) -> bool {
+    auto position{ m_enqueue.position.load(std::memory_order_relaxed) };
+    for (;;) {
+      auto      &target{ m_cells[position & m_mask] };
+      auto const sequence{ target.sequence.load(std::memory_order_acquire) };
+      auto const lag{ static_cast<ssize>(sequence - position) };
+      if (lag == 0) {
+        if (m_enqueue.position.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed
+            )) {
+          std::construct_at(target.value(), std::forward<Args>(args)...);
+          target.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // The cell still holds the element from the previous lap
+        return false;
+      } else {
+        position = m_enqueue.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  auto try_push(value_type const &value) -> bool { return try_emplace(value); }
+
+  auto try_push(value_type &&value) -> bool {
+    return try_emplace(std::move(value));
+  }
+
+  /// @returns false when the queue is empty
+  auto try_pop(value_type &out) -> bool {
+    auto position{ m_dequeue.position.load(std::memory_order_relaxed) };
+    for (;;) {
+      auto      &source{ m_cells[position & m_mask] };
+      auto const sequence{ source.sequence.load(std::memory_order_acquire) };
+      auto const lag{ static_cast<ssize>(sequence - (position + 1)) };
+      if (lag == 0) {
+        if (m_dequeue.position.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed
+            )) {
+          out = std::move(*source.value());
+          std::destroy_at(source.value());
+          // Hands the cell to the producer of the next lap
+          source.sequence.store(
+            position + capacity(), std::memory_order_release
+          );
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        position = m_dequeue.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Approximate while other threads are running
+  [[nodiscard]]
+  auto size() const noexcept -> size_type {
+    auto const tail{ m_enqueue.position.load(std::memory_order_acquire) };
+    auto const head{ m_dequeue.position.load(std::memory_order_acquire) };
+    return tail > head ? tail - head : 0;
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return size() == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_mask + 1;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+private:
+  struct alignas(constants::cache_line_bytes) padded_position {
+    std::atomic<size_type> position{};
+  };
+
+  allocator_storage m_allocator{};
+  size_type         m_mask{};
+  cell             *m_cells{ nullptr };
+  padded_position   m_enqueue{};
+  padded_position   m_dequeue{};
+
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
+  [[nodiscard]]
+  static constexpr auto mask_for(size_type const capacity) noexcept
+    -> size_type {
+    return std::bit_ceil(std::max(capacity, size_type{ 2 })) - 1;
+  }
+
+  [[nodiscard]]
+  auto allocate_cells() -> cell * {
+    auto const cells{ containers::mem::allocate<cell>(
+      get_allocator(), static_cast<u32>(capacity())
+    ) };
+    gzn_assertion(cells != nullptr, "Failed to allocate the queue");
+    for (size_type i{}; i < capacity(); ++i) {
+      new (cells + i) cell{};
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    return cells;
+  }
+};
+
+} // namespace gzn::fnd
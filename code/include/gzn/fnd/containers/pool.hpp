@@ -1,23 +1,32 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
+#include <limits>
+#include <memory>
+#include <span>
 
 #include "gzn/fnd/allocators.hpp"
+#include "gzn/fnd/allocators/context.hpp"
 #include "gzn/fnd/assert.hpp"
-#include "gzn/fnd/bits.hpp"
+#include "gzn/fnd/containers/common.hpp"
 #include "gzn/fnd/definitions.hpp"
 
 namespace gzn::fnd {
 
-template<class T>
-class pool;
-
-#pragma pack(push, 1)
+/**
+ * Slot generation, the lowest bit tells if the slot is alive. Every reuse
+ * of a slot bumps the counter, so an 8-bit counter wraps after 128 reuses
+ * and a stale handle may match again; use @ref gen_counter32 for slots
+ * which are recycled often.
+ */
+template<std::unsigned_integral T>
+struct basic_gen_counter {
+  using value_type = T;
 
-struct alignas(u8) gen_counter {
-  static constexpr u32 alive_mask{ 1 };
+  static constexpr T alive_mask{ 1 };
 
-  u8 value{};
+  T value{};
 
   gzn_inline constexpr void next_gen() noexcept { value += 2; }
 
@@ -28,51 +37,100 @@ struct alignas(u8) gen_counter {
 
   gzn_inline constexpr void set_alive() noexcept { value |= alive_mask; }
 
-  gzn_inline constexpr void set_dead() noexcept { value &= ~alive_mask; }
+  gzn_inline constexpr void set_dead() noexcept {
+    value &= static_cast<T>(~alive_mask);
+  }
 
   gzn_inline constexpr void set_dead_and_next_gen() noexcept {
-    value &= ~alive_mask;
-    value += 2;
+    set_dead();
+    next_gen();
   }
+
+  [[nodiscard]]
+  constexpr auto operator==(basic_gen_counter const &) const noexcept
+    -> bool = default;
 };
 
-#pragma pack(pop)
+using gen_counter   = basic_gen_counter<u8>;
+using gen_counter32 = basic_gen_counter<u32>;
 
-template<class T>
-struct handle {
+/// Key of a pool element: stays valid until the element is removed, and
+/// stops resolving once its slot is reused
+template<class T, class Generation = gen_counter>
+struct pool_handle {
   using value_type = T;
 
-  pool<T>    *pool{ nullptr };
-  usize       location{ 0 };
-  gen_counter generation{ 0 };
+  static constexpr u32 invalid_location{ std::numeric_limits<u32>::max() };
+
+  u32        location{ invalid_location };
+  Generation generation{};
 
   [[nodiscard]]
-  constexpr auto is_actual() const noexcept -> bool;
+  constexpr auto is_valid() const noexcept -> bool {
+    return location != invalid_location;
+  }
 
   [[nodiscard]]
-  constexpr auto value(this auto &&self) noexcept -> value_type *;
+  constexpr auto operator==(pool_handle const &) const noexcept
+    -> bool = default;
 };
 
-template<class T>
+/**
+ * Generational slot map over external storage. Elements are kept packed in
+ * a dense array, so iteration touches live elements only; handles go
+ * through a slot table holding each element's dense index and generation.
+ * Insert and remove are O(1): freed slots are reused through a free list
+ * and removal moves the last element into the hole.
+ */
+template<class T, class Generation = gen_counter>
 class non_owning_pool {
   static constexpr bool T_nothrow_move{
     std::is_nothrow_move_constructible_v<T>
   };
 
+  struct slot {
+    /// Dense index while alive, next free slot while dead
+    u32        index{};
+    Generation generation{};
+  };
+
 public:
-  using value_type            = T;
-  using handle_type           = handle<T>;
-  using destructor            = void (*)(void *, void *, usize);
+  using value_type      = T;
+  using pointer         = std::add_pointer_t<T>;
+  using const_pointer   = std::add_pointer_t<std::add_const_t<T>>;
+  using iterator        = pointer;
+  using const_iterator  = const_pointer;
+  using size_type       = usize;
+  using generation_type = Generation;
+  using handle_type     = pool_handle<T, Generation>;
+
+  /// Storage passed to the constructor must be aligned to it
+  static constexpr usize storage_alignment{
+    std::max(alignof(value_type), alignof(slot))
+  };
 
   constexpr non_owning_pool() = default;
 
   explicit non_owning_pool(byte *storage, usize const elements_count) noexcept
-    : count{ elements_count }
-    , storage{ storage }
-    , generations{ reinterpret_cast<gen_counter *>(storage) }
-    , data{ reinterpret_cast<T *>(storage) + count * sizeof(gen_counter) } {
-    gzn_assertion(count != 0, "pool should not be empty");
-    std::fill_n(generations, count * sizeof(gen_counter), gen_counter{});
+    : m_capacity{ static_cast<u32>(elements_count) }
+    , m_data{ reinterpret_cast<value_type *>(storage) }
+    , m_dense_to_slot{
+      reinterpret_cast<u32 *>(storage + dense_to_slot_offset(elements_count))
+    }
+    , m_slots{
+      reinterpret_cast<slot *>(storage + slots_offset(elements_count))
+    } {
+    gzn_assertion(m_capacity != 0, "pool should not be empty");
+    gzn_assertion(
+      elements_count < handle_type::invalid_location, "pool is too big"
+    );
+    gzn_assertion(
+      std::bit_cast<usize>(storage) % storage_alignment == 0,
+      "pool storage is misaligned"
+    );
+    for (u32 i{}; i < m_capacity; ++i) {
+      std::construct_at(m_slots + i, slot{ .index = i + 1 });
+    }
   }
 
   non_owning_pool(non_owning_pool const &)                         = default;
@@ -82,225 +140,238 @@ public:
 
   [[nodiscard]]
   constexpr auto is_valid() const noexcept {
-    return storage != nullptr;
+    return m_data != nullptr;
   }
 
   [[nodiscard]]
-  constexpr auto elements_count() const noexcept {
-    return count;
+  constexpr auto elements_count() const noexcept -> size_type {
+    return m_capacity;
   }
 
   [[nodiscard]]
   constexpr auto bytes_count() const noexcept {
-    return get_size_for(count);
+    return get_size_for(m_capacity);
   }
 
   [[nodiscard]]
-  constexpr auto at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return handle_type{ .pool       = &self,
-                        .location   = index,
-                        .generation = self.generations[index] };
+  constexpr auto size() const noexcept -> size_type {
+    return m_size;
   }
 
   [[nodiscard]]
-  constexpr auto value_at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return self.generations[index];
+  constexpr auto empty() const noexcept -> bool {
+    return m_size == 0;
   }
 
   [[nodiscard]]
-  constexpr auto generation_at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return self.generations[index];
-  }
-
-  constexpr auto try_insert_unsafe(
-    value_type  value,
-    usize const index
-  ) noexcept(T_nothrow_move) -> bool {
-    gzn_assertion(index > count, "Index is out of range");
-    if (auto gen{ generations + index }; gen->is_alive()) {
-      std::construct_at(data + index, std::move(value));
-      gen->set_alive();
-      return true;
-    }
-    return false;
+  constexpr auto full() const noexcept -> bool {
+    return m_size == m_capacity;
+  }
+
+  /// @returns an invalid handle when the pool is full
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto emplace(Args &&...args) noexcept(
+    std::is_nothrow_constructible_v<value_type, Args &&...>
+  ) -> handle_type {
+    if (full()) [[unlikely]] { return {}; }
+
+    auto const location{ m_free_head };
+    auto      &target{ m_slots[location] };
+    std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    m_free_head             = target.index;
+    target.index            = m_size;
+    m_dense_to_slot[m_size] = location;
+    ++m_size;
+
+    target.generation.set_alive();
+    return { .location = location, .generation = target.generation };
   }
 
-  gzn_inline constexpr auto try_append(value_type value) noexcept(
-    T_nothrow_move
-  ) -> bool {
-    auto const status{ try_insert_unsafe(std::move(value), top) };
-    top += static_cast<usize>(status);
-    return status;
+  auto insert(value_type value) noexcept(T_nothrow_move) -> handle_type {
+    return emplace(std::move(value));
   }
 
-  constexpr auto remove_at(usize const index) -> bool {
-    gzn_assertion(index > count, "Index is out of range");
-    if (auto gen{ generations + index }; gen->is_alive()) {
-      if constexpr (!std::is_trivially_destructible_v<value_type>) {
-        std::destroy_at(data + index);
-      }
-      gen->set_dead_and_next_gen();
-      return true;
+  /// Destroys the element, the last one is moved into its place
+  auto remove(handle_type const handle) noexcept(T_nothrow_move) -> bool {
+    if (!contains(handle)) { return false; }
+
+    auto      &target{ m_slots[handle.location] };
+    auto const index{ target.index };
+    auto const last{ m_size - 1 };
+
+    std::destroy_at(m_data + index);
+    containers::mem::relocate(m_data + last, m_data + m_size, m_data + index);
+    m_dense_to_slot[index]                = m_dense_to_slot[last];
+    m_slots[m_dense_to_slot[index]].index = index;
+    --m_size;
+
+    target.generation.set_dead_and_next_gen();
+    target.index = m_free_head;
+    m_free_head  = handle.location;
+    return true;
+  }
+
+  void clear() noexcept {
+    for (u32 i{}; i < m_size; ++i) {
+      std::destroy_at(m_data + i);
+
+      auto const location{ m_dense_to_slot[i] };
+      auto      &target{ m_slots[location] };
+      target.generation.set_dead_and_next_gen();
+      target.index = m_free_head;
+      m_free_head  = location;
     }
-    return false;
+    m_size = 0;
   }
 
   [[nodiscard]]
-  constexpr static auto get_size_for(usize const count) noexcept {
-    return count * sizeof(T) + count * sizeof(gen_counter);
+  constexpr auto contains(handle_type const handle) const noexcept -> bool {
+    return handle.location < m_capacity &&
+           m_slots[handle.location].generation == handle.generation &&
+           handle.generation.is_alive();
   }
 
+  /// @returns nullptr for stale handles
+  [[nodiscard]]
+  constexpr auto get(handle_type const handle) noexcept -> pointer {
+    return contains(handle) ? m_data + m_slots[handle.location].index
+                            : nullptr;
+  }
 
-private:
-  usize        count{};
-  usize        top{};
-  byte        *storage{ nullptr };
-  gen_counter *generations{ nullptr };
-  value_type  *data{ nullptr };
-};
+  [[nodiscard]]
+  constexpr auto get(handle_type const handle) const noexcept
+    -> const_pointer {
+    return contains(handle) ? m_data + m_slots[handle.location].index
+                            : nullptr;
+  }
 
-template<class T>
-class pool {
-  static constexpr bool T_nothrow_move{
-    std::is_nothrow_move_constructible_v<T>
-  };
+  /// Handle of the `index`-th element of the dense array
+  [[nodiscard]]
+  constexpr auto handle_at(size_type const index) const noexcept
+    -> handle_type {
+    gzn_assertion(index < m_size, "Index is out of range");
+    auto const location{ m_dense_to_slot[index] };
+    return {
+      .location   = location,
+      .generation = m_slots[location].generation,
+    };
+  }
 
-public:
-  using value_type  = T;
-  using handle_type = handle<T>;
-  using destructor  = void (*)(void *, void *, usize);
-
-  constexpr pool()  = default;
-
-  explicit pool(void *storage, usize const elements_count) noexcept
-    : count{ elements_count }
-    , storage{ storage }
-    , generations{ reinterpret_cast<gen_counter *>(storage) }
-    , data{ reinterpret_cast<T *>(storage) + count * sizeof(gen_counter) } {
-    gzn_assertion(count == 0, "pool should not be empty");
-    gzn_assertion(
-      !std::has_single_bit(elements_count),
-      "Pool size must be power of 2. In Release mode will be rounded to "
-      "closest lower power of 2"
-    );
-    std::fill_n(generations, count * sizeof(gen_counter), gen_counter{});
+  [[nodiscard]]
+  constexpr auto generation_at(u32 const location) const noexcept
+    -> generation_type {
+    gzn_assertion(location < m_capacity, "Index is out of range");
+    return m_slots[location].generation;
   }
 
-  template<fnd::util::allocator_type Alloc>
-  explicit pool(Alloc &alloc, usize const count)
-    : pool{ alloc.allocate(get_size_for(count)), count }
-    , alloc{ &alloc }
-    , destruct_storage{ make_destructor<Alloc, gen_counter>() } {}
+  [[nodiscard]]
+  constexpr auto values() noexcept -> std::span<value_type> {
+    return { m_data, m_size };
+  }
 
-  ~pool() { destruct_storage(alloc, storage, get_size_for(count)); }
+  [[nodiscard]]
+  constexpr auto values() const noexcept -> std::span<value_type const> {
+    return { m_data, m_size };
+  }
 
-  pool(pool const &)                         = delete;
-  pool(pool &&) noexcept                     = delete;
-  auto operator=(pool const &) -> pool &     = delete;
-  auto operator=(pool &&) noexcept -> pool & = delete;
+  [[nodiscard]]
+  constexpr auto begin() noexcept -> iterator {
+    return m_data;
+  }
 
   [[nodiscard]]
-  constexpr auto is_valid() const noexcept {
-    return storage != nullptr;
+  constexpr auto end() noexcept -> iterator {
+    return m_data + m_size;
   }
 
   [[nodiscard]]
-  constexpr auto elements_count() const noexcept {
-    return count;
+  constexpr auto begin() const noexcept -> const_iterator {
+    return m_data;
   }
 
   [[nodiscard]]
-  constexpr auto bytes_count() const noexcept {
-    return get_size_for(count);
+  constexpr auto end() const noexcept -> const_iterator {
+    return m_data + m_size;
   }
 
+  /// Bytes taken by a pool of `count` elements, a multiple of
+  /// @ref storage_alignment
   [[nodiscard]]
-  constexpr auto at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return handle_type{ .pool       = &self,
-                        .location   = index,
-                        .generation = self.generations[index] };
+  constexpr static auto get_size_for(usize const count) noexcept -> usize {
+    return align(slots_offset(count) + count * sizeof(slot));
   }
 
+private:
+  u32          m_capacity{};
+  u32          m_size{};
+  u32          m_free_head{};
+  value_type  *m_data{ nullptr };
+  u32         *m_dense_to_slot{ nullptr };
+  slot        *m_slots{ nullptr };
+
   [[nodiscard]]
-  constexpr auto value_at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return self.generations[index];
+  constexpr static auto align(usize const bytes_count) noexcept -> usize {
+    return (bytes_count + storage_alignment - 1) & ~(storage_alignment - 1);
   }
 
   [[nodiscard]]
-  constexpr auto generation_at(this auto &&self, usize const index) noexcept {
-    gzn_assertion(index > self.count, "Index is out of range");
-    return self.generations[index];
-  }
-
-  constexpr auto try_insert_unsafe(
-    value_type  value,
-    usize const index
-  ) noexcept(T_nothrow_move) -> bool {
-    gzn_assertion(index > count, "Index is out of range");
-    if (auto gen{ generations + index }; gen->is_alive()) {
-      std::construct_at(data + index, std::move(value));
-      gen->set_alive();
-      return true;
-    }
-    return false;
+  constexpr static auto dense_to_slot_offset(usize const count) noexcept
+    -> usize {
+    return count * sizeof(value_type);
   }
 
-  gzn_inline constexpr auto try_append(value_type value) noexcept(
-    T_nothrow_move
-  ) -> bool {
-    auto const status{ try_insert_unsafe(std::move(value), top) };
-    top += static_cast<usize>(status);
-    return status;
+  [[nodiscard]]
+  constexpr static auto slots_offset(usize const count) noexcept -> usize {
+    auto const offset{ dense_to_slot_offset(count) + count * sizeof(u32) };
+    return (offset + alignof(slot) - 1) & ~(alignof(slot) - 1);
   }
+};
 
-  constexpr auto remove_at(usize const index) -> bool {
-    gzn_assertion(index > count, "Index is out of range");
-    if (auto gen{ generations + index }; gen->is_alive()) {
-      if constexpr (!std::is_trivially_destructible_v<value_type>) {
-        std::destroy_at(data + index);
-      }
-      gen->set_dead_and_next_gen();
-      return true;
-    }
-    return false;
+/// @ref non_owning_pool allocating its own storage
+template<class T, class Generation = gen_counter>
+class pool : public non_owning_pool<T, Generation> {
+  using base_type = non_owning_pool<T, Generation>;
+
+public:
+  using typename base_type::value_type;
+  using typename base_type::handle_type;
+
+  explicit pool(any_allocator allocator, usize const count)
+    : base_type{ allocate_storage(allocator, count), count }
+    , m_allocator{ allocator } {}
+
+  ~pool() {
+    base_type::clear();
+    m_allocator.deallocate(
+      base_type::begin(),
+      static_cast<u32>(base_type::bytes_count()),
+      static_cast<u32>(base_type::storage_alignment)
+    );
   }
 
+  pool(pool const &)                         = delete;
+  pool(pool &&) noexcept                     = delete;
+  auto operator=(pool const &) -> pool &     = delete;
+  auto operator=(pool &&) noexcept -> pool & = delete;
+
   [[nodiscard]]
-  constexpr static auto get_size_for(usize const count) noexcept {
-    return count * sizeof(T) + count * sizeof(gen_counter);
+  constexpr auto get_allocator() const noexcept -> any_allocator {
+    return m_allocator;
   }
 
 private:
-  template<fnd::util::allocator_type Alloc, class U>
-  gzn_inline static auto make_destructor() noexcept -> destructor {
-    static auto fn{ [](void *a, void *d, usize sz) {
-      fnd::util::dealloc(&static_cast<Alloc *>(a), static_cast<U *>(d), sz);
-    } };
-    return fn;
-  }
-
-  usize        count{};
-  usize        top{};
-  void        *storage{ nullptr };
-  gen_counter *generations{ nullptr };
-  value_type  *data{ nullptr };
-  void        *alloc{ nullptr };
-  destructor   destruct_storage{ [](auto, auto, auto) {} };
-};
+  any_allocator m_allocator{};
 
-template<class T>
-constexpr auto handle<T>::is_actual() const noexcept -> bool {
-  return pool != nullptr && generation == pool->generation_at(location);
-}
-
-template<class T>
-constexpr auto handle<T>::value(this auto &&self) noexcept -> value_type * {
-  return self.is_actual() ? self.pool->value_at(self.location) : nullptr;
-}
+  [[nodiscard]]
+  static auto allocate_storage(any_allocator &allocator, usize const count)
+    -> byte * {
+    return static_cast<byte *>(allocator.allocate(
+      static_cast<u32>(base_type::get_size_for(count)),
+      static_cast<u32>(base_type::storage_alignment),
+      0
+    ));
+  }
+};
 
 } // namespace gzn::fnd
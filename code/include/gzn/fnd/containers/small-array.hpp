@@ -0,0 +1,647 @@
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+
+#include "gzn/fnd/containers/dynamic-array.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * @ref dynamic_array storing its first `InlineCapacity` elements inside the
+ * object. The allocator is touched only once the array outgrows the inline
+ * buffer, so short per-event and per-draw lists never allocate.
+ *
+ * Moving an inline array moves its elements one by one, pointers into it
+ * don't survive the move.
+ */
+template<
+  class T,
+  usize InlineCapacity,
+  util::allocator_type Allocator = base_allocator,
+  class Twicks                   = dynamic_array_twicks<T>>
+class small_array {
+  gzn_static_assert(InlineCapacity > 0, "Use dynamic_array instead");
+  gzn_static_assert(
+    Twicks::grow_factor >= constants::minimum_grow_factor,
+    "Grow factor should be more or equal to minimum_grow_factor{ 1 }"
+  );
+
+public:
+  using value_type        = T;
+  using pointer           = std::add_pointer_t<T>;
+  using const_pointer     = std::add_pointer_t<std::add_const_t<T>>;
+  using reference         = std::add_lvalue_reference_t<T>;
+  using const_reference   = std::add_lvalue_reference_t<std::add_const_t<T>>;
+
+  using iterator          = pointer;
+  using const_iterator    = const_pointer;
+  using size_type         = usize;
+
+  using allocator_type    = Allocator;
+  using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  size_type static constexpr inline_capacity{ InlineCapacity };
+
+  /// @ref allocation_flags passed with every storage allocation
+  u32 static constexpr allocation_flags{ [] {
+    if constexpr (requires { Twicks::allocation_flags; }) {
+      return static_cast<u32>(Twicks::allocation_flags);
+    } else {
+      return fnd::allocation_flags::none;
+    }
+  }() };
+
+  /// Takes the allocator of the current @ref allocator_context
+  small_array() noexcept
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {}
+
+  explicit small_array(size_type const reserve_size)
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {
+    reserve(reserve_size);
+  }
+
+  explicit small_array(
+    allocator_type &allocator,
+    size_type const reserve_size = 0
+  )
+    : m_allocator{ storage_of(allocator) } {
+    reserve(reserve_size);
+  }
+
+  explicit small_array(
+    allocator_type              &allocator,
+    util::range_type auto const &range
+  )
+    : m_allocator{ storage_of(allocator) } {
+    reserve(static_cast<size_type>(util::size(range)));
+    m_size = static_cast<size_type>(
+      std::uninitialized_copy(std::begin(range), std::end(range), m_data) -
+      m_data
+    );
+  }
+
+  explicit small_array(
+    allocator_type         &allocator,
+    util::range_type auto &&range
+  )
+    : m_allocator{ storage_of(allocator) } {
+    reserve(static_cast<size_type>(util::size(range)));
+    m_size = static_cast<size_type>(
+      std::uninitialized_move(std::begin(range), std::end(range), m_data) -
+      m_data
+    );
+  }
+
+  template<size_type Length>
+  explicit small_array(allocator_type &allocator, c_array<T, Length> &&values)
+    : m_allocator{ storage_of(allocator) } {
+    reserve(Length);
+    std::uninitialized_move(values, values + Length, m_data);
+    m_size = Length;
+  }
+
+  small_array(small_array const &other)
+    : m_allocator{ other.m_allocator } {
+    reserve(other.m_size);
+    std::uninitialized_copy(std::begin(other), std::end(other), m_data);
+    m_size = other.m_size;
+  }
+
+  small_array(small_array &&other) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>
+  )
+    : m_allocator{ other.m_allocator } {
+    steal(other);
+  }
+
+  ~small_array() { reset(); }
+
+  auto operator=(small_array const &other) -> small_array & {
+    if (&other != this) {
+      clear();
+      reserve(other.m_size);
+      std::uninitialized_copy(std::begin(other), std::end(other), m_data);
+      m_size = other.m_size;
+    }
+    return *this;
+  }
+
+  auto operator=(small_array &&other) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>
+  ) -> small_array & {
+    if (&other != this) {
+      reset();
+      m_allocator = other.m_allocator;
+      steal(other);
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_t const index) -> reference {
+    gzn_assertion(index < m_size, "Index out of range!");
+    return m_data[index];
+  }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_t const index) const -> const_reference {
+    gzn_assertion(index < m_size, "Index out of range!");
+    return m_data[index];
+  }
+
+  [[nodiscard]]
+  constexpr auto at(size_t const index) noexcept -> pointer {
+    return index < m_size ? m_data + index : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto at(size_t const index) const noexcept -> const_pointer {
+    return index < m_size ? m_data + index : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto front() noexcept -> pointer {
+    return m_size != 0 ? m_data : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto front() const noexcept -> const_pointer {
+    return m_size != 0 ? m_data : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto back() noexcept -> pointer {
+    return m_size != 0 ? m_data + m_size - 1 : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto back() const noexcept -> const_pointer {
+    return m_size != 0 ? m_data + m_size - 1 : nullptr;
+  }
+
+  auto push_back(value_type const &value) -> reference {
+    return emplace_back(value);
+  }
+
+  auto push_back(value_type &&value) -> reference {
+    return emplace_back(std::move(value));
+  }
+
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto emplace_back(Args &&...args) -> reference {
+    if (m_capacity <= m_size) [[unlikely]] {
+      return grow_and_emplace_back(std::forward<Args>(args)...);
+    }
+    auto raw{
+      new (m_data + m_size) value_type{ std::forward<Args>(args)... }
+    };
+    ++m_size;
+    return *raw;
+  }
+
+  void pop_back() noexcept(std::is_nothrow_destructible_v<value_type>) {
+    gzn_assertion(m_size != 0, "pop_back called with empty array");
+    if (m_size != 0) {
+      --m_size;
+      std::destroy_at(m_data + m_size);
+    }
+  }
+
+  void fast_erase(iterator pos) {
+    gzn_assertion(m_size != 0, "erase called with empty array");
+    gzn_assertion(begin() <= pos, "'from' is out of range");
+    gzn_assertion(end() > pos, "'to' is out of range");
+
+    if (pos != back()) { *pos = std::move(*back()); }
+    pop_back();
+  }
+
+  auto erase(iterator pos) -> iterator {
+    gzn_assertion(begin() <= pos, "'from' is out of range");
+    gzn_assertion(end() > pos, "'to' is out of range");
+    if (empty()) [[unlikely]] { return end(); }
+
+    auto const last{ containers::algo::shift_erase(*this, pos, pos + 1) };
+    m_size = static_cast<size_type>(last - m_data);
+    return pos;
+  }
+
+  /// Inserts `[from, to)` before `pos` with at most one reallocation, the
+  /// source must not be this array
+  /// @returns nullptr when the storage can't grow
+  template<util::iterator_type Iterator>
+  auto insert(iterator pos, Iterator from, Iterator to) -> iterator {
+    auto const count{ static_cast<size_type>(std::distance(from, to)) };
+    if (count == 0) [[unlikely]] { return pos; }
+
+    auto const gap{ open_gap(pos, count) };
+    if (gap == nullptr) [[unlikely]] { return nullptr; }
+    containers::mem::construct_copy(from, to, gap);
+    return gap;
+  }
+
+  /// Appends a copy of `range`
+  /// @returns the first appended element, nullptr when the storage can't
+  /// grow
+  auto append_range(util::range_type auto const &range) -> iterator {
+    auto const first{ util::data(range) };
+    return insert(end(), first, first + util::size(range));
+  }
+
+  /// Appends `count` elements constructed from `args`, which must not
+  /// refer to elements of this array
+  /// @returns the first appended element, nullptr when the storage can't
+  /// grow
+  template<class... Args>
+    requires std::constructible_from<value_type, Args const &...>
+  auto emplace_back_n(size_type const count, Args const &...args)
+    -> iterator {
+    if (count == 0) [[unlikely]] { return end(); }
+
+    auto const first{ open_gap(end(), count) };
+    if (first == nullptr) [[unlikely]] { return nullptr; }
+    for (auto cur{ first }; cur != end(); ++cur) {
+      new (cur) value_type{ args... };
+    }
+    return first;
+  }
+
+  /// Replaces the content with a copy of `range`, which may be a part of
+  /// this array: the copy is then built in a separate array
+  void assign(util::range_type auto const &range) {
+    auto const first{ util::data(range) };
+    auto const count{ util::size<decltype(range), size_type>(range) };
+
+    if (is_element(first)) {
+      *this = small_array{ get_allocator(), range };
+      return;
+    }
+
+    clear();
+    reserve(count);
+    if (m_capacity < count) [[unlikely]] { return; }
+
+    containers::mem::construct_copy(first, first + count, m_data);
+    m_size = count;
+  }
+
+  /// Replaces the content with `count` copies of `value`, a copy: it may be
+  /// an element of this array
+  void assign(size_type const count, value_type const value) {
+    clear();
+    reserve(count);
+    if (m_capacity < count) [[unlikely]] { return; }
+
+    std::uninitialized_fill_n(m_data, count, value);
+    m_size = count;
+  }
+
+  /// Destroys the elements and keeps the storage
+  void clear() {
+    std::destroy(begin(), end());
+    m_size = 0;
+  }
+
+  /// Destroys the elements and returns to the inline buffer
+  void reset() {
+    clear();
+    if (!is_inline()) {
+      get_allocator().deallocate(
+        m_data, m_capacity * sizeof(value_type), alignof(value_type)
+      );
+      m_data     = inline_data();
+      m_capacity = inline_capacity;
+    }
+  }
+
+  void reserve(size_type const count) {
+    if (m_capacity >= count) [[likely]] { return; }
+
+    if (!is_inline() && try_resize_in_place(count)) { return; }
+
+    auto const raw{ containers::mem::allocate<value_type>(
+      get_allocator(), count, allocation_flags
+    ) };
+    gzn_assertion(raw != nullptr, "Failed to allocate small_array storage");
+    if (raw == nullptr) [[unlikely]] { return; }
+
+    relocate(raw);
+    m_capacity = count;
+  }
+
+  /// `default_value` is a copy: it may be an element moved by the growth
+  void resize(size_type const count, value_type const default_value = {}) {
+    if (m_size < count) {
+      reserve(count);
+      if (m_capacity < count) [[unlikely]] { return; }
+      std::uninitialized_fill(m_data + m_size, m_data + count, default_value);
+    } else {
+      std::destroy(m_data + count, end());
+    }
+    m_size = count;
+  }
+
+  /// Grows without constructing the new elements, for buffers filled right
+  /// after, e.g. by a read call
+  void resize_uninitialized(size_type const count)
+    requires std::is_trivially_copyable_v<value_type>
+  {
+    reserve(count);
+    if (m_capacity < count) [[unlikely]] { return; }
+    m_size = count;
+  }
+
+  /// Moves the elements back inline when they fit
+  auto shrink_to_fit() -> size_type {
+    if (is_inline() || m_size == m_capacity) [[unlikely]] { return 0; }
+
+    if (m_size <= inline_capacity) {
+      relocate(inline_data());
+      m_capacity = inline_capacity;
+      return m_size;
+    }
+
+    if (try_resize_in_place(m_size)) { return m_size; }
+
+    auto const raw{ containers::mem::allocate<value_type>(
+      get_allocator(), m_size, allocation_flags
+    ) };
+    if (raw == nullptr) [[unlikely]] { return 0; }
+
+    relocate(raw);
+    m_capacity = m_size;
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto is_inline() const noexcept -> bool {
+    return m_data == inline_data();
+  }
+
+  [[nodiscard]]
+  constexpr auto data() noexcept -> pointer {
+    return m_data;
+  }
+
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> const_pointer {
+    return m_data;
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_capacity;
+  }
+
+  [[nodiscard]]
+  constexpr auto grow_factor() const noexcept -> size_type {
+    return Twicks::grow_factor;
+  }
+
+  [[nodiscard]]
+  constexpr auto size_in_bytes() const noexcept -> size_type {
+    return m_size * sizeof(value_type);
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity_in_bytes() const noexcept -> size_type {
+    return m_capacity * sizeof(value_type);
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return m_size == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_grown_capacity(size_type const capacity) const noexcept
+    -> size_type {
+    return 1 + capacity * grow_factor();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() noexcept -> iterator {
+    return m_data;
+  }
+
+  [[nodiscard]]
+  constexpr auto end() noexcept -> iterator {
+    return m_data + m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> const_iterator {
+    return m_data;
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept -> const_iterator {
+    return m_data + m_size;
+  }
+
+private:
+  allocator_storage m_allocator{};
+  size_type         m_capacity{ inline_capacity };
+  size_type         m_size{};
+  pointer           m_data{ inline_data() };
+  alignas(value_type) byte m_inline[inline_capacity * sizeof(value_type)];
+
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto inline_data() noexcept -> pointer {
+    return reinterpret_cast<pointer>(m_inline);
+  }
+
+  [[nodiscard]]
+  constexpr auto inline_data() const noexcept -> const_pointer {
+    return reinterpret_cast<const_pointer>(m_inline);
+  }
+
+  /// `args` may refer to an element. An in-place resize may free the old
+  /// block, so the value is built first; otherwise it is constructed in the
+  /// new storage before the old one goes away.
+  template<class... Args>
+  auto grow_and_emplace_back(Args &&...args) -> reference {
+    auto const capacity{ get_grown_capacity(m_capacity) };
+    if (!is_inline()) {
+      value_type value{ std::forward<Args>(args)... };
+      if (try_resize_in_place(capacity)) {
+        return *std::construct_at(m_data + m_size++, std::move(value));
+      }
+      return relocate_and_emplace_back(capacity, std::move(value));
+    }
+    return relocate_and_emplace_back(capacity, std::forward<Args>(args)...);
+  }
+
+  /// There is no element to return when the storage can't grow, so that
+  /// aborts like a failed `new` would
+  template<class... Args>
+  auto relocate_and_emplace_back(size_type const capacity, Args &&...args)
+    -> reference {
+    auto const raw{ containers::mem::allocate<value_type>(
+      get_allocator(), capacity, allocation_flags
+    ) };
+    gzn_assertion(raw != nullptr, "Failed to allocate small_array storage");
+    if (raw == nullptr) [[unlikely]] { std::abort(); }
+
+    auto &value{
+      *new (raw + m_size) value_type{ std::forward<Args>(args)... }
+    };
+    relocate(raw);
+    m_capacity = capacity;
+    ++m_size;
+    return value;
+  }
+
+  [[nodiscard]]
+  auto is_element(const_pointer const ptr) const noexcept -> bool {
+    return std::less_equal<const_pointer>{}(begin(), ptr) &&
+           std::less<const_pointer>{}(ptr, end());
+  }
+
+  /// Makes room for `count` elements before `pos`
+  /// @returns the first element of the gap, it is raw memory, or nullptr
+  /// when the storage can't grow
+  [[nodiscard]]
+  auto open_gap(iterator pos, size_type const count) -> iterator {
+    gzn_assertion(begin() <= pos && pos <= end(), "'pos' is out of range");
+
+    auto const index{ static_cast<size_type>(pos - m_data) };
+    if (m_capacity < m_size + count) [[unlikely]] {
+      auto const capacity{
+        std::max(get_grown_capacity(m_capacity), m_size + count)
+      };
+      if (is_inline() || !try_resize_in_place(capacity)) {
+        auto const raw{ containers::mem::allocate<value_type>(
+          get_allocator(), capacity, allocation_flags
+        ) };
+        gzn_assertion(
+          raw != nullptr, "Failed to allocate small_array storage"
+        );
+        if (raw == nullptr) [[unlikely]] { return nullptr; }
+
+        containers::mem::relocate(begin(), begin() + index, raw);
+        containers::mem::relocate(
+          begin() + index, end(), raw + index + count
+        );
+        if (!is_inline()) {
+          get_allocator().deallocate(
+            m_data, m_capacity * sizeof(value_type), alignof(value_type)
+          );
+        }
+        m_data     = raw;
+        m_capacity = capacity;
+        m_size    += count;
+        return m_data + index;
+      }
+    }
+
+    auto const gap{ containers::algo::shift(*this, m_data + index, count) };
+    m_size += count;
+    return gap;
+  }
+
+  /// Moves the elements into `target` and releases the old heap block
+  void relocate(pointer const target) {
+    containers::mem::relocate(begin(), end(), target);
+
+    if (!is_inline()) {
+      get_allocator().deallocate(
+        m_data, m_capacity * sizeof(value_type), alignof(value_type)
+      );
+    }
+    m_data = target;
+  }
+
+  /// Takes the heap block of `other`, or moves its inline elements over
+  void steal(small_array &other) {
+    if (other.is_inline()) {
+      containers::mem::relocate(other.begin(), other.end(), m_data);
+      m_size = std::exchange(other.m_size, size_type{});
+      return;
+    }
+
+    m_data     = std::exchange(other.m_data, other.inline_data());
+    m_capacity = std::exchange(other.m_capacity, inline_capacity);
+    m_size     = std::exchange(other.m_size, size_type{});
+  }
+
+  [[nodiscard]]
+  auto try_resize_in_place(size_type const count) -> bool {
+    // Neither path knows the flags: a reallocated block loses its huge page
+    // alignment and NUMA node, an expanded tail isn't zeroed
+    if constexpr (allocation_flags != fnd::allocation_flags::none) {
+      return false;
+    }
+
+    [[maybe_unused]] auto const bytes_count{
+      static_cast<u32>(m_capacity * sizeof(value_type))
+    };
+    [[maybe_unused]] auto const new_bytes_count{
+      static_cast<u32>(count * sizeof(value_type))
+    };
+
+    if constexpr (util::expandable_allocator_type<allocator_type>) {
+      if (get_allocator().try_expand(m_data, bytes_count, new_bytes_count)) {
+        m_capacity = count;
+        return true;
+      }
+    }
+
+    if constexpr (util::reallocatable_allocator_type<allocator_type> &&
+                  util::trivially_relocatable_type<value_type>) {
+      if (auto raw{ get_allocator().reallocate(
+            m_data, bytes_count, new_bytes_count, alignof(value_type)
+          ) };
+          raw) {
+        m_data     = static_cast<pointer>(raw);
+        m_capacity = count;
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+} // namespace gzn::fnd
@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+#include "gzn/fnd/containers/dynamic-array.hpp"
+
+namespace gzn::fnd {
+
+namespace constants {
+
+/// Cache line, also enough for any SIMD load/store of a column
+u32 static constexpr soa_column_alignment{ 64 };
+
+} // namespace constants
+
+struct soa_array_twicks {
+  u64 static constexpr grow_factor{ constants::default_grow_factor };
+  u32 static constexpr allocation_flags{ allocation_flags::none };
+  u32 static constexpr column_alignment{ constants::soa_column_alignment };
+};
+
+/**
+ * Structure-of-arrays counterpart of @ref dynamic_array: element `i` is the
+ * `i`-th entry of every column, each column is a contiguous and aligned
+ * array of one field. All columns live in one allocation and grow in
+ * lockstep, hot loops walk only the columns they need through `column<I>()`.
+ */
+template<util::allocator_type Allocator, class Twicks, class... Ts>
+class basic_soa_array {
+  gzn_static_assert(sizeof...(Ts) > 0, "soa_array needs at least one column");
+  gzn_static_assert(
+    Twicks::grow_factor >= constants::minimum_grow_factor,
+    "Grow factor should be more or equal to minimum_grow_factor{ 1 }"
+  );
+  gzn_static_assert(
+    std::has_single_bit(Twicks::column_alignment),
+    "Column alignment should be a power of two"
+  );
+
+public:
+  using value_type        = std::tuple<Ts...>;
+  using reference         = std::tuple<Ts &...>;
+  using const_reference   = std::tuple<Ts const &...>;
+  using size_type         = usize;
+
+  using allocator_type    = Allocator;
+  using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  template<usize Index>
+  using column_type = std::tuple_element_t<Index, value_type>;
+
+  size_type static constexpr columns_count{ sizeof...(Ts) };
+
+  /// @ref allocation_flags passed with every storage allocation
+  u32 static constexpr allocation_flags{ [] {
+    if constexpr (requires { Twicks::allocation_flags; }) {
+      return static_cast<u32>(Twicks::allocation_flags);
+    } else {
+      return fnd::allocation_flags::none;
+    }
+  }() };
+
+  /// Takes the allocator of the current @ref allocator_context
+  basic_soa_array() noexcept
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {}
+
+  explicit basic_soa_array(size_type const reserve_size)
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() } {
+    reserve(reserve_size);
+  }
+
+  explicit basic_soa_array(
+    allocator_type &allocator,
+    size_type const reserve_size = 0
+  )
+    : m_allocator{ storage_of(allocator) } {
+    reserve(reserve_size);
+  }
+
+  basic_soa_array(basic_soa_array const &other)
+    : m_allocator{ other.m_allocator } {
+    copy_from(other);
+  }
+
+  basic_soa_array(basic_soa_array &&other) noexcept
+    : m_allocator{ other.m_allocator }
+    , m_capacity{ std::exchange(other.m_capacity, size_type{}) }
+    , m_size{ std::exchange(other.m_size, size_type{}) }
+    , m_columns{ std::exchange(other.m_columns, {}) } {}
+
+  ~basic_soa_array() { reset(); }
+
+  auto operator=(basic_soa_array const &other) -> basic_soa_array & {
+    if (&other != this) {
+      reset();
+      m_allocator = other.m_allocator;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  auto operator=(basic_soa_array &&other) noexcept -> basic_soa_array & {
+    if (&other != this) {
+      reset();
+      m_allocator = other.m_allocator;
+      m_capacity  = std::exchange(other.m_capacity, size_type{});
+      m_size      = std::exchange(other.m_size, size_type{});
+      m_columns   = std::exchange(other.m_columns, {});
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type const index) -> reference {
+    gzn_assertion(index < m_size, "Index out of range!");
+    return std::apply(
+      [index](Ts *...columns) { return reference{ columns[index]... }; },
+      m_columns
+    );
+  }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type const index) const -> const_reference {
+    gzn_assertion(index < m_size, "Index out of range!");
+    return std::apply(
+      [index](Ts *...columns) { return const_reference{ columns[index]... }; },
+      m_columns
+    );
+  }
+
+  /// Contiguous view of the `Index`-th field of every element
+  template<usize Index>
+  [[nodiscard]]
+  constexpr auto column() noexcept -> std::span<column_type<Index>> {
+    return { std::get<Index>(m_columns), m_size };
+  }
+
+  template<usize Index>
+  [[nodiscard]]
+  constexpr auto column() const noexcept
+    -> std::span<column_type<Index> const> {
+    return { std::get<Index>(m_columns), m_size };
+  }
+
+  /// Takes one argument per column
+  template<class... Args>
+    requires(sizeof...(Args) == columns_count &&
+             (std::constructible_from<Ts, Args &&> && ...))
+  auto emplace_back(Args &&...args) -> reference {
+    if (m_capacity <= m_size) [[unlikely]] {
+      // `args` may refer to elements which are about to move
+      value_type values{ std::forward<Args>(args)... };
+      grow();
+      construct_back(std::move(values));
+    } else {
+      construct_back(std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return (*this)[m_size++];
+  }
+
+  auto push_back(Ts const &...values) -> reference {
+    return emplace_back(values...);
+  }
+
+  void pop_back() noexcept((std::is_nothrow_destructible_v<Ts> && ...)) {
+    gzn_assertion(m_size != 0, "pop_back called with empty array");
+    if (m_size != 0) {
+      --m_size;
+      std::apply(
+        [this](Ts *...columns) { (std::destroy_at(columns + m_size), ...); },
+        m_columns
+      );
+    }
+  }
+
+  /// Erases element `index` of every column by moving the last element into
+  /// its place, the order of elements isn't kept
+  void swap_erase(size_type const index) {
+    gzn_assertion(index < m_size, "Index out of range!");
+
+    std::apply(
+      [this, index](Ts *...columns) {
+        (swap_erase_column(columns, index), ...);
+      },
+      m_columns
+    );
+    --m_size;
+  }
+
+  /// Destroys the elements and keeps the storage
+  void clear() {
+    std::apply(
+      [this](Ts *...columns) { (std::destroy_n(columns, m_size), ...); },
+      m_columns
+    );
+    m_size = 0;
+  }
+
+  void reset() {
+    if (m_capacity == 0) { return; }
+
+    clear();
+    deallocate_columns(m_columns, m_capacity);
+    m_capacity = 0;
+    m_columns  = {};
+  }
+
+  void reserve(size_type const count) {
+    if (m_capacity >= count) [[unlikely]] { return; }
+
+    relocate_to(count);
+  }
+
+  /// Value-initialises the new elements
+  void resize(size_type const count) {
+    if (m_size < count) [[likely]] {
+      reserve(count);
+      std::apply(
+        [this, count](Ts *...columns) {
+          (std::uninitialized_value_construct(
+             columns + m_size, columns + count
+           ),
+           ...);
+        },
+        m_columns
+      );
+    } else {
+      std::apply(
+        [this, count](Ts *...columns) {
+          (std::destroy(columns + count, columns + m_size), ...);
+        },
+        m_columns
+      );
+    }
+    m_size = count;
+  }
+
+  auto shrink_to_fit() -> size_type {
+    if (m_size == m_capacity || m_capacity == 0) [[unlikely]] { return 0; }
+
+    relocate_to(m_size);
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_capacity;
+  }
+
+  [[nodiscard]]
+  constexpr auto grow_factor() const noexcept -> size_type {
+    return Twicks::grow_factor;
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return m_size == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_grown_capacity(size_type const capacity) const noexcept
+    -> size_type {
+    return 1 + capacity * grow_factor();
+  }
+
+private:
+  using columns_storage = std::tuple<Ts *...>;
+
+  u32 static constexpr block_alignment{
+    std::max({ Twicks::column_alignment, static_cast<u32>(alignof(Ts))... })
+  };
+
+  allocator_storage m_allocator{};
+  size_type         m_capacity{};
+  size_type         m_size{};
+  columns_storage   m_columns{};
+
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
+  /// Offsets of the columns inside a block of `capacity` elements, the last
+  /// entry is the block size
+  [[nodiscard]]
+  static constexpr auto layout_of(size_type const capacity) noexcept
+    -> std::array<u32, columns_count + 1> {
+    std::array<u32, columns_count + 1> offsets{};
+    u32                                offset{};
+    usize                              index{};
+    ((offsets[index++] = offset,
+      offset           = util::memory_align(
+        offset + static_cast<u32>(capacity * sizeof(Ts)), block_alignment
+      )),
+     ...);
+    offsets[columns_count] = offset;
+    return offsets;
+  }
+
+  [[nodiscard]]
+  auto allocate_columns(size_type const capacity) -> columns_storage {
+    if (capacity == 0) { return {}; }
+
+    auto const offsets{ layout_of(capacity) };
+    auto const raw{ static_cast<byte *>(get_allocator().allocate(
+      offsets[columns_count], block_alignment, 0, allocation_flags
+    )) };
+    if (raw == nullptr) { return {}; }
+
+    return [&]<usize... Indices>(std::index_sequence<Indices...>) {
+      return columns_storage{ reinterpret_cast<Ts *>(raw + offsets[Indices])...
+      };
+    }(std::index_sequence_for<Ts...>{});
+  }
+
+  void deallocate_columns(
+    columns_storage const &columns,
+    size_type const        capacity
+  ) {
+    get_allocator().deallocate(
+      std::get<0>(columns), layout_of(capacity)[columns_count], block_alignment
+    );
+  }
+
+  void grow() { reserve(get_grown_capacity(m_capacity)); }
+
+  /// Moves every column into a new block of `count` elements
+  void relocate_to(size_type const count) {
+    auto const columns{ allocate_columns(count) };
+    if (m_capacity != 0) {
+      [&]<usize... Indices>(std::index_sequence<Indices...>) {
+        (containers::mem::relocate(
+           std::get<Indices>(m_columns),
+           std::get<Indices>(m_columns) + m_size,
+           std::get<Indices>(columns)
+         ),
+         ...);
+      }(std::index_sequence_for<Ts...>{});
+      deallocate_columns(m_columns, m_capacity);
+    }
+    m_columns  = columns;
+    m_capacity = count;
+  }
+
+  template<class Tuple>
+  void construct_back(Tuple &&values) {
+    [&]<usize... Indices>(std::index_sequence<Indices...>) {
+      (std::construct_at(
+         std::get<Indices>(m_columns) + m_size,
+         std::get<Indices>(std::forward<Tuple>(values))
+       ),
+       ...);
+    }(std::index_sequence_for<Ts...>{});
+  }
+
+  template<class T>
+  void swap_erase_column(T *column, size_type const index) {
+    std::ranges::subrange elements{ column, column + m_size };
+    std::destroy_at(containers::algo::swap_erase(elements, column + index));
+  }
+
+  void copy_from(basic_soa_array const &other) {
+    reserve(other.m_size);
+    [&]<usize... Indices>(std::index_sequence<Indices...>) {
+      (containers::mem::construct_copy(
+         std::get<Indices>(other.m_columns),
+         std::get<Indices>(other.m_columns) + other.m_size,
+         std::get<Indices>(m_columns)
+       ),
+       ...);
+    }(std::index_sequence_for<Ts...>{});
+    m_size = other.m_size;
+  }
+};
+
+template<class... Ts>
+using soa_array = basic_soa_array<base_allocator, soa_array_twicks, Ts...>;
+
+} // namespace gzn::fnd
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+#include "gzn/fnd/allocators/context.hpp"
+#include "gzn/fnd/containers/common.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * Fixed-capacity ring for one producer and one consumer thread, e.g. event
+ * batches from the window thread. Head and tail sit on their own cache
+ * lines and each side keeps a cached copy of the other's index, so a
+ * transfer usually touches the shared lines only once per batch.
+ *
+ * The capacity is rounded up to a power of 2.
+ */
+template<class T, util::allocator_type Allocator = base_allocator>
+class spsc_ring {
+public:
+  using value_type        = T;
+  using pointer           = std::add_pointer_t<T>;
+  using size_type         = usize;
+
+  using allocator_type    = Allocator;
+  using allocator_pointer = std::add_pointer_t<Allocator>;
+  using allocator_storage = std::conditional_t<
+    util::allocator_reference_type<Allocator>,
+    Allocator,
+    allocator_pointer>;
+
+  /// Takes the allocator of the current @ref allocator_context
+  explicit spsc_ring(size_type const capacity)
+    requires std::same_as<allocator_type, any_allocator>
+    : m_allocator{ allocator_context::current() }
+    , m_mask{ mask_for(capacity) }
+    , m_data{ allocate_slots() } {}
+
+  explicit spsc_ring(allocator_type &allocator, size_type const capacity)
+    : m_allocator{ storage_of(allocator) }
+    , m_mask{ mask_for(capacity) }
+    , m_data{ allocate_slots() } {}
+
+  spsc_ring(spsc_ring const &) = delete;
+  spsc_ring(spsc_ring &&)      = delete;
+
+  ~spsc_ring() {
+    auto const head{ m_consumer.head.load(std::memory_order_relaxed) };
+    auto const tail{ m_producer.tail.load(std::memory_order_relaxed) };
+    for (auto i{ head }; i != tail; ++i) { std::destroy_at(slot(i)); }
+    get_allocator().deallocate(
+      m_data, static_cast<u32>(capacity() * sizeof(T)), alignof(T)
+    );
+  }
+
+  auto operator=(spsc_ring const &) -> spsc_ring & = delete;
+  auto operator=(spsc_ring &&) -> spsc_ring &      = delete;
+
+  // ------------------------------ producer ------------------------------ //
+
+  template<class... Args>
+    requires std::constructible_from<value_type, Args &&...>
+  auto try_emplace(Args &&...args) -> bool {
+    auto const tail{ m_producer.tail.load(std::memory_order_relaxed) };
+    if (free_count(tail) == 0) [[unlikely]] { return false; }
+
+    std::construct_at(slot(tail), std::forward<Args>(args)...);
+    m_producer.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  auto try_push(value_type const &value) -> bool { return try_emplace(value); }
+
+  auto try_push(value_type &&value) -> bool {
+    return try_emplace(std::move(value));
+  }
+
+  /// Copies as many of `[from, from + count)` as fit and publishes them at
+  /// once
+  /// @returns the number of pushed elements
+  auto push_n(value_type const *from, size_type const count) -> size_type {
+    auto const tail{ m_producer.tail.load(std::memory_order_relaxed) };
+    auto const pushed{ std::min(count, free_count(tail, count)) };
+    if (pushed == 0) { return 0; }
+
+    copy_in(from, tail, pushed);
+    m_producer.tail.store(tail + pushed, std::memory_order_release);
+    return pushed;
+  }
+
+  // ------------------------------ consumer ------------------------------ //
+
+  auto try_pop(value_type &out) -> bool {
+    auto const head{ m_consumer.head.load(std::memory_order_relaxed) };
+    if (ready_count(head) == 0) [[unlikely]] { return false; }
+
+    auto const source{ slot(head) };
+    out = std::move(*source);
+    std::destroy_at(source);
+    m_consumer.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves up to `count` elements to `to` and releases their slots at once
+  /// @returns the number of popped elements
+  auto pop_n(value_type *to, size_type const count) -> size_type {
+    auto const head{ m_consumer.head.load(std::memory_order_relaxed) };
+    auto const popped{ std::min(count, ready_count(head, count)) };
+    if (popped == 0) { return 0; }
+
+    move_out(to, head, popped);
+    m_consumer.head.store(head + popped, std::memory_order_release);
+    return popped;
+  }
+
+  // -------------------------------- both -------------------------------- //
+
+  /// Approximate while the other side is running
+  [[nodiscard]]
+  auto size() const noexcept -> size_type {
+    return m_producer.tail.load(std::memory_order_acquire) -
+           m_consumer.head.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return size() == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto capacity() const noexcept -> size_type {
+    return m_mask + 1;
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() noexcept -> allocator_type & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto get_allocator() const noexcept -> allocator_type const & {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return m_allocator;
+    } else {
+      return *m_allocator;
+    }
+  }
+
+private:
+  /// Written by the producer, `cached_head` is its stale view of the head
+  struct alignas(constants::cache_line_bytes) producer_side {
+    std::atomic<size_type> tail{};
+    size_type              cached_head{};
+  };
+
+  /// Written by the consumer, `cached_tail` is its stale view of the tail
+  struct alignas(constants::cache_line_bytes) consumer_side {
+    std::atomic<size_type> head{};
+    size_type              cached_tail{};
+  };
+
+  allocator_storage m_allocator{};
+  size_type         m_mask{};
+  pointer           m_data{ nullptr };
+  producer_side     m_producer{};
+  consumer_side     m_consumer{};
+
+  [[nodiscard]]
+  static constexpr auto mask_for(size_type const capacity) noexcept
+    -> size_type {
+    return std::bit_ceil(std::max(capacity, size_type{ 2 })) - 1;
+  }
+
+  [[nodiscard]]
+  auto allocate_slots() -> pointer {
+    auto const data{ containers::mem::allocate<value_type>(
+      get_allocator(), static_cast<u32>(capacity())
+    ) };
+    gzn_assertion(data != nullptr, "Failed to allocate the ring");
+    return data;
+  }
+
+  [[nodiscard]]
+  static constexpr auto storage_of(allocator_type &allocator) noexcept
+    -> allocator_storage {
+    if constexpr (util::allocator_reference_type<allocator_type>) {
+      return allocator;
+    } else {
+      return &allocator;
+    }
+  }
+
+  [[nodiscard]]
+  gzn_inline auto slot(size_type const index) const noexcept -> pointer {
+    return m_data + (index & m_mask);
+  }
+
+  /// Producer side, reloads the head only when the cached one doesn't leave
+  /// room for `wanted` elements
+  [[nodiscard]]
+  gzn_inline auto free_count(
+    size_type const tail,
+    size_type const wanted = 1
+  ) noexcept -> size_type {
+    if (auto const count{ capacity() - (tail - m_producer.cached_head) };
+        count >= wanted) [[likely]] {
+      return count;
+    }
+    m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+    return capacity() - (tail - m_producer.cached_head);
+  }
+
+  /// Consumer side, reloads the tail only when the cached one doesn't have
+  /// `wanted` elements ready
+  [[nodiscard]]
+  gzn_inline auto ready_count(
+    size_type const head,
+    size_type const wanted = 1
+  ) noexcept -> size_type {
+    if (auto const count{ m_consumer.cached_tail - head }; count >= wanted)
+      [[likely]] {
+      return count;
+    }
+    m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+    return m_consumer.cached_tail - head;
+  }
+
+  /// Copies `count` elements into the slots from `tail`, in at most two
+  /// contiguous runs
+  void copy_in(
+    value_type const *from,
+    size_type const   tail,
+    size_type const   count
+  ) {
+    auto const first{ tail & m_mask };
+    auto const run{ std::min(count, capacity() - first) };
+    containers::mem::construct_copy(from, from + run, m_data + first);
+    containers::mem::construct_copy(from + run, from + count, m_data);
+  }
+
+  void move_out(value_type *to, size_type const head, size_type const count) {
+    auto const first{ head & m_mask };
+    auto const run{ std::min(count, capacity() - first) };
+    move_out_run(m_data + first, run, to);
+    move_out_run(m_data, count - run, to + run);
+  }
+
+  static void move_out_run(pointer from, size_type const count, pointer to) {
+    std::move(from, from + count, to);
+    std::destroy_n(from, count);
+  }
+};
+
+} // namespace gzn::fnd
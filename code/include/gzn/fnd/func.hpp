@@ -11,24 +11,35 @@
 
 namespace gzn::fnd {
 
+/// Default inline capacity: functors up to it (and nothrow movable) never
+/// touch the allocator. Pass a bigger `BytesCount` to the func templates for
+/// fat captures, it can't be less than this. Bigger functors go to the
+/// allocator passed to the constructor, kept by pointer: it has to outlive
+/// the func, the @ref allocator_context is not consulted.
 inline constexpr usize FUNC_STORAGE_BYTES_COUNT{
   func_internal::MINIMUM_STORAGE_BYTES_COUNT
 };
 
-template<class...>
+template<class Signature, usize BytesCount = FUNC_STORAGE_BYTES_COUNT>
 class copyable_func;
 
-template<class...>
+template<class Signature, usize BytesCount = FUNC_STORAGE_BYTES_COUNT>
 class move_only_func;
 
+template<class Signature, usize BytesCount = FUNC_STORAGE_BYTES_COUNT>
+class inplace_func;
+
+template<class Signature>
+class function_ref;
+
 namespace func_internal {
 
 template<class...>
 struct is_move_only_function_specialization : std::false_type {};
 
-template<class... Ts>
-struct is_move_only_function_specialization<move_only_func<Ts...>>
-  : std::true_type {};
+template<class Signature, usize BytesCount>
+struct is_move_only_function_specialization<
+  move_only_func<Signature, BytesCount>> : std::true_type {};
 
 template<class... Ts>
 inline constexpr bool is_move_only_function_specialization_v{
@@ -38,9 +49,9 @@ inline constexpr bool is_move_only_function_specialization_v{
 template<class...>
 struct is_copyable_function_specialization : std::false_type {};
 
-template<class... Ts>
-struct is_copyable_function_specialization<copyable_func<Ts...>>
-  : std::true_type {};
+template<class Signature, usize BytesCount>
+struct is_copyable_function_specialization<
+  copyable_func<Signature, BytesCount>> : std::true_type {};
 
 template<class... Ts>
 inline constexpr bool is_copyable_function_specialization_v{
@@ -61,12 +72,14 @@ inline constexpr bool is_in_place_type_t_specialization_v{
 
 } // namespace func_internal
 
-template<class Signature>
-class move_only_func<Signature> final
-  : func_internal::function_call<move_only_func<Signature>, Signature> {
+template<class Signature, usize BytesCount>
+class move_only_func final
+  : func_internal::function_call<
+      move_only_func<Signature, BytesCount>,
+      Signature> {
 
-  using traits = func_internal::traits<FUNC_STORAGE_BYTES_COUNT, Signature>;
-  using vtable = func_internal::vtable<FUNC_STORAGE_BYTES_COUNT, traits>;
+  using traits = func_internal::traits<BytesCount, Signature>;
+  using vtable = func_internal::vtable<BytesCount, traits>;
   friend func_internal::function_call<move_only_func, Signature>;
 
   template<class... T>
@@ -105,7 +118,7 @@ public:
   ) noexcept
     : allocator{ &alloc } {
     using VT       = std::decay_t<F>;
-    using copyable = copyable_func<Signature>;
+    using copyable = copyable_func<Signature, BytesCount>;
     static_assert(std::is_constructible_v<VT, F>);
     if constexpr (std::is_function_v<std::remove_pointer_t<F>> ||
                   std::is_member_pointer_v<F> ||
@@ -117,7 +130,10 @@ public:
         vptr = vtable::make_empty();
       }
     } else if constexpr (std::is_same_v<std::remove_cvref_t<F>, copyable>) {
-      vptr = func.vptr;
+      // The functor manager in the vtable only knows the allocator type of
+      // `func`, spilled functors stay with that allocator
+      vptr      = func.vptr;
+      allocator = func.allocator;
       if constexpr (std::is_same_v<F, copyable>) {
         func.vptr->destructive_move(&func.storage, &storage);
         func.vptr = vtable::make_empty();
@@ -137,9 +153,10 @@ public:
     std::in_place_type_t<T>,
     Args &&...args
   )
-    : vptr{ make<false, T>(alloc, storage, std::forward<Args>(args)...) }
-    , allocator{ &alloc } {
+    : allocator{ &alloc } {
     static_assert(std::is_same_v<T, std::decay_t<T>>);
+    // Not in the initializer list: `storage` is initialized after `vptr`
+    vptr = make<false, T>(alloc, storage, std::forward<Args>(args)...);
   }
 
   template<class T, class U, class... Args>
@@ -154,19 +171,15 @@ public:
     std::initializer_list<U> ilist,
     Args &&...args
   )
-    : vptr{ make<false, T>(
-        alloc,
-        storage,
-        ilist,
-        std::forward<Args>(args)...
-      ) }
-    , allocator{ &alloc } {
+    : allocator{ &alloc } {
     static_assert(std::is_same_v<T, std::decay_t<T>>);
+    vptr = make<false, T>(alloc, storage, ilist, std::forward<Args>(args)...);
   }
 
   move_only_func(move_only_func const &) = delete;
 
-  move_only_func(move_only_func &&other) noexcept {
+  move_only_func(move_only_func &&other) noexcept
+    : allocator{ other.allocator } {
     vtable::move_ctor(vptr, storage, other.vptr, other.storage);
   }
 
@@ -201,6 +214,7 @@ public:
 
   void swap(move_only_func &other) noexcept {
     vtable::swap(vptr, storage, other.vptr, other.storage);
+    std::swap(allocator, other.allocator);
   }
 
   friend void swap(move_only_func &lhs, move_only_func &rhs) noexcept {
@@ -213,15 +227,17 @@ public:
   }
 };
 
-template<class Signature>
-class copyable_func<Signature> final
-  : func_internal::function_call<copyable_func<Signature>, Signature> {
+template<class Signature, usize BytesCount>
+class copyable_func final
+  : func_internal::function_call<
+      copyable_func<Signature, BytesCount>,
+      Signature> {
 
-  using traits = func_internal::traits<FUNC_STORAGE_BYTES_COUNT, Signature>;
-  using vtable = func_internal::vtable<FUNC_STORAGE_BYTES_COUNT, traits>;
+  using traits = func_internal::traits<BytesCount, Signature>;
+  using vtable = func_internal::vtable<BytesCount, traits>;
 
   friend func_internal::function_call<copyable_func, Signature>;
-  friend move_only_func<Signature>;
+  friend move_only_func<Signature, BytesCount>;
 
   template<class... T>
   static constexpr bool is_invocable_using{
@@ -278,9 +294,10 @@ public:
     std::in_place_type_t<T>,
     Args &&...args
   )
-    : vptr{ make<true, T>(alloc, storage, std::forward<Args>(args)...) }
-    , allocator{ &alloc } {
+    : allocator{ &alloc } {
     static_assert(std::is_same_v<T, std::decay_t<T>>);
+    // Not in the initializer list: `storage` is initialized after `vptr`
+    vptr = make<true, T>(alloc, storage, std::forward<Args>(args)...);
   }
 
   template<class T, class U, class... Args>
@@ -295,15 +312,15 @@ public:
     std::initializer_list<U> ilist,
     Args &&...args
   )
-    : vptr{ make<true, T>(alloc, storage, ilist, std::forward<Args>(args)...) }
-    , allocator{ &alloc } {
+    : allocator{ &alloc } {
     static_assert(std::is_same_v<T, std::decay_t<T>>);
+    vptr = make<true, T>(alloc, storage, ilist, std::forward<Args>(args)...);
   }
 
   constexpr copyable_func(copyable_func const &other)
     : vptr{ other.vptr }
     , allocator{ other.allocator } {
-    other.vptr->copy(&other.storage, &storage);
+    other.vptr->copy(allocator, &other.storage, &storage);
   }
 
   constexpr copyable_func(copyable_func &&other) noexcept
@@ -313,25 +330,14 @@ public:
   }
 
   auto operator=(copyable_func const &other) -> copyable_func & {
-    if (this == &other) { return *this; }
-
-    vptr->destroy(allocator, &storage);
-    if (!other.vptr->is_noexcept_copyable) {
-      typename vtable::context tmp;
-      other.vptr->copy(&other.storage, &tmp);
-      other.vptr->move(&tmp, &storage);
-    } else {
-      other.vptr->copy(&other.storage, &storage);
-    }
-    vptr      = other.vptr;
-    allocator = other.allocator;
+    if (this != &other) { copyable_func{ other }.swap(*this); }
     return *this;
   }
 
   auto operator=(copyable_func &&other) noexcept -> copyable_func & {
     if (&storage == &other.storage) { return *this; }
 
-    vtable::move_assign(vptr, storage, other.vptr, other.storage);
+    vtable::move_assign(allocator, vptr, storage, other.vptr, other.storage);
     allocator = other.allocator;
     return *this;
   }
@@ -357,6 +363,7 @@ public:
 
   constexpr void swap(copyable_func &other) noexcept {
     vtable::swap(vptr, storage, other.vptr, other.storage);
+    std::swap(allocator, other.allocator);
   }
 
   friend void swap(copyable_func &lhs, copyable_func &rhs) noexcept {
@@ -369,4 +376,142 @@ public:
   }
 };
 
+/**
+ * Move-only func without an allocator: a functor that doesn't fit
+ * `BytesCount` bytes (or may throw on move) is a compile error instead of
+ * a heap allocation.
+ */
+template<class Signature, usize BytesCount>
+class inplace_func final
+  : func_internal::function_call<
+      inplace_func<Signature, BytesCount>,
+      Signature> {
+
+  using traits = func_internal::traits<BytesCount, Signature>;
+  using vtable = func_internal::vtable<BytesCount, traits>;
+  friend func_internal::function_call<inplace_func, Signature>;
+
+  template<class... T>
+  static constexpr bool is_invocable_using{
+    traits::template is_invocable_using<T...>
+  };
+
+  template<class VT>
+  static constexpr bool is_callable_from{
+    is_invocable_using<typename traits::template quals<VT>> &&
+    is_invocable_using<typename traits::template inv_quals<VT>>
+  };
+
+  vtable const            *vptr{ vtable::make_empty() };
+  typename vtable::context storage{};
+
+public:
+  constexpr inplace_func(std::nullptr_t = nullptr) noexcept {}
+
+  template<class F>
+    requires(
+      !std::is_same_v<inplace_func, std::remove_cvref_t<F>> &&
+      !func_internal::is_in_place_type_t_specialization_v<
+        std::remove_cvref_t<F>> &&
+      is_callable_from<std::decay_t<F>>
+    )
+  constexpr inplace_func(F &&func) noexcept {
+    using VT = std::decay_t<F>;
+    static_assert(std::is_constructible_v<VT, F>);
+    if constexpr (std::is_function_v<std::remove_pointer_t<F>> ||
+                  std::is_member_pointer_v<F>) {
+      if (!func) { return; }
+    }
+    vptr = vtable::template make_inplace<VT>(storage, std::forward<F>(func));
+  }
+
+  template<class T, class... Args>
+    requires(std::is_constructible_v<std::decay_t<T>, Args && ...> &&
+             is_callable_from<std::decay_t<T>>)
+  constexpr explicit inplace_func(std::in_place_type_t<T>, Args &&...args) {
+    static_assert(std::is_same_v<T, std::decay_t<T>>);
+    vptr = vtable::template make_inplace<T>(
+      storage, std::forward<Args>(args)...
+    );
+  }
+
+  inplace_func(inplace_func const &) = delete;
+
+  inplace_func(inplace_func &&other) noexcept {
+    vtable::move_ctor(vptr, storage, other.vptr, other.storage);
+  }
+
+  auto operator=(inplace_func const &) -> inplace_func & = delete;
+
+  auto operator=(inplace_func &&other) noexcept -> inplace_func & {
+    if (&storage == &other.storage) { return *this; }
+
+    vtable::move_assign(nullptr, vptr, storage, other.vptr, other.storage);
+    return *this;
+  }
+
+  auto operator=(std::nullptr_t) noexcept -> inplace_func & {
+    if (*this) { inplace_func{}.swap(*this); }
+    return *this;
+  }
+
+  ~inplace_func() noexcept { vptr->destroy(nullptr, &storage); }
+
+  using func_internal::function_call<inplace_func, Signature>::operator();
+
+  explicit operator bool() const noexcept {
+    return vptr != vtable::make_empty();
+  }
+
+  void swap(inplace_func &other) noexcept {
+    vtable::swap(vptr, storage, other.vptr, other.storage);
+  }
+
+  friend void swap(inplace_func &lhs, inplace_func &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  friend auto operator==(inplace_func const &self, std::nullptr_t) noexcept
+    -> bool {
+    return !self;
+  }
+};
+
+/**
+ * Non-owning callable, two pointers wide: nothing is copied or allocated.
+ * The referenced callable must outlive it, so it's meant for parameters
+ * (visitors, predicates) rather than members.
+ */
+template<class Result, class... Args>
+class function_ref<Result(Args...)> final
+  : public func_internal::function_ref_impl<false, false, Result, Args...> {
+public:
+  using func_internal::function_ref_impl<false, false, Result, Args...>::
+    function_ref_impl;
+};
+
+template<class Result, class... Args>
+class function_ref<Result(Args...) const> final
+  : public func_internal::function_ref_impl<true, false, Result, Args...> {
+public:
+  using func_internal::function_ref_impl<true, false, Result, Args...>::
+    function_ref_impl;
+};
+
+template<class Result, class... Args>
+class function_ref<Result(Args...) noexcept> final
+  : public func_internal::function_ref_impl<false, true, Result, Args...> {
+public:
+  using func_internal::function_ref_impl<false, true, Result, Args...>::
+    function_ref_impl;
+};
+
+template<class Result, class... Args>
+class function_ref<Result(Args...) const noexcept> final
+  : public func_internal::function_ref_impl<true, true, Result, Args...> {
+public:
+  using func_internal::function_ref_impl<true, true, Result, Args...>::
+    function_ref_impl;
+};
+
 } // namespace gzn::fnd
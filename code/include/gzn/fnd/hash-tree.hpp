@@ -0,0 +1,36 @@
+#pragma once
+
+#include <span>
+
+#include "gzn/fnd/hash.hpp"
+
+namespace gzn::fnd {
+
+/*
+ *  Default leaf length of `hash_tree`.
+ */
+inline constexpr usize hash_tree_leaf_bytes{ usize{ 1 } << 20 };
+
+struct hash_tree_params {
+  std::span<byte const> data;
+  std::span<u64 const>  secret{ hash_secret };
+  u64                   seed{};
+  usize                 leaf_bytes{ hash_tree_leaf_bytes };
+  /// Threads hashing leaves, the calling one included. Zero takes the
+  /// hardware concurrency.
+  u32                   threads_count{};
+};
+
+/**
+ * Hashes large inputs (asset archives, @ref mapped_file views) on several
+ * threads. The data is split into `leaf_bytes` leaves, each hashed by
+ * @ref hash with the seed mixed with its index, and the leaf digests are
+ * hashed once more in order.
+ *
+ * The digest depends on the data, secret, seed and leaf length only, never
+ * on the threads count. It differs from `hash` over the same bytes.
+ */
+[[nodiscard]]
+auto hash_tree(hash_tree_params const &in) -> u64;
+
+} // namespace gzn::fnd
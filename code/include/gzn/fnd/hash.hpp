@@ -33,6 +33,7 @@
 #include <cstring>
 #include <span>
 
+#include "gzn/fnd/assert.hpp"
 #include "gzn/fnd/definitions.hpp"
 #include "gzn/fnd/internal/str-utils.hpp"
 
@@ -75,6 +76,17 @@ inline constexpr std::array<u64, 8> hash_secret{
   0x90'ED'17'65'28'1C'38'8Cull, 0xAA'AA'AA'AA'AA'AA'AA'AAull
 };
 
+/*
+ *  Keys longer than it are mixed a block at a time by seven lanes.
+ */
+inline constexpr usize hash_wide_step_bytes{ 224 };
+inline constexpr usize hash_short_step_bytes{ hash_wide_step_bytes / 2 };
+
+/*
+ *  Longest key `hash_batch` takes through the short-key path.
+ */
+inline constexpr usize hash_batch_max_bytes{ 16 };
+
 namespace util {
 
 template<class T>
@@ -257,6 +269,112 @@ gzn_inline constexpr auto hash_leaf_seed(
   return seed;
 }
 
+/*
+ *  Mixes the first 112 bytes of `p` into the seven lanes.
+ */
+template<util::hashing_symbol Symbol>
+gzn_inline constexpr void hash_step(
+  std::array<u64, 7>         &see,
+  hash_key_span<Symbol> const p,
+  std::span<u64 const> const  secret
+) noexcept {
+  auto constexpr s_in_u64{ sizeof(u64) / sizeof(Symbol) };
+
+#pragma omp simd
+  for (size_t i{}, j{}; i < std::size(see); ++i, j += 2) {
+    see[i] = hash_mix(
+      hash_read64(p.subspan(s_in_u64 * (j + 0), s_in_u64)) ^ secret[i],
+      hash_read64(p.subspan(s_in_u64 * (j + 1), s_in_u64)) ^ see[i]
+    );
+  }
+}
+
+/*
+ *  Mixes the first 224 bytes of `p` into the seven lanes.
+ */
+template<util::hashing_symbol Symbol>
+gzn_inline constexpr void hash_wide_step(
+  std::array<u64, 7>         &see,
+  hash_key_span<Symbol> const p,
+  std::span<u64 const> const  secret
+) noexcept {
+  hash_step(see, p, secret);
+  hash_step(see, p.subspan(hash_short_step_bytes / sizeof(Symbol)), secret);
+}
+
+gzn_inline constexpr auto hash_fold(std::array<u64, 7> see) noexcept -> u64 {
+  see[0] ^= see[1];
+  see[2] ^= see[3];
+  see[4] ^= see[5];
+  see[0] ^= see[6];
+  see[2] ^= see[4];
+  see[0] ^= see[2];
+  return see[0];
+}
+
+gzn_inline constexpr auto hash_initial_seed(
+  u64 const                  seed,
+  std::span<u64 const> const secret
+) noexcept -> u64 {
+  return seed ^ hash_mix(seed ^ secret[2], secret[1]);
+}
+
+gzn_inline constexpr auto hash_finish(
+  u64                        a,
+  u64                        b,
+  u64 const                  seed,
+  u64 const                  remain_bytes,
+  std::span<u64 const> const secret
+) noexcept -> u64 {
+  a ^= secret[1];
+  b ^= seed;
+  hash_mum(a, b);
+  return hash_mix(a ^ secret[7], b ^ secret[1] ^ remain_bytes);
+}
+
+struct hash_short_words {
+  u64 a{};
+  u64 b{};
+  u64 seed{};
+};
+
+/*
+ *  Reads a key of at most 16 bytes into the two words to mix.
+ */
+template<util::hashing_symbol Symbol>
+gzn_inline constexpr auto hash_read_short(
+  hash_key_span<Symbol> const p,
+  u64 const                   seed
+) noexcept -> hash_short_words {
+  auto constexpr s_in_u64{ sizeof(u64) / sizeof(Symbol) };
+
+  auto const bytes_count{ p.size_bytes() };
+  if (bytes_count >= 4) [[likely]] { // 4, 5....
+    if (bytes_count >= 8) {          // 8, 9....
+      return {
+        .a    = hash_read64(p.subspan(0, s_in_u64)),
+        .b    = hash_read64(p.subspan(std::size(p) - s_in_u64, s_in_u64)),
+        .seed = seed ^ bytes_count,
+      };
+    }
+    // 4, 5, 6, 7
+    auto constexpr s_in_u32{ sizeof(u32) / sizeof(Symbol) };
+    return {
+      .a    = hash_read32(p.subspan(0, s_in_u32)),
+      .b    = hash_read32(p.subspan(std::size(p) - s_in_u32, s_in_u32)),
+      .seed = seed ^ bytes_count,
+    };
+  }
+  if (bytes_count > 0) { // 1, 2, 3
+    return {
+      .a = (static_cast<u64>(p.front()) << 45) | static_cast<u64>(p.back()),
+      .b = static_cast<u64>(p[std::size(p) >> 1]),
+      .seed = seed,
+    };
+  }
+  return { .seed = seed };
+}
+
 /*
  *  hash main function.
  *
@@ -274,80 +392,196 @@ gzn_inline constexpr auto hash(hash_params<Symbol> const &in) noexcept -> u64 {
 
   auto const bytes_count{ in.key.size_bytes() };
   auto const secret{ in.secret };
-  auto       seed{ in.seed ^ hash_mix(in.seed ^ secret[2], secret[1]) };
+  auto       seed{ hash_initial_seed(in.seed, secret) };
   auto       remain_bytes{ bytes_count };
   u64        a{}, b{};
   auto       p{ in.key };
 
   if (bytes_count > 16) [[unlikely]] {
-    auto constexpr wide_step_bytes{ 224uz };
-    auto constexpr short_step_bytes{ wide_step_bytes / 2zu };
-    if (bytes_count > short_step_bytes) {
+    if (bytes_count > hash_short_step_bytes) {
       std::array<u64, 7> see{ seed, seed, seed, seed, seed, seed, seed };
 
-      while (remain_bytes > wide_step_bytes) {
-#pragma omp simd
-        for (size_t i{}, j{}; i < std::size(see); ++i, j += 2) {
-          see[i] = hash_mix(
-            hash_read64(p.subspan(s_in_u64 * (j + 0), s_in_u64)) ^ secret[i],
-            hash_read64(p.subspan(s_in_u64 * (j + 1), s_in_u64)) ^ see[i]
-          );
-        }
+      while (remain_bytes > hash_wide_step_bytes) {
+        hash_wide_step(see, p, secret);
 
-        auto constexpr wide_symbol_step{ wide_step_bytes / sizeof(Symbol) };
+        auto constexpr wide_symbol_step{
+          hash_wide_step_bytes / sizeof(Symbol)
+        };
         p = p.subspan(wide_symbol_step, std::size(p) - wide_symbol_step);
-        remain_bytes -= wide_step_bytes;
+        remain_bytes -= hash_wide_step_bytes;
       }
 
-      if (remain_bytes > short_step_bytes) {
-#pragma omp simd
-        for (size_t i{}, j{}; i < std::size(see); ++i, j += 2) {
-          see[i] = hash_mix(
-            hash_read64(p.subspan(s_in_u64 * (j + 0), s_in_u64)) ^ secret[i],
-            hash_read64(p.subspan(s_in_u64 * (j + 1), s_in_u64)) ^ see[i]
-          );
-        }
+      if (remain_bytes > hash_short_step_bytes) {
+        hash_step(see, p, secret);
 
-        auto constexpr short_symbol_step{ short_step_bytes / sizeof(Symbol) };
+        auto constexpr short_symbol_step{
+          hash_short_step_bytes / sizeof(Symbol)
+        };
         p = p.subspan(short_symbol_step, std::size(p) - short_symbol_step);
-        remain_bytes -= short_step_bytes;
+        remain_bytes -= hash_short_step_bytes;
       }
-      see[0] ^= see[1];
-      see[2] ^= see[3];
-      see[4] ^= see[5];
-      see[0] ^= see[6];
-      see[2] ^= see[4];
-      see[0] ^= see[2];
-      seed    = see[0];
+      seed = hash_fold(see);
     }
 
     seed = hash_leaf_seed<Symbol>(
       remain_bytes, { .key = p, .secret = secret, .seed = seed }
     );
 
-    a = hash_read64(p.subspan(std::size(p) - (s_in_u64 * 2))) ^ remain_bytes;
-    b = hash_read64(p.subspan(std::size(p) - (s_in_u64 * 1)));
-  } else if (bytes_count >= 4) [[likely]] { // 4, 5....
-    seed ^= bytes_count;
-    if (bytes_count >= 8) { // 8, 9....
-      a = hash_read64(p.subspan(0, s_in_u64));
-      b = hash_read64(p.subspan(std::size(p) - s_in_u64, s_in_u64));
-    } else { // 4, 5, 6, 7
-      auto constexpr s_in_u32{ sizeof(u32) / sizeof(Symbol) };
-      a = hash_read32(p.subspan(0, s_in_u32));
-      a = hash_read32(p.subspan(std::size(p) - s_in_u32, s_in_u32));
-    }
-  } else { // 1, 2, 3
-    a = (static_cast<u64>(p.front()) << 45) | static_cast<u64>(p.back());
-    b = static_cast<u64>(p[std::size(p) >> 1]);
+    // Less than 16 bytes may remain after the steps, the tail is read from
+    // the whole key and overlaps the mixed bytes then
+    auto const tail{ in.key.last(s_in_u64 * 2) };
+    a = hash_read64(tail.first(s_in_u64)) ^ remain_bytes;
+    b = hash_read64(tail.last(s_in_u64));
+  } else {
+    auto const words{ hash_read_short(p, seed) };
+    a    = words.a;
+    b    = words.b;
+    seed = words.seed;
   }
 
-  a ^= secret[1];
-  b ^= seed;
-  hash_mum(a, b);
-  return hash_mix(a ^ secret[7], b ^ secret[1] ^ remain_bytes);
+  return hash_finish(a, b, seed, remain_bytes, secret);
 }
 
+/**
+ * Hashes independent keys at once, e.g. when rebuilding a table or
+ * interning names. The seed is prepared once for the whole batch and keys
+ * of at most @ref hash_batch_max_bytes skip the long-key paths; every
+ * digest equals the one of `hash` with the same seed and secret.
+ */
+template<util::hashing_symbol Symbol>
+void hash_batch(
+  std::span<hash_key_span<Symbol> const> const keys,
+  std::span<u64> const                         out,
+  u64 const                                    seed   = 0,
+  std::span<u64 const> const                   secret = hash_secret
+) noexcept {
+  gzn_assertion(
+    std::size(out) >= std::size(keys), "Not enough room for the digests"
+  );
+
+  auto const initial_seed{ hash_initial_seed(seed, secret) };
+  for (usize i{}; i < std::size(keys); ++i) {
+    auto const key{ keys[i] };
+    auto const bytes_count{ key.size_bytes() };
+    if (bytes_count > hash_batch_max_bytes) [[unlikely]] {
+      out[i] = hash<Symbol>({ .key = key, .secret = secret, .seed = seed });
+      continue;
+    }
+
+    auto const words{ hash_read_short(key, initial_seed) };
+    out[i] = hash_finish(words.a, words.b, words.seed, bytes_count, secret);
+  }
+}
+
+/**
+ * Incremental @ref hash for keys that arrive in chunks, e.g. asset files
+ * streamed from disk. The digest equals the one of `hash` over all chunks
+ * concatenated, only the last 224-byte block is kept in between.
+ *
+ * The secret isn't copied and must outlive the hasher.
+ */
+template<util::hashing_symbol Symbol>
+class basic_hasher {
+public:
+  constexpr explicit basic_hasher(
+    u64 const                  seed   = 0,
+    std::span<u64 const> const secret = hash_secret
+  ) noexcept
+    : m_secret{ secret }
+    , m_seed{ seed } {}
+
+  constexpr void update(hash_key_span<Symbol> chunk) noexcept {
+    while (!std::empty(chunk)) {
+      // A block is mixed only once more data follows it: the last one goes
+      // through the tail path in `finalize`
+      if (m_buffered == block_length) {
+        consume(m_block);
+        m_buffered = 0;
+      }
+      if (m_buffered == 0) {
+        while (std::size(chunk) > block_length) {
+          consume(chunk.first(block_length));
+          chunk = chunk.subspan(block_length);
+        }
+      }
+
+      auto const count{
+        std::min(std::size(chunk), block_length - m_buffered)
+      };
+      std::copy_n(std::begin(chunk), count, std::begin(m_block) + m_buffered);
+      m_buffered += count;
+      chunk       = chunk.subspan(count);
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto finalize() const noexcept -> u64 {
+    hash_key_span<Symbol> p{ std::data(m_block), m_buffered };
+    if (!m_mixed) {
+      return hash<Symbol>({ .key = p, .secret = m_secret, .seed = m_seed });
+    }
+
+    auto constexpr s_in_u64{ sizeof(u64) / sizeof(Symbol) };
+
+    auto see{ m_see };
+    auto remain_bytes{ m_buffered * sizeof(Symbol) };
+    if (remain_bytes > hash_short_step_bytes) {
+      hash_step(see, p, m_secret);
+      p             = p.subspan(hash_short_step_bytes / sizeof(Symbol));
+      remain_bytes -= hash_short_step_bytes;
+    }
+
+    auto const seed{ hash_leaf_seed<Symbol>(
+      remain_bytes,
+      { .key = p, .secret = m_secret, .seed = hash_fold(see) }
+    ) };
+
+    // The last 16 bytes of the key, partly from the previous block
+    std::array<Symbol, tail_length> tail{};
+    if (m_buffered >= tail_length) {
+      std::ranges::copy(p.last(tail_length), std::begin(tail));
+    } else {
+      auto const previous{ tail_length - m_buffered };
+      std::copy_n(
+        std::end(m_previous_tail) - previous, previous, std::begin(tail)
+      );
+      std::ranges::copy(p, std::begin(tail) + previous);
+    }
+
+    hash_key_span<Symbol> const last{ tail };
+    return hash_finish(
+      hash_read64(last.first(s_in_u64)) ^ remain_bytes,
+      hash_read64(last.last(s_in_u64)),
+      seed,
+      remain_bytes,
+      m_secret
+    );
+  }
+
+private:
+  usize static constexpr block_length{ hash_wide_step_bytes / sizeof(Symbol) };
+  usize static constexpr tail_length{ 2 * sizeof(u64) / sizeof(Symbol) };
+
+  std::span<u64 const>             m_secret{};
+  u64                              m_seed{};
+  std::array<u64, 7>               m_see{};
+  std::array<Symbol, block_length> m_block{};
+  std::array<Symbol, tail_length>  m_previous_tail{};
+  usize                            m_buffered{};
+  bool                             m_mixed{};
+
+  constexpr void consume(hash_key_span<Symbol> const block) noexcept {
+    if (!m_mixed) {
+      m_see.fill(hash_initial_seed(m_seed, m_secret));
+      m_mixed = true;
+    }
+    hash_wide_step(m_see, block, m_secret);
+    std::ranges::copy(block.last(tail_length), std::begin(m_previous_tail));
+  }
+};
+
+using hasher = basic_hasher<std::byte>;
+
 #undef GZN_HASH_BIG_ENDIAN
 #undef GZN_HASH_LITTLE_ENDIAN
 
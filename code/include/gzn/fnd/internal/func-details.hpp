@@ -7,6 +7,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include "gzn/fnd/allocators.hpp"
@@ -45,22 +46,21 @@ struct functor_storage final {
   };
 };
 
-/// @note maybe just std::in_place_type_t
-template<class Context, class Functor>
-bool inline constexpr is_functor_inplace_allocatable_v{
-  sizeof(Functor) <= Context::bytes_count &&
-  (alignof(Context) % alignof(Functor)) == 0
-};
-
+/// Both construction and dispatch go by it, so a functor is never built
+/// in one place and looked up in another
 template<class Functor, usize BytesCount>
-bool inline constexpr is_sbo{ sizeof(Functor) <= BytesCount &&
-                              std::is_nothrow_move_constructible_v<Functor> };
+bool inline constexpr is_sbo{
+  sizeof(Functor) <= BytesCount &&
+  (alignof(functor_storage<BytesCount>) % alignof(Functor)) == 0 &&
+  std::is_nothrow_move_constructible_v<Functor>
+};
 
 template<usize BytesCount, class Traits>
 struct vtable final {
   using dispatch_fn          = typename Traits::dispatch_type;
   using context              = functor_storage<BytesCount>;
-  using copy_fn              = bool (*)(void *, context *, context *) noexcept;
+  using copy_fn              =
+    bool (*)(void *, context const *, context *) noexcept;
   using destroy_fn           = void (*)(void *, context *) noexcept;
   using destructive_move_fn  = void (*)(context *, context *) noexcept;
   using noexcept_copyable_fn = bool (*)() noexcept;
@@ -110,11 +110,9 @@ struct vtable final {
     std::swap(lhs_vptr, rhs_vptr);
   }
 
-  template<
-    bool Copyable,
-    bool InPlace,
-    class T,
-    util::allocator_type Allocator>
+  /// `Allocator` is `void` for functors that never leave the inline storage
+  template<bool Copyable, bool InPlace, class T, class Allocator>
+    requires(InPlace || util::allocator_type<Allocator>)
   struct functor_manager final {
     template<class... Args>
       requires std::is_constructible_v<T, Args &&...>
@@ -137,39 +135,36 @@ struct vtable final {
     }
 
     static constexpr auto copy(
-      void    *alloc,
-      context *from,
-      context *to
-    ) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool {
-      if constexpr (!Copyable) { std::unreachable(); }
-
-      if constexpr (!InPlace) {
+      void          *alloc,
+      context const *from,
+      context       *to
+    ) noexcept -> bool {
+      if constexpr (!Copyable) {
+        std::unreachable();
+      } else if constexpr (!InPlace) {
         to->ptr = static_cast<Allocator *>(alloc)->allocate(
           sizeof(T), alignof(T), 0u, 0u
         );
         new (to->ptr) T{ *reinterpret_cast<T const *>(from->ptr) };
       } else {
-        new (to->sbo) T{ *reinterpret_cast<T const *>(from->ptr) };
+        new (to->sbo) T{ *reinterpret_cast<T const *>(from->sbo) };
       }
       return true;
     }
 
-    static constexpr void destroy(void *alloc, context *target) noexcept(
-      std::is_nothrow_destructible_v<T>
-    ) {
-      reinterpret_cast<T *>(target->ptr)->~T();
+    static constexpr void destroy(void *alloc, context *target) noexcept {
       if constexpr (!InPlace) {
+        reinterpret_cast<T *>(target->ptr)->~T();
         if (alloc) {
           static_cast<Allocator *>(alloc)->deallocate(target->ptr, sizeof(T));
         }
+      } else {
+        reinterpret_cast<T *>(target->sbo)->~T();
       }
     }
 
     static constexpr void
-    destructive_move(context *from, context *to) noexcept(
-      std::is_nothrow_move_constructible_v<T> &&
-      std::is_nothrow_destructible_v<T>
-    ) {
+    destructive_move(context *from, context *to) noexcept {
       if constexpr (InPlace) {
         new (to->sbo) T{ FUNC_MOVE(*reinterpret_cast<T *>(from->sbo)) };
         reinterpret_cast<T *>(from->sbo)->~T();
@@ -180,7 +175,8 @@ struct vtable final {
   };
 
   struct nop_functor_manager final {
-    static constexpr auto copy(void *, context *, context *) noexcept -> bool {
+    static constexpr auto copy(void *, context const *, context *) noexcept
+      -> bool {
       return false;
     }
 
@@ -189,6 +185,15 @@ struct vtable final {
     static constexpr void destructive_move(context *, context *) noexcept {}
   };
 
+  template<class Manager, class T>
+  vtable static constexpr functor_vtable{
+    .dispatch         = &Traits::template dispatch<T, is_sbo<T, BytesCount>>,
+    .copy             = Manager::copy,
+    .destroy          = Manager::destroy,
+    .destructive_move = Manager::destructive_move,
+    .is_noexcept_copyable = std::is_nothrow_copy_constructible_v<T>,
+  };
+
   template<bool Copyable, class T, class... Args>
   static auto make(
     util::allocator_type auto &alloc,
@@ -196,22 +201,33 @@ struct vtable final {
     Args &&...args
   ) -> vtable const * {
     using allocator_type = std::remove_cvref_t<decltype(alloc)>;
-    auto constexpr in_place{ is_functor_inplace_allocatable_v<context, T> };
-    using manager_type =
-      functor_manager<Copyable, in_place, T, allocator_type>;
+    using manager_type   = functor_manager<
+        Copyable,
+        is_sbo<T, BytesCount>,
+        T,
+        allocator_type>;
 
     manager_type::template construct<Args...>(
       &alloc, storage, FUNC_FORWARD(Args, args)...
     );
+    return &functor_vtable<manager_type, T>;
+  }
 
-    static constexpr vtable _static_vtable{
-      .dispatch         = &Traits::template dispatch<T, is_sbo<T, BytesCount>>,
-      .copy             = manager_type::copy,
-      .destroy          = manager_type::destroy,
-      .destructive_move = manager_type::destructive_move,
-      .is_noexcept_copyable = std::is_nothrow_copy_constructible_v<T>,
-    };
-    return &_static_vtable;
+  /// Construction without an allocator, the functor must fit the storage
+  template<class T, class... Args>
+  static auto make_inplace(context &storage, Args &&...args)
+    -> vtable const * {
+    gzn_static_assert(
+      (is_sbo<T, BytesCount>),
+      "The functor doesn't fit the inline storage: increase its size or use "
+      "move_only_func"
+    );
+    using manager_type = functor_manager<false, true, T, void>;
+
+    manager_type::template construct<Args...>(
+      nullptr, storage, FUNC_FORWARD(Args, args)...
+    );
+    return &functor_vtable<manager_type, T>;
   }
 
   static auto make_empty() -> vtable const * {
@@ -611,6 +627,69 @@ struct function_call<Impl, Result(Args...) const && noexcept> {
   }
 };
 
+/// Object or function a @ref function_ref calls, a function pointer can't
+/// portably be kept in a `void *`
+union bound_entity {
+  void *object;
+  void (*function)();
+};
+
+template<bool Const, bool Noexcept, class Result, class... Args>
+class function_ref_impl {
+  template<class T>
+  using const_ = std::conditional_t<Const, T const, T>;
+
+  using thunk_type = std::conditional_t<
+    Noexcept,
+    Result (*)(bound_entity, Args &&...) noexcept,
+    Result (*)(bound_entity, Args &&...)>;
+
+  bound_entity m_bound;
+  thunk_type   m_thunk;
+
+protected:
+  template<class T>
+  bool static constexpr is_invocable_using{
+    Noexcept ? std::is_nothrow_invocable_r_v<Result, T, Args...>
+             : std::is_invocable_r_v<Result, T, Args...>
+  };
+
+public:
+  template<class F>
+    requires(std::is_function_v<F> && is_invocable_using<F>)
+  function_ref_impl(F *func) noexcept
+    : m_bound{ .function = reinterpret_cast<void (*)()>(func) }
+    , m_thunk{ [](bound_entity bound, Args &&...args) noexcept(Noexcept)
+                 -> Result {
+      return std::invoke_r<Result>(
+        reinterpret_cast<F *>(bound.function), FUNC_FORWARD(Args, args)...
+      );
+    } } {
+    gzn_assertion(func != nullptr, "Null function reference");
+  }
+
+  template<class F, class T = std::remove_reference_t<F>>
+    requires(
+      !std::is_base_of_v<function_ref_impl, std::remove_cvref_t<F>> &&
+      !std::is_function_v<T> && !std::is_member_pointer_v<T> &&
+      is_invocable_using<const_<T> &>
+    )
+  function_ref_impl(F &&func) noexcept
+    : m_bound{ .object = const_cast<void *>(
+                 static_cast<void const *>(std::addressof(func))
+               ) }
+    , m_thunk{ [](bound_entity bound, Args &&...args) noexcept(Noexcept)
+                 -> Result {
+      return std::invoke_r<Result>(
+        *static_cast<const_<T> *>(bound.object), FUNC_FORWARD(Args, args)...
+      );
+    } } {}
+
+  auto operator()(Args... args) const noexcept(Noexcept) -> Result {
+    return m_thunk(m_bound, FUNC_FORWARD(Args, args)...);
+  }
+};
+
 #undef FUNC_MOVE
 #undef FUNC_FORWARD
 
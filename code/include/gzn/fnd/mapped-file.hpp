@@ -0,0 +1,57 @@
+#pragma once
+
+#include <span>
+
+#include "gzn/fnd/definitions.hpp"
+#include "gzn/fnd/types.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * Read-only memory mapping of a whole file, e.g. a packed asset archive
+ * verified with @ref hash_tree: pages are read in by whichever thread
+ * touches them first, without copying the file into memory. Missing and
+ * empty files give an invalid mapping.
+ */
+class mapped_file {
+public:
+  constexpr mapped_file() noexcept = default;
+
+  explicit mapped_file(cstr path) noexcept;
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file(mapped_file &&other) noexcept;
+
+  ~mapped_file();
+
+  auto operator=(mapped_file const &) -> mapped_file & = delete;
+  auto operator=(mapped_file &&other) noexcept -> mapped_file &;
+
+  [[nodiscard]]
+  constexpr auto is_valid() const noexcept -> bool {
+    return m_data != nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> byte const * {
+    return m_data;
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> usize {
+    return m_size;
+  }
+
+  [[nodiscard]]
+  constexpr auto bytes() const noexcept -> std::span<byte const> {
+    return { m_data, m_size };
+  }
+
+private:
+  byte const *m_data{ nullptr };
+  usize       m_size{};
+
+  void unmap() noexcept;
+};
+
+} // namespace gzn::fnd
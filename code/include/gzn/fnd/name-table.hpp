@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+
+#include "gzn/fnd/definitions.hpp"
+#include "gzn/fnd/types.hpp"
+
+namespace gzn::fnd {
+
+/**
+ * Process-wide table mapping a name hash to the one stable copy of its
+ * text, the storage behind @ref basic_name when `GZN_INTERNED_NAMES` is
+ * defined.
+ *
+ * The table is split into shards by the top bits of the hash. Lookups are
+ * lock-free (acquire loads of the shard slots), inserts take the shard's
+ * mutex. Entries are never removed: interned text lives until the process
+ * exits.
+ */
+class name_table {
+public:
+  name_table() = delete;
+
+  /// Stores a copy of `text` under `hash` unless the hash is already taken.
+  /// Debug builds assert when it's taken by a different text, release ones
+  /// keep the first text.
+  /// @returns the stable copy
+  static auto intern(u64 hash, std::span<byte const> text)
+    -> std::span<byte const>;
+
+  /// Reverse lookup, e.g. to print a name in a debugger or a log
+  /// @returns an empty span when `hash` was never interned
+  [[nodiscard]]
+  static auto find(u64 hash) noexcept -> std::span<byte const>;
+
+  /// Approximate while other threads intern
+  [[nodiscard]]
+  static auto size() noexcept -> usize;
+};
+
+} // namespace gzn::fnd
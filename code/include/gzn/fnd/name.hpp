@@ -7,6 +7,10 @@
 #include "gzn/fnd/hash.hpp"
 #include "gzn/fnd/internal/str-utils.hpp"
 
+#if defined(GZN_INTERNED_NAMES)
+#  include "gzn/fnd/name-table.hpp"
+#endif
+
 namespace gzn::fnd {
 
 u64 inline constexpr MAX_NAME_LENGTH_BYTES{ 48 };
@@ -102,6 +106,14 @@ private:
   }
 };
 
+/**
+ * Owning name, compared by hash.
+ *
+ * With `GZN_INTERNED_NAMES` defined it holds only the hash and the text
+ * lives in the global @ref name_table, which asserts on hash collisions in
+ * debug builds. Names built during constant evaluation aren't interned:
+ * their text is available once the same name is built at run time.
+ */
 template<util::character_type Char>
 class basic_name {
 public:
@@ -117,7 +129,9 @@ public:
   static constexpr size_type max_length_bytes{ view_type::max_length_bytes };
   static constexpr size_type max_length{ view_type::max_length };
 
+#if !defined(GZN_INTERNED_NAMES)
   using storage_type = std::array<value_type, max_length>;
+#endif
 
   template<usize Len>
     requires(Len > 0)
@@ -132,6 +146,30 @@ public:
 
   constexpr basic_name(view_type const &n) noexcept;
 
+#if defined(GZN_INTERNED_NAMES)
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> pointer_const {
+    if consteval {
+      return nullptr;
+    } else {
+      return reinterpret_cast<pointer_const>(std::data(text()));
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type {
+    if consteval {
+      return 0;
+    } else {
+      return std::size(text()) / sizeof(value_type);
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> size_type {
+    return size() == 0;
+  }
+#else
   [[nodiscard]]
   constexpr auto data() const noexcept -> pointer_const {
     return std::data(m.data);
@@ -146,6 +184,7 @@ public:
   constexpr auto empty() const noexcept -> size_type {
     return m.length == 0;
   }
+#endif // defined(GZN_INTERNED_NAMES)
 
   [[nodiscard]]
   constexpr auto hash() const noexcept -> hash_type {
@@ -154,21 +193,44 @@ public:
 
   [[nodiscard]]
   constexpr auto view() const noexcept -> view_type {
-    return view_type{ data(), size(), hash() };
+    return view_type{ *this };
   }
 
   [[nodiscard]]
   constexpr auto str_view() const noexcept -> string_view {
-    return string_view{ m.data, m.size };
+    return string_view{ data(), size() };
   }
 
   /// @todo maybe we should provide allocator to this function
   [[nodiscard]]
   constexpr auto str() const noexcept -> string {
-    return string{ m.data, m.size };
+    return string{ data(), size() };
   }
 
 private:
+#if defined(GZN_INTERNED_NAMES)
+  struct internal {
+    hash_type hash{};
+  } m;
+
+  [[nodiscard]]
+  auto text() const noexcept -> std::span<byte const> {
+    return name_table::find(m.hash);
+  }
+
+  template<usize Len = std::dynamic_extent>
+  static constexpr auto intern(
+    std::span<value_type const, Len> span,
+    hash_type const                  hash
+  ) noexcept -> internal {
+    if !consteval {
+      [[maybe_unused]] auto const text{
+        name_table::intern(hash, std::as_bytes(span))
+      };
+    }
+    return internal{ .hash = hash };
+  }
+#else
   struct internal {
     storage_type data{};
     size_type    length;
@@ -187,6 +249,7 @@ private:
     std::ranges::copy(span, std::begin(data));
     return data;
   }
+#endif // defined(GZN_INTERNED_NAMES)
 
   template<usize Len = std::dynamic_extent>
     requires(Len >= 0)
@@ -197,11 +260,15 @@ private:
     }
     gzn_assertion(std::size(span) <= max_length_bytes, "Too long name");
 
+#if defined(GZN_INTERNED_NAMES)
+    return intern(span, fnd::hash<value_type>({ .key = span }));
+#else
     return internal{ .data{ make_data(span) },
                      .length = static_cast<size_type>(std::size(span)),
                      .hash   = fnd::hash<value_type>({
                          .key = span,
                      }) };
+#endif
   }
 };
 
@@ -209,9 +276,19 @@ template<util::character_type Char>
 constexpr basic_name_view<Char>::basic_name_view(name_type const &n) noexcept
   : m{ .data{ std::data(n) }, .length{ std::size(n) }, .hash = n.hash() } {}
 
+#if defined(GZN_INTERNED_NAMES)
+template<util::character_type Char>
+constexpr basic_name<Char>::basic_name(view_type const &n) noexcept
+  : m{ intern(std::span{ std::data(n), std::size(n) }, n.hash()) } {}
+
+gzn_static_assert(
+  sizeof(basic_name<char>) == sizeof(u64), "Interned name should be an id"
+);
+#else
 template<util::character_type Char>
 constexpr basic_name<Char>::basic_name(view_type const &n) noexcept
   : m{ .data{ make_data(n) }, .length{ std::size(n) }, .hash = n.hash() } {}
+#endif // defined(GZN_INTERNED_NAMES)
 
 template<util::character_type Char>
 static constexpr auto operator==(
@@ -203,6 +203,8 @@ template<class T>
   return [&allocator](T *ptr) { util::destroy(allocator, ptr); };
 }
 
+/// Keeps a pointer to its allocator, which has to outlive the owner and its
+/// refs: the @ref allocator_context is not consulted
 template<class T>
 class heap_owner final : public owner_base<T> {
 public:
@@ -115,6 +115,22 @@ inline constexpr auto size(T const &range) noexcept -> SizeType {
   }
 }
 
+/**
+ * Types whose objects may be moved to another address with a plain memcpy,
+ * leaving the source as raw memory. Automatic for trivially copyable types;
+ * other types opt in with `bool static constexpr is_trivially_relocatable{
+ * true };` or by specialising this trait.
+ */
+template<class T>
+struct trivially_relocatable
+  : std::bool_constant<
+      std::is_trivially_copyable_v<T> ||
+      requires { requires T::is_trivially_relocatable; }> {};
+
+template<class T>
+concept trivially_relocatable_type =
+  trivially_relocatable<std::remove_cv_t<T>>::value;
+
 template<class T, class... Ts>
   requires(std::convertible_to<T, Ts> && ...)
 gzn_inline constexpr auto any_from(T &&target, Ts &&...values) noexcept {
@@ -9,6 +9,7 @@
 #include <X11/Xlib.h>
 
 #include "gzn/app/view.hpp"
+#include "gzn/fnd/containers/frozen-map.hpp"
 #include "gzn/fnd/definitions.hpp"
 #include "gzn/gfx/context.hpp"
 
@@ -64,6 +65,135 @@ struct backend_context {
   graphics_data gfx{};
 };
 
+/// XKB keysyms (upper case for letters) to engine keys
+auto constexpr keysym_to_key{
+  fnd::make_frozen_map<KeySym, keys>({
+    { XK_A,           keys::a },
+    { XK_B,           keys::b },
+    { XK_C,           keys::c },
+    { XK_D,           keys::d },
+    { XK_E,           keys::e },
+    { XK_F,           keys::f },
+    { XK_G,           keys::g },
+    { XK_H,           keys::h },
+    { XK_I,           keys::i },
+    { XK_J,           keys::j },
+    { XK_K,           keys::k },
+    { XK_L,           keys::l },
+    { XK_M,           keys::m },
+    { XK_N,           keys::n },
+    { XK_O,           keys::o },
+    { XK_P,           keys::p },
+    { XK_Q,           keys::q },
+    { XK_R,           keys::r },
+    { XK_S,           keys::s },
+    { XK_T,           keys::t },
+    { XK_U,           keys::u },
+    { XK_V,           keys::v },
+    { XK_W,           keys::w },
+    { XK_X,           keys::x },
+    { XK_Y,           keys::y },
+    { XK_Z,           keys::z },
+
+    { XK_0,           keys::n_0 },
+    { XK_1,           keys::n_1 },
+    { XK_2,           keys::n_2 },
+    { XK_3,           keys::n_3 },
+    { XK_4,           keys::n_4 },
+    { XK_5,           keys::n_5 },
+    { XK_6,           keys::n_6 },
+    { XK_7,           keys::n_7 },
+    { XK_8,           keys::n_8 },
+    { XK_9,           keys::n_9 },
+
+    { XK_Control_L,   keys::left_control },
+    { XK_Shift_L,     keys::left_shift },
+    { XK_Alt_L,       keys::left_alt },
+    { XK_Super_L,     keys::left_system },
+    { XK_Meta_L,      keys::left_system },
+    { XK_Control_R,   keys::right_control },
+    { XK_Shift_R,     keys::right_shift },
+    { XK_Alt_R,       keys::right_alt },
+    { XK_Super_R,     keys::right_system },
+    { XK_Meta_R,      keys::right_system },
+
+    // arrows
+    { XK_Left,        keys::left },
+    { XK_Right,       keys::right },
+    { XK_Up,          keys::up },
+    { XK_Down,        keys::down },
+
+    // navigation
+    { XK_Escape,      keys::escape },
+    { XK_Menu,        keys::menu },
+    { XK_Page_Up,     keys::pageup },
+    { XK_Page_Down,   keys::pagedown },
+    { XK_End,         keys::end },
+    { XK_Home,        keys::home },
+    { XK_Insert,      keys::insert },
+    { XK_Delete,      keys::del },
+
+    // punctuation
+    { XK_semicolon,   keys::semicolon },
+    { XK_comma,       keys::comma },
+    { XK_period,      keys::period },
+    { XK_apostrophe,  keys::apostrophe },
+    { XK_quotedbl,    keys::quote },
+    { XK_slash,       keys::slash },
+    { XK_backslash,   keys::backslash },
+    { XK_grave,       keys::tilde },
+    { XK_equal,       keys::equal },
+    { XK_minus,       keys::minus },
+    { XK_space,       keys::space },
+
+    // enter / editing
+    { XK_Return,      keys::enter },
+    { XK_BackSpace,   keys::backspace },
+    { XK_Tab,         keys::tab },
+
+    // misc
+    { XK_Pause,       keys::pause },
+    { XK_Print,       keys::print_screen },
+    { XK_Scroll_Lock, keys::scroll_lock },
+    { XK_Caps_Lock,   keys::caps_lock },
+    { XK_Num_Lock,    keys::num_lock },
+
+    // numpad
+    { XK_KP_0,        keys::numpad_0 },
+    { XK_KP_1,        keys::numpad_1 },
+    { XK_KP_2,        keys::numpad_2 },
+    { XK_KP_3,        keys::numpad_3 },
+    { XK_KP_4,        keys::numpad_4 },
+    { XK_KP_5,        keys::numpad_5 },
+    { XK_KP_6,        keys::numpad_6 },
+    { XK_KP_7,        keys::numpad_7 },
+    { XK_KP_8,        keys::numpad_8 },
+    { XK_KP_9,        keys::numpad_9 },
+    { XK_KP_Add,      keys::add },
+    { XK_KP_Subtract, keys::subtract },
+    { XK_KP_Multiply, keys::multiply },
+    { XK_KP_Divide,   keys::divide },
+    { XK_KP_Enter,    keys::enter },
+    { XK_KP_Decimal,  keys::decimal },
+
+    { XK_F1,          keys::f1 },
+    { XK_F2,          keys::f2 },
+    { XK_F3,          keys::f3 },
+    { XK_F4,          keys::f4 },
+    { XK_F5,          keys::f5 },
+    { XK_F6,          keys::f6 },
+    { XK_F7,          keys::f7 },
+    { XK_F8,          keys::f8 },
+    { XK_F9,          keys::f9 },
+    { XK_F10,         keys::f10 },
+    { XK_F11,         keys::f11 },
+    { XK_F12,         keys::f12 },
+    { XK_F13,         keys::f13 },
+    { XK_F14,         keys::f14 },
+    { XK_F15,         keys::f15 },
+  })
+};
+
 struct view {
   inline static fnd::stack_arena_allocator<512>           alloc{};
   inline static std::array<backend_context, max_backends> contexts{};
@@ -467,157 +597,14 @@ private:
 
 #endif // defined(GZN_GFX_BACKEND_OPENGL)
 
-  constexpr static auto translate_to_key(XKeyEvent &ev) noexcept -> keys {
+  static auto translate_to_key(XKeyEvent &ev) noexcept -> keys {
     auto const group{ 0 };
     auto const level{ (ev.state & ShiftMask) ? 1 : 0 };
     auto keysym{ XkbKeycodeToKeysym(ev.display, ev.keycode, group, level) };
     if (keysym >= XK_a && keysym <= XK_z) { keysym -= XK_a - XK_A; }
-    switch (keysym) {
-      case XK_A: return keys::a;
-      case XK_B: return keys::b;
-      case XK_C: return keys::c;
-      case XK_D: return keys::d;
-      case XK_E: return keys::e;
-      case XK_F: return keys::f;
-      case XK_G: return keys::g;
-      case XK_H: return keys::h;
-      case XK_I: return keys::i;
-      case XK_J: return keys::j;
-      case XK_K: return keys::k;
-      case XK_L: return keys::l;
-      case XK_M: return keys::m;
-      case XK_N: return keys::n;
-      case XK_O: return keys::o;
-      case XK_P: return keys::p;
-      case XK_Q: return keys::q;
-      case XK_R: return keys::r;
-      case XK_S: return keys::s;
-      case XK_T: return keys::t;
-      case XK_U: return keys::u;
-      case XK_V: return keys::v;
-      case XK_W: return keys::w;
-      case XK_X: return keys::x;
-      case XK_Y: return keys::y;
-      default  : break;
-    }
-
-    switch (keysym) {
-      case XK_0: return keys::n_0;
-      case XK_1: return keys::n_1;
-      case XK_2: return keys::n_2;
-      case XK_3: return keys::n_3;
-      case XK_4: return keys::n_4;
-      case XK_5: return keys::n_5;
-      case XK_6: return keys::n_6;
-      case XK_7: return keys::n_7;
-      case XK_8: return keys::n_8;
-      case XK_9: return keys::n_9;
-      default  : break;
-    }
-
-    switch (keysym) {
-      case XK_Control_L: return keys::left_control;
-      case XK_Shift_L  : return keys::left_shift;
-      case XK_Alt_L    : return keys::left_alt;
-      case XK_Super_L  : [[fallthrough]];
-      case XK_Meta_L   : return keys::left_system;
-
-      case XK_Control_R: return keys::right_control;
-      case XK_Shift_R  : return keys::right_shift;
-      case XK_Alt_R    : return keys::right_alt;
-      case XK_Super_R  : [[fallthrough]];
-      case XK_Meta_R   : return keys::right_system;
-      default          : break;
-    }
-
-    switch (keysym) {
-      // arrows
-      case XK_Left       : return keys::left;
-      case XK_Right      : return keys::right;
-      case XK_Up         : return keys::up;
-      case XK_Down       : return keys::down;
-
-      // navigation
-      case XK_Escape     : return keys::escape;
-      case XK_Menu       : return keys::menu;
-      case XK_Page_Up    : return keys::pageup;
-      case XK_Page_Down  : return keys::pagedown;
-      case XK_End        : return keys::end;
-      case XK_Home       : return keys::home;
-      case XK_Insert     : return keys::insert;
-      case XK_Delete     : return keys::del;
-
-      // punctuation
-      case XK_semicolon  : return keys::semicolon;
-      case XK_comma      : return keys::comma;
-      case XK_period     : return keys::period;
-      case XK_apostrophe : return keys::apostrophe;
-      case XK_quotedbl   : return keys::quote;
-      case XK_slash      : return keys::slash;
-      case XK_backslash  : return keys::backslash;
-      case XK_grave      : return keys::tilde;
-      case XK_equal      : return keys::equal;
-      case XK_minus      : return keys::minus;
-      case XK_space      : return keys::space;
-
-      // enter / editing
-      case XK_Return     : return keys::enter;
-      case XK_BackSpace  : return keys::backspace;
-      case XK_Tab        : return keys::tab;
-
-      // misc
-      case XK_Pause      : return keys::pause;
-      case XK_Print      : return keys::print_screen;
-      case XK_Scroll_Lock: return keys::scroll_lock;
-      case XK_Caps_Lock  : return keys::caps_lock;
-      case XK_Num_Lock   : return keys::num_lock;
-
-      default            : break;
-    }
-
-    switch (keysym) {
-      case XK_KP_0       : return keys::numpad_0;
-      case XK_KP_1       : return keys::numpad_1;
-      case XK_KP_2       : return keys::numpad_2;
-      case XK_KP_3       : return keys::numpad_3;
-      case XK_KP_4       : return keys::numpad_4;
-      case XK_KP_5       : return keys::numpad_5;
-      case XK_KP_6       : return keys::numpad_6;
-      case XK_KP_7       : return keys::numpad_7;
-      case XK_KP_8       : return keys::numpad_8;
-      case XK_KP_9       : return keys::numpad_9;
-
-      case XK_KP_Add     : return keys::add;
-      case XK_KP_Subtract: return keys::subtract;
-      case XK_KP_Multiply: return keys::multiply;
-      case XK_KP_Divide  : return keys::divide;
-      case XK_KP_Enter   : return keys::enter;
-      case XK_KP_Decimal : return keys::decimal;
-
-      default            : break;
-    }
-
-    switch (keysym) {
-      case XK_F1 : return keys::f1;
-      case XK_F2 : return keys::f2;
-      case XK_F3 : return keys::f3;
-      case XK_F4 : return keys::f4;
-      case XK_F5 : return keys::f5;
-      case XK_F6 : return keys::f6;
-      case XK_F7 : return keys::f7;
-      case XK_F8 : return keys::f8;
-      case XK_F9 : return keys::f9;
-      case XK_F10: return keys::f10;
-      case XK_F11: return keys::f11;
-      case XK_F12: return keys::f12;
-      case XK_F13: return keys::f13;
-      case XK_F14: return keys::f14;
-      case XK_F15: return keys::f15;
-
-      default    : break;
-    }
 
-    return keys::none;
+    auto const found{ keysym_to_key.find(keysym) };
+    return found ? found->value : keys::none;
   }
 };
 
@@ -1,32 +1,180 @@
 #include "gzn/fnd/allocators.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
 
 #include <mimalloc.h>
 
+#if defined(GZN_PLATFORM_LINUX)
+#  include <sys/mman.h>
+#endif
+
 #include "gzn/fnd/assert.hpp"
 
 namespace gzn::fnd {
 
+namespace {
+
+usize constexpr g_huge_page_bytes_count{ 2 * 1024 * 1024 };
+usize constexpr g_numa_nodes_max_count{ 64 };
+
+/// 1 GiB huge OS pages reserved on a node by its first bound allocation,
+/// none unless asked for: they stay pinned for the process lifetime
+std::atomic<u32> g_numa_arena_huge_pages_count{ 0 };
+
+/// Asks the kernel to back the whole huge pages inside the block with
+/// transparent huge pages.
+void advise_huge_pages(
+  [[maybe_unused]] void *memory,
+  [[maybe_unused]] usize bytes_count
+) {
+#if defined(GZN_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+  auto constexpr page{ g_huge_page_bytes_count };
+  auto const address{ reinterpret_cast<uintptr_t>(memory) };
+  auto const first{ (address + page - 1) & ~(page - 1) };
+  auto const last{ (address + bytes_count) & ~(page - 1) };
+  if (first < last) {
+    madvise(reinterpret_cast<void *>(first), last - first, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+enum class arena_state : u8 {
+  unknown,
+  reserved,
+  unavailable,
+};
+
+struct numa_arena {
+  std::atomic<arena_state> state{ arena_state::unknown };
+  mi_arena_id_t            id{};
+};
+
+std::array<numa_arena, g_numa_nodes_max_count> g_numa_arenas{};
+std::mutex                                              g_numa_mutex{};
+
+[[nodiscard]]
+auto get_numa_arena(u32 const node) -> numa_arena const * {
+  auto &arena{ g_numa_arenas[node] };
+  if (auto const state{ arena.state.load(std::memory_order_acquire) };
+      state != arena_state::unknown) [[likely]] {
+    return state == arena_state::reserved ? &arena : nullptr;
+  }
+
+  std::scoped_lock lock{ g_numa_mutex };
+  if (arena.state.load(std::memory_order_relaxed) == arena_state::unknown) {
+    auto state{ arena_state::unavailable };
+    if (auto const pages_count{
+          g_numa_arena_huge_pages_count.load(std::memory_order_relaxed)
+        };
+        pages_count != 0) {
+      auto const error{ mi_reserve_huge_os_pages_at_ex(
+        pages_count, static_cast<int>(node), 0, true, &arena.id
+      ) };
+      if (error == 0) {
+        state = arena_state::reserved;
+      } else {
+        std::fprintf(
+          stderr,
+          "[gzn] can't reserve %u huge pages on NUMA node %u (error %d), "
+          "falling back to the node-local default\n",
+          pages_count,
+          node,
+          error
+        );
+      }
+    }
+    arena.state.store(state, std::memory_order_release);
+  }
+  return arena.state.load(std::memory_order_relaxed) == arena_state::reserved
+         ? &arena
+         : nullptr;
+}
+
+/// mimalloc heaps may only allocate on their own thread, so every thread
+/// keeps one heap per NUMA node it asked for.
+[[nodiscard]]
+auto get_numa_heap(u32 const node) -> mi_heap_t * {
+  thread_local std::array<mi_heap_t *, g_numa_nodes_max_count>
+    heaps{};
+
+  if (node >= g_numa_nodes_max_count) { return nullptr; }
+  if (auto heap{ heaps[node] }; heap) [[likely]] { return heap; }
+
+  if (auto arena{ get_numa_arena(node) }; arena) {
+    heaps[node] = mi_heap_new_in_arena(arena->id);
+  }
+  return heaps[node];
+}
+
+[[nodiscard]]
+auto allocate_with_flags(
+  u32 const bytes_count,
+  u32       alignment,
+  u32 const offset,
+  u32 const flags
+) -> void * {
+  auto const is_huge{ (flags & allocation_flags::huge_pages) != 0 &&
+                      bytes_count >= g_huge_page_bytes_count };
+  if (is_huge && offset == 0) {
+    alignment = std::max<u32>(alignment, g_huge_page_bytes_count);
+  }
+
+  auto const zeroed{ (flags & allocation_flags::zeroed) != 0 };
+  void      *memory{ nullptr };
+  if ((flags & allocation_flags::numa_bound) != 0) {
+    if (auto heap{ get_numa_heap(allocation_flags::numa_node_of(flags)) };
+        heap) {
+      memory = zeroed ? mi_heap_zalloc_aligned_at(
+                          heap, bytes_count, alignment, offset
+                        )
+                      : mi_heap_malloc_aligned_at(
+                          heap, bytes_count, alignment, offset
+                        );
+    }
+  }
+
+  if (memory == nullptr) {
+    memory = zeroed ? mi_zalloc_aligned_at(bytes_count, alignment, offset)
+                    : mi_malloc_aligned_at(bytes_count, alignment, offset);
+  }
+
+  if (memory != nullptr && is_huge) { advise_huge_pages(memory, bytes_count); }
+  return memory;
+}
+
+} // namespace
+
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-= base_allocator =-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 // //
 //
-auto base_allocator::allocate(
-  u32 const bytes_count,
-  [[maybe_unused]] u32 const
-) -> void * {
+auto base_allocator::allocate(u32 const bytes_count, u32 const flags)
+  -> void * {
   gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
-  return mi_malloc(bytes_count);
+  if (flags == allocation_flags::none) [[likely]] {
+    return mi_malloc(bytes_count);
+  }
+  return allocate_with_flags(
+    bytes_count, alignof(std::max_align_t), 0, flags
+  );
 }
 
 auto base_allocator::allocate(
   u32 const bytes_count,
   u32 const alignment,
   u32 const offset,
-  [[maybe_unused]] u32 const
+  u32 const flags
 ) -> void * {
   gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
-  return mi_malloc_aligned_at(bytes_count, alignment, offset);
+  if (flags == allocation_flags::none) [[likely]] {
+    return mi_malloc_aligned_at(bytes_count, alignment, offset);
+  }
+  return allocate_with_flags(bytes_count, alignment, offset, flags);
 }
 
 void base_allocator::deallocate(void *memory, [[maybe_unused]] u32 const) {
@@ -39,4 +187,31 @@ void base_allocator::deallocate(void *memory, u32 count, u32 alignment) {
   mi_free_size_aligned(memory, count, alignment);
 }
 
+void base_allocator::set_numa_reservation(u32 const huge_pages_count) {
+  g_numa_arena_huge_pages_count.store(
+    huge_pages_count, std::memory_order_relaxed
+  );
+}
+
+auto base_allocator::try_expand(
+  void     *memory,
+  u32 const bytes_count,
+  u32 const new_bytes_count
+) -> bool {
+  gzn_assertion(memory != nullptr, "Attempt to expand nullptr!");
+  if (new_bytes_count < bytes_count) { return false; }
+  return mi_expand(memory, new_bytes_count) != nullptr;
+}
+
+auto base_allocator::reallocate(
+  void *memory,
+  [[maybe_unused]] u32 const,
+  u32 const new_bytes_count,
+  u32 const alignment
+) -> void * {
+  gzn_assertion(memory != nullptr, "Attempt to reallocate nullptr!");
+  gzn_assertion(new_bytes_count != 0, "Meaningless reallocate(?, ?, 0) call");
+  return mi_realloc_aligned(memory, new_bytes_count, alignment);
+}
+
 } // namespace gzn::fnd
@@ -0,0 +1,57 @@
+#include "gzn/fnd/allocators/context.hpp"
+
+#include <array>
+
+#include "gzn/fnd/assert.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+struct context_stack {
+  std::array<any_allocator, constants::allocator_context_max_depth> entries{};
+  usize                                                             depth{};
+
+  /// Pushes past the maximum depth, only counted so pops stay balanced
+  usize overflow_count{};
+};
+
+thread_local context_stack g_context{};
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-= allocator_context =-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+auto allocator_context::current() noexcept -> any_allocator {
+  auto const &context{ g_context };
+  if (context.depth == 0) [[likely]] { return {}; }
+  return context.entries[context.depth - 1];
+}
+
+void allocator_context::push(any_allocator const allocator) noexcept {
+  auto &context{ g_context };
+  if (context.depth == constants::allocator_context_max_depth) [[unlikely]] {
+    gzn_do_assertion("Allocator context stack overflow");
+    ++context.overflow_count;
+    return;
+  }
+  context.entries[context.depth++] = allocator;
+}
+
+void allocator_context::pop() noexcept {
+  auto &context{ g_context };
+  if (context.overflow_count != 0) [[unlikely]] {
+    --context.overflow_count;
+    return;
+  }
+  if (context.depth == 0) [[unlikely]] {
+    gzn_do_assertion("Allocator context stack underflow");
+    return;
+  }
+  context.entries[--context.depth] = {};
+}
+
+auto allocator_context::depth() noexcept -> usize { return g_context.depth; }
+
+} // namespace gzn::fnd
@@ -0,0 +1,262 @@
+#include "gzn/fnd/allocators/slab.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "gzn/fnd/assert.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+// clang-format off
+std::array<u32, 20> constexpr g_size_classes{
+   16,  32,  48,  64,  80,  96, 112, 128,
+  160, 192, 224, 256,
+  320, 384, 448, 512,
+  640, 768, 896, 1024,
+};
+// clang-format on
+
+usize constexpr g_size_classes_count{ std::size(g_size_classes) };
+
+gzn_static_assert(
+  g_size_classes.back() == constants::slab_max_block_bytes_count,
+  "The biggest size class must match slab_max_block_bytes_count"
+);
+
+auto constexpr g_class_lookup{ [] {
+  auto constexpr granularity{ constants::slab_block_alignment };
+  std::array<u8, constants::slab_max_block_bytes_count / granularity + 1>
+    lookup{};
+
+  usize size_class{};
+  for (usize i{ 1 }; i < std::size(lookup); ++i) {
+    while (g_size_classes[size_class] < i * granularity) { ++size_class; }
+    lookup[i] = static_cast<u8>(size_class);
+  }
+  return lookup;
+}() };
+
+gzn_inline constexpr auto size_class_of(u32 const bytes_count) noexcept
+  -> usize {
+  auto constexpr granularity{ constants::slab_block_alignment };
+  return g_class_lookup[(bytes_count + granularity - 1) / granularity];
+}
+
+struct free_block {
+  free_block *next;
+};
+
+struct alignas(constants::cache_line_bytes) size_class_bin {
+  free_block *local{ nullptr };
+  byte       *bump{ nullptr };
+  byte       *bump_end{ nullptr };
+
+  alignas(constants::cache_line_bytes) std::atomic<free_block *> remote{};
+};
+
+struct thread_heap;
+
+struct slab_header {
+  thread_heap *owner{ nullptr };
+  slab_header *next{ nullptr };
+};
+
+usize constexpr g_slab_payload_offset{ util::memory_align(
+  sizeof(slab_header),
+  constants::slab_block_alignment
+) };
+
+struct thread_heap {
+  std::array<size_class_bin, g_size_classes_count> bins{};
+  slab_header                                     *slabs{ nullptr };
+  thread_heap                                     *next_abandoned{ nullptr };
+};
+
+base_allocator g_backing{ "slab_allocator::backing" };
+
+std::mutex   g_abandoned_mutex{};
+thread_heap *g_abandoned{ nullptr };
+
+thread_local thread_heap *g_heap{ nullptr };
+
+[[nodiscard]]
+auto acquire_heap() -> thread_heap * {
+  {
+    std::scoped_lock lock{ g_abandoned_mutex };
+    if (auto heap{ g_abandoned }; heap) {
+      g_abandoned          = heap->next_abandoned;
+      heap->next_abandoned = nullptr;
+      return heap;
+    }
+  }
+
+  auto memory{ g_backing.allocate(
+    sizeof(thread_heap), alignof(thread_heap), 0u
+  ) };
+  return memory ? new (memory) thread_heap{} : nullptr;
+}
+
+/// Heaps are never released: other threads may still hold blocks carved from
+/// their slabs. The next thread to start adopts the abandoned heap instead.
+void abandon_heap(thread_heap *heap) {
+  if (heap == nullptr) { return; }
+
+  std::scoped_lock lock{ g_abandoned_mutex };
+  heap->next_abandoned = g_abandoned;
+  g_abandoned          = heap;
+}
+
+struct thread_heap_guard {
+  thread_heap *heap{ acquire_heap() };
+
+  ~thread_heap_guard() {
+    g_heap = nullptr;
+    abandon_heap(std::exchange(heap, nullptr));
+  }
+};
+
+[[nodiscard]]
+gzn_inline auto get_heap() -> thread_heap * {
+  if (g_heap != nullptr) [[likely]] { return g_heap; }
+
+  thread_local thread_heap_guard guard{};
+  g_heap = guard.heap;
+  return g_heap;
+}
+
+[[nodiscard]]
+gzn_inline auto slab_of(void *memory) noexcept -> slab_header * {
+  auto const address{ reinterpret_cast<uintptr_t>(memory) };
+  return reinterpret_cast<slab_header *>(
+    address & ~(uintptr_t{ constants::slab_bytes_count } - 1)
+  );
+}
+
+[[nodiscard]]
+auto refill_bin(thread_heap &heap, size_class_bin &bin) -> bool {
+  auto memory{ static_cast<byte *>(g_backing.allocate(
+    constants::slab_bytes_count, constants::slab_bytes_count, 0u
+  )) };
+  if (memory == nullptr) { return false; }
+
+  auto slab{ new (memory) slab_header{ .owner = &heap, .next = heap.slabs } };
+  heap.slabs   = slab;
+  bin.bump     = memory + g_slab_payload_offset;
+  bin.bump_end = memory + constants::slab_bytes_count;
+  return true;
+}
+
+[[nodiscard]]
+auto allocate_slow(thread_heap &heap, usize const size_class) -> void * {
+  auto &bin{ heap.bins[size_class] };
+
+  if (auto remote{ bin.remote.exchange(nullptr, std::memory_order_acquire) };
+      remote) {
+    bin.local = remote->next;
+    return remote;
+  }
+
+  auto const block_size{ g_size_classes[size_class] };
+  if (bin.bump + block_size > bin.bump_end) {
+    if (!refill_bin(heap, bin)) { return nullptr; }
+  }
+  return std::exchange(bin.bump, bin.bump + block_size);
+}
+
+[[nodiscard]]
+gzn_inline auto allocate_small(u32 const bytes_count) -> void * {
+  auto heap{ get_heap() };
+  if (heap == nullptr) [[unlikely]] { return nullptr; }
+
+  auto const size_class{ size_class_of(bytes_count) };
+  auto      &bin{ heap->bins[size_class] };
+  if (auto block{ bin.local }; block) [[likely]] {
+    bin.local = block->next;
+    return block;
+  }
+  return allocate_slow(*heap, size_class);
+}
+
+/// Slab blocks are always aligned to @ref constants::slab_block_alignment,
+/// a block for an offset breaking a smaller alignment never is: it comes
+/// from the backing allocator.
+[[nodiscard]]
+gzn_inline auto is_slab_block(void *memory) noexcept -> bool {
+  auto const address{ reinterpret_cast<uintptr_t>(memory) };
+  return address % constants::slab_block_alignment == 0;
+}
+
+gzn_inline void deallocate_small(void *memory, u32 const bytes_count) {
+  auto const size_class{ size_class_of(bytes_count) };
+  auto       owner{ slab_of(memory)->owner };
+  auto       block{ static_cast<free_block *>(memory) };
+
+  if (owner == g_heap) [[likely]] {
+    auto &bin{ owner->bins[size_class] };
+    block->next = bin.local;
+    bin.local   = block;
+    return;
+  }
+
+  auto &remote{ owner->bins[size_class].remote };
+  block->next = remote.load(std::memory_order_relaxed);
+  while (!remote.compare_exchange_weak(
+    block->next, block, std::memory_order_release, std::memory_order_relaxed
+  )) {}
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-= slab_allocator =-=-=-=-=-=-=-=-=-=-=-=-=-=-= //
+
+auto slab_allocator::allocate(u32 const bytes_count, u32 const flags)
+  -> void * {
+  gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+  if (is_slab_sized(bytes_count)) [[likely]] {
+    return allocate_small(bytes_count);
+  }
+  return g_backing.allocate(bytes_count, flags);
+}
+
+auto slab_allocator::allocate(
+  u32 const bytes_count,
+  u32 const alignment,
+  u32 const offset,
+  u32 const flags
+) -> void * {
+  gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+  if (is_slab_sized(bytes_count, alignment) && offset % alignment == 0)
+    [[likely]] {
+    return allocate_small(bytes_count);
+  }
+  return g_backing.allocate(bytes_count, alignment, offset, flags);
+}
+
+void slab_allocator::deallocate(void *memory, u32 const count) {
+  gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+  if (is_slab_sized(count) && is_slab_block(memory)) [[likely]] {
+    deallocate_small(memory, count);
+  } else {
+    g_backing.deallocate(memory, count);
+  }
+}
+
+void slab_allocator::deallocate(
+  void     *memory,
+  u32 const count,
+  u32 const alignment
+) {
+  gzn_assertion(memory != nullptr, "Attempt to deallocate nullptr!");
+  if (is_slab_sized(count, alignment) && is_slab_block(memory)) [[likely]] {
+    deallocate_small(memory, count);
+  } else {
+    g_backing.deallocate(memory, count, alignment);
+  }
+}
+
+} // namespace gzn::fnd
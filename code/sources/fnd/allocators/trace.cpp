@@ -0,0 +1,107 @@
+#include "gzn/fnd/allocators/trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+
+namespace gzn::fnd {
+
+namespace {
+
+std::atomic<allocation_trace_sink> g_sink{ nullptr };
+std::atomic<void *>                g_sink_user_data{ nullptr };
+std::atomic<u32>                   g_threads_count{};
+
+[[nodiscard]]
+auto thread_index() noexcept -> u32 {
+  thread_local u32 const index{
+    g_threads_count.fetch_add(1, std::memory_order_relaxed)
+  };
+  return index;
+}
+
+[[nodiscard]]
+auto now_ns() noexcept -> u64 {
+  using namespace std::chrono;
+  return static_cast<u64>(
+    duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count()
+  );
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-= allocation_trace =-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+void allocation_trace::set_sink(
+  allocation_trace_sink const sink,
+  void                       *user_data
+) {
+  g_sink_user_data.store(user_data, std::memory_order_relaxed);
+  g_sink.store(sink, std::memory_order_release);
+}
+
+auto allocation_trace::is_enabled() noexcept -> bool {
+  return g_sink.load(std::memory_order_relaxed) != nullptr;
+}
+
+void allocation_trace::emit(
+  allocation_event_kind const kind,
+  void const                 *memory,
+  u32 const                   bytes_count,
+  u32 const                   alignment
+) {
+  auto const sink{ g_sink.load(std::memory_order_acquire) };
+  if (sink == nullptr) { return; }
+
+  allocation_event const event{
+    .kind         = kind,
+    .thread_index = thread_index(),
+    .bytes_count  = bytes_count,
+    .alignment    = alignment,
+    .id           = reinterpret_cast<uintptr_t>(memory),
+    .timestamp_ns = now_ns(),
+  };
+  sink(event, g_sink_user_data.load(std::memory_order_relaxed));
+}
+
+void allocation_trace::write_to_file(
+  allocation_event const &event,
+  void                   *user_data
+) {
+  std::fprintf(
+    static_cast<std::FILE *>(user_data),
+    "%c %" PRIx64 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu64 "\n",
+    event.kind == allocation_event_kind::allocate ? 'a' : 'd',
+    event.id,
+    event.bytes_count,
+    event.alignment,
+    event.thread_index,
+    event.timestamp_ns
+  );
+}
+
+auto allocation_trace::read_from_file(
+  std::FILE        *file,
+  allocation_event &event
+) -> bool {
+  char kind{};
+  auto const count{ std::fscanf(
+    file,
+    " %c %" SCNx64 " %" SCNu32 " %" SCNu32 " %" SCNu32 " %" SCNu64,
+    &kind,
+    &event.id,
+    &event.bytes_count,
+    &event.alignment,
+    &event.thread_index,
+    &event.timestamp_ns
+  ) };
+  if (count != 6 || (kind != 'a' && kind != 'd')) { return false; }
+
+  event.kind = kind == 'a' ? allocation_event_kind::allocate
+                           : allocation_event_kind::deallocate;
+  return true;
+}
+
+} // namespace gzn::fnd
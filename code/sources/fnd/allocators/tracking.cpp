@@ -0,0 +1,122 @@
+#include "gzn/fnd/allocators/tracking.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <span>
+
+#include "gzn/fnd/assert.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+std::array<allocation_stats, constants::allocation_registry_capacity>
+                   g_entries{};
+std::atomic<usize> g_entries_count{};
+std::mutex         g_registration_mutex{};
+
+[[nodiscard]]
+auto registered_entries() noexcept -> std::span<allocation_stats> {
+  return std::span{ g_entries }.first(
+    g_entries_count.load(std::memory_order_acquire)
+  );
+}
+
+/// Cuts `label` the way it is stored, so long labels still match their entry
+[[nodiscard]]
+auto stored_label(std::string_view const label) noexcept -> std::string_view {
+  return label.substr(0, constants::allocation_label_max_length);
+}
+
+void print_stats(std::FILE *out, allocation_stats const &stats) {
+  std::fprintf(
+    out,
+    "%-32s live: %12llu | peak: %12llu | total: %14llu | "
+    "allocations: %10llu | deallocations: %10llu\n",
+    std::data(stats.label),
+    static_cast<unsigned long long>(stats.live_bytes_count.load()),
+    static_cast<unsigned long long>(stats.peak_bytes_count.load()),
+    static_cast<unsigned long long>(stats.total_bytes_count.load()),
+    static_cast<unsigned long long>(stats.allocations_count.load()),
+    static_cast<unsigned long long>(stats.deallocations_count.load())
+  );
+
+  for (usize i{}; i < std::size(stats.histogram); ++i) {
+    auto const count{ stats.histogram[i].load(std::memory_order_relaxed) };
+    if (count == 0) { continue; }
+
+    auto const upper_bound{ constants::allocation_histogram_min_bytes_count
+                            << i };
+    if (i + 1 == std::size(stats.histogram)) {
+      std::fprintf(out, "    > %10llu B: %llu\n",
+        static_cast<unsigned long long>(upper_bound >> 1),
+        static_cast<unsigned long long>(count));
+    } else {
+      std::fprintf(out, "   <= %10llu B: %llu\n",
+        static_cast<unsigned long long>(upper_bound),
+        static_cast<unsigned long long>(count));
+    }
+  }
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-= allocation_registry =-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+auto allocation_registry::find(std::string_view const label) noexcept
+  -> allocation_stats * {
+  auto entries{ registered_entries() };
+  auto found{ std::ranges::find(
+    entries, stored_label(label), &allocation_stats::get_label
+  ) };
+  return found != std::end(entries) ? &*found : nullptr;
+}
+
+auto allocation_registry::find_or_register(std::string_view const label)
+  -> allocation_stats * {
+  if (auto stats{ find(label) }; stats) [[likely]] { return stats; }
+
+  std::scoped_lock lock{ g_registration_mutex };
+  if (auto stats{ find(label) }; stats) { return stats; }
+
+  auto const index{ g_entries_count.load(std::memory_order_relaxed) };
+  if (index == std::size(g_entries)) {
+    gzn_do_assertion("allocation_registry is full");
+    return nullptr;
+  }
+
+  auto &stats{ g_entries[index] };
+  auto const stored{ stored_label(label) };
+  std::ranges::copy(stored, std::begin(stats.label));
+  stats.label[std::size(stored)] = '\0';
+
+  g_entries_count.store(index + 1, std::memory_order_release);
+  return &stats;
+}
+
+void allocation_registry::report(std::FILE *out) {
+  std::fprintf(out, "[gzn] allocations report:\n");
+  for (auto const &stats : registered_entries()) { print_stats(out, stats); }
+}
+
+auto allocation_registry::report_leaks(std::FILE *out) -> usize {
+  usize leaking_labels_count{};
+  for (auto const &stats : registered_entries()) {
+    if (!stats.has_leaks()) { continue; }
+
+    if (leaking_labels_count++ == 0) {
+      std::fprintf(out, "[gzn] memory leaks detected:\n");
+    }
+    print_stats(out, stats);
+  }
+  return leaking_labels_count;
+}
+
+void allocation_registry::enable_leak_report_at_exit() {
+  static std::once_flag registered{};
+  std::call_once(registered, [] { std::atexit([] { report_leaks(); }); });
+}
+
+} // namespace gzn::fnd
@@ -0,0 +1,179 @@
+#include "gzn/fnd/allocators/virtual-arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(GZN_PLATFORM_WINDOWS)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#endif
+
+#include "gzn/fnd/assert.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+[[nodiscard]]
+constexpr auto align_up(usize const value, usize const alignment) noexcept
+  -> usize {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]]
+auto reserve_pages(usize const bytes_count) noexcept -> byte * {
+#if defined(GZN_PLATFORM_WINDOWS)
+  return static_cast<byte *>(
+    VirtualAlloc(nullptr, bytes_count, MEM_RESERVE, PAGE_NOACCESS)
+  );
+#else
+  auto memory{ mmap(
+    nullptr,
+    bytes_count,
+    PROT_NONE,
+    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+    -1,
+    0
+  ) };
+  return memory != MAP_FAILED ? static_cast<byte *>(memory) : nullptr;
+#endif
+}
+
+void release_pages(byte *memory, usize const bytes_count) noexcept {
+#if defined(GZN_PLATFORM_WINDOWS)
+  (void)bytes_count;
+  VirtualFree(memory, 0, MEM_RELEASE);
+#else
+  munmap(memory, bytes_count);
+#endif
+}
+
+[[nodiscard]]
+auto commit_pages(byte *memory, usize const bytes_count) noexcept -> bool {
+#if defined(GZN_PLATFORM_WINDOWS)
+  return VirtualAlloc(memory, bytes_count, MEM_COMMIT, PAGE_READWRITE) !=
+         nullptr;
+#else
+  return mprotect(memory, bytes_count, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void decommit_pages(byte *memory, usize const bytes_count) noexcept {
+#if defined(GZN_PLATFORM_WINDOWS)
+  VirtualFree(memory, bytes_count, MEM_DECOMMIT);
+#else
+  madvise(memory, bytes_count, MADV_DONTNEED);
+  mprotect(memory, bytes_count, PROT_NONE);
+#endif
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-= virtual_arena_allocator =-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+virtual_arena_allocator::virtual_arena_allocator(
+  usize const reserve_bytes_count,
+  cstr const  label
+) noexcept
+  : m_label{ label } {
+  auto const bytes_count{ align_up(
+    reserve_bytes_count, constants::virtual_arena_commit_bytes_count
+  ) };
+  m_data = reserve_pages(bytes_count);
+  gzn_assertion(m_data != nullptr, "Failed to reserve virtual memory");
+  m_reserved = m_data ? bytes_count : 0;
+}
+
+virtual_arena_allocator::~virtual_arena_allocator() { release(); }
+
+auto virtual_arena_allocator::operator=(virtual_arena_allocator &&other
+) noexcept -> virtual_arena_allocator & {
+  if (this != &other) {
+    release();
+    m_data      = std::exchange(other.m_data, nullptr);
+    m_top       = std::exchange(other.m_top, usize{});
+    m_committed = std::exchange(other.m_committed, usize{});
+    m_reserved  = std::exchange(other.m_reserved, usize{});
+    m_label     = other.m_label;
+  }
+  return *this;
+}
+
+auto virtual_arena_allocator::allocate(u32 const bytes_count, u32 const flags)
+  -> void * {
+  return allocate(bytes_count, alignof(std::max_align_t), 0, flags);
+}
+
+auto virtual_arena_allocator::allocate(
+  u32 const                  bytes_count,
+  u32 const                  alignment,
+  u32 const                  offset,
+  [[maybe_unused]] u32 const flags
+) -> void * {
+  gzn_assertion(bytes_count != 0, "Meaningless allocate(0, ?) call");
+  gzn_assertion(
+    alignment != 0 && (alignment & (alignment - 1)) == 0,
+    "Alignment must be a power of 2"
+  );
+
+  auto const address{ reinterpret_cast<uintptr_t>(m_data) + m_top };
+  auto const misalignment{ (address + offset) & (alignment - 1) };
+  auto const padding{ (alignment - misalignment) & (alignment - 1) };
+  auto const new_top{ m_top + padding + bytes_count };
+
+  if (new_top > m_committed && !commit(new_top)) [[unlikely]] {
+    gzn_do_assertion("Not enough reserved memory for this allocation");
+    return nullptr;
+  }
+  return m_data + std::exchange(m_top, new_top) + padding;
+}
+
+auto virtual_arena_allocator::try_expand(
+  void     *memory,
+  u32 const bytes_count,
+  u32 const new_bytes_count
+) -> bool {
+  auto const begin{ static_cast<byte *>(memory) - m_data };
+  if (begin < 0 || static_cast<usize>(begin) + bytes_count != m_top) {
+    return false;
+  }
+
+  auto const new_top{ static_cast<usize>(begin) + new_bytes_count };
+  if (new_top > m_committed && !commit(new_top)) { return false; }
+
+  m_top = new_top;
+  return true;
+}
+
+void virtual_arena_allocator::reset() {
+  if (m_committed != 0) { decommit_pages(m_data, m_committed); }
+  m_top       = 0;
+  m_committed = 0;
+}
+
+auto virtual_arena_allocator::commit(usize const top) -> bool {
+  if (top > m_reserved) { return false; }
+
+  auto const committed{ std::min(
+    align_up(top, constants::virtual_arena_commit_bytes_count), m_reserved
+  ) };
+  if (!commit_pages(m_data + m_committed, committed - m_committed)) {
+    return false;
+  }
+  m_committed = committed;
+  return true;
+}
+
+void virtual_arena_allocator::release() {
+  if (m_data != nullptr) { release_pages(m_data, m_reserved); }
+  m_data      = nullptr;
+  m_top       = 0;
+  m_committed = 0;
+  m_reserved  = 0;
+}
+
+} // namespace gzn::fnd
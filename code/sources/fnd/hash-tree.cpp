@@ -0,0 +1,89 @@
+#include "gzn/fnd/hash-tree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+#include "gzn/fnd/allocators.hpp"
+#include "gzn/fnd/assert.hpp"
+#include "gzn/fnd/containers/dynamic-array.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+struct leaf_job {
+  hash_tree_params const &in;
+  std::span<u64>          digests;
+  std::atomic<usize>      next_leaf{};
+
+  /// Leaves are taken one at a time, so a thread stalled on a page fault
+  /// of a mapped file doesn't hold back the others
+  void run() noexcept {
+    auto const leaves_count{ std::size(digests) };
+    for (auto leaf{ next_leaf.fetch_add(1, std::memory_order_relaxed) };
+         leaf < leaves_count;
+         leaf = next_leaf.fetch_add(1, std::memory_order_relaxed)) {
+      auto const offset{ leaf * in.leaf_bytes };
+      auto const bytes_count{
+        std::min(in.leaf_bytes, std::size(in.data) - offset)
+      };
+      auto const digest{ hash<byte>({
+        .key    = in.data.subspan(offset, bytes_count),
+        .secret = in.secret,
+        .seed   = in.seed ^ leaf,
+      }) };
+
+      // Digests are combined as little-endian bytes on every platform
+      if constexpr (std::endian::native == std::endian::big) {
+        digests[leaf] = std::byteswap(digest);
+      } else {
+        digests[leaf] = digest;
+      }
+    }
+  }
+};
+
+[[nodiscard]]
+auto threads_count_of(hash_tree_params const &in, usize const leaves_count)
+  -> usize {
+  usize threads_count{ in.threads_count };
+  if (threads_count == 0) {
+    threads_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  return std::min(threads_count, leaves_count);
+}
+
+} // namespace
+
+auto hash_tree(hash_tree_params const &in) -> u64 {
+  gzn_assertion(in.leaf_bytes > 0, "Leaves should not be empty");
+
+  auto const bytes_count{ std::size(in.data) };
+  auto const leaves_count{
+    std::max((bytes_count + in.leaf_bytes - 1) / in.leaf_bytes, usize{ 1 })
+  };
+
+  base_allocator     alloc{ "hash_tree" };
+  dynamic_array<u64> digests{ alloc, leaves_count };
+  digests.emplace_back_n(leaves_count, u64{});
+
+  leaf_job job{ .in = in, .digests = { std::data(digests), leaves_count } };
+  {
+    auto const helpers_count{ threads_count_of(in, leaves_count) - 1 };
+    dynamic_array<std::jthread> helpers{ alloc, helpers_count };
+    for (usize i{}; i < helpers_count; ++i) {
+      helpers.emplace_back([&job] { job.run(); });
+    }
+    job.run();
+  } // joins the helpers
+
+  return hash<byte>({
+    .key    = std::as_bytes(job.digests),
+    .secret = in.secret,
+    .seed   = in.seed ^ bytes_count,
+  });
+}
+
+} // namespace gzn::fnd
@@ -0,0 +1,108 @@
+#include "gzn/fnd/mapped-file.hpp"
+
+#include <utility>
+
+#if defined(GZN_PLATFORM_WINDOWS)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace gzn::fnd {
+
+namespace {
+
+struct mapping {
+  byte const *data{ nullptr };
+  usize       size{};
+};
+
+/// The view keeps the file open, so the handles are closed right away
+[[nodiscard]]
+auto map_file(cstr const path) noexcept -> mapping {
+#if defined(GZN_PLATFORM_WINDOWS)
+  auto const file{ CreateFileA(
+    path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr
+  ) };
+  if (file == INVALID_HANDLE_VALUE) { return {}; }
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return {};
+  }
+
+  auto const file_mapping{
+    CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+  };
+  CloseHandle(file);
+  if (file_mapping == nullptr) { return {}; }
+
+  auto const view{ MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0) };
+  CloseHandle(file_mapping);
+  if (view == nullptr) { return {}; }
+
+  return { .data = static_cast<byte const *>(view),
+           .size = static_cast<usize>(size.QuadPart) };
+#else
+  auto const file{ open(path, O_RDONLY | O_CLOEXEC) };
+  if (file < 0) { return {}; }
+
+  struct stat status{};
+  if (fstat(file, &status) != 0 || status.st_size <= 0) {
+    close(file);
+    return {};
+  }
+
+  auto const size{ static_cast<usize>(status.st_size) };
+  auto const view{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+  close(file);
+  if (view == MAP_FAILED) { return {}; }
+
+  return { .data = static_cast<byte const *>(view), .size = size };
+#endif
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-= mapped_file =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-= //
+
+mapped_file::mapped_file(cstr const path) noexcept {
+  auto const [data, size]{ map_file(path) };
+  m_data = data;
+  m_size = size;
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept
+  : m_data{ std::exchange(other.m_data, nullptr) }
+  , m_size{ std::exchange(other.m_size, 0) } {}
+
+mapped_file::~mapped_file() { unmap(); }
+
+auto mapped_file::operator=(mapped_file &&other) noexcept -> mapped_file & {
+  if (this != &other) {
+    unmap();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+void mapped_file::unmap() noexcept {
+  if (m_data == nullptr) { return; }
+
+#if defined(GZN_PLATFORM_WINDOWS)
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<byte *>(m_data), m_size);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
+
+} // namespace gzn::fnd
@@ -0,0 +1,189 @@
+#include "gzn/fnd/name-table.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "gzn/fnd/allocators.hpp"
+#include "gzn/fnd/assert.hpp"
+
+namespace gzn::fnd {
+
+namespace {
+
+usize constexpr g_shards_count{ 64 };
+usize constexpr g_shard_initial_capacity{ 64 };
+u32 constexpr g_shard_index_shift{ 58 };
+
+/// Followed by `bytes_count` bytes of text in the same block
+struct name_entry {
+  u64   hash{};
+  usize bytes_count{};
+
+  [[nodiscard]]
+  auto text() const noexcept -> std::span<byte const> {
+    return { reinterpret_cast<byte const *>(this + 1), bytes_count };
+  }
+};
+
+/// Open-addressing slots of a shard. Growing publishes a new one and keeps
+/// the old one reachable through `previous`: readers may still probe it.
+struct shard_slots {
+  usize                            mask{};
+  std::atomic<name_entry const *> *slots{ nullptr };
+  shard_slots const               *previous{ nullptr };
+};
+
+struct alignas(constants::cache_line_bytes) shard {
+  std::atomic<shard_slots const *> slots{ nullptr };
+  std::atomic<usize>               count{};
+  std::mutex                       insert_mutex{};
+};
+
+std::array<shard, g_shards_count> g_shards{};
+
+[[nodiscard]]
+auto shard_of(u64 const hash) noexcept -> shard & {
+  return g_shards[hash >> g_shard_index_shift];
+}
+
+[[nodiscard]]
+auto allocate_immortal(usize const bytes_count, usize const alignment)
+  -> void * {
+  auto const memory{ base_allocator{ "name_table" }.allocate(
+    static_cast<u32>(bytes_count), static_cast<u32>(alignment), 0
+  ) };
+  gzn_assertion(memory != nullptr, "Failed to allocate the name table");
+  return memory;
+}
+
+[[nodiscard]]
+auto find_in(shard_slots const *table, u64 const hash) noexcept
+  -> name_entry const * {
+  if (table == nullptr) { return nullptr; }
+
+  for (auto index{ hash & table->mask };; index = (index + 1) & table->mask) {
+    auto const entry{ table->slots[index].load(std::memory_order_acquire) };
+    if (entry == nullptr || entry->hash == hash) { return entry; }
+  }
+}
+
+/// Only called under the shard's mutex, `table` has a free slot
+void place(shard_slots const *table, name_entry const *entry) noexcept {
+  auto index{ entry->hash & table->mask };
+  while (table->slots[index].load(std::memory_order_relaxed) != nullptr) {
+    index = (index + 1) & table->mask;
+  }
+  table->slots[index].store(entry, std::memory_order_release);
+}
+
+[[nodiscard]]
+auto make_slots(usize const capacity, shard_slots const *previous)
+  -> shard_slots const * {
+  auto const slots{ static_cast<std::atomic<name_entry const *> *>(
+    allocate_immortal(
+      capacity * sizeof(std::atomic<name_entry const *>),
+      alignof(std::atomic<name_entry const *>)
+    )
+  ) };
+  for (usize i{}; i < capacity; ++i) {
+    std::construct_at(slots + i, nullptr);
+  }
+
+  auto const table{ static_cast<shard_slots *>(
+    allocate_immortal(sizeof(shard_slots), alignof(shard_slots))
+  ) };
+  std::construct_at(table);
+  table->mask     = capacity - 1;
+  table->slots    = slots;
+  table->previous = previous;
+
+  if (previous != nullptr) {
+    for (usize i{}; i <= previous->mask; ++i) {
+      auto const entry{ previous->slots[i].load(std::memory_order_relaxed) };
+      if (entry != nullptr) { place(table, entry); }
+    }
+  }
+  return table;
+}
+
+[[nodiscard]]
+auto make_entry(u64 const hash, std::span<byte const> const text)
+  -> name_entry const * {
+  auto const entry{ static_cast<name_entry *>(allocate_immortal(
+    sizeof(name_entry) + std::size(text), alignof(name_entry)
+  )) };
+  std::construct_at(
+    entry, name_entry{ .hash = hash, .bytes_count = std::size(text) }
+  );
+  std::ranges::copy(text, reinterpret_cast<byte *>(entry + 1));
+  return entry;
+}
+
+void check_collision(
+  [[maybe_unused]] name_entry const           *entry,
+  [[maybe_unused]] std::span<byte const> const text
+) {
+  gzn_assertion(
+    std::ranges::equal(entry->text(), text),
+    "Name hash collision: two different texts share a hash"
+  );
+}
+
+} // namespace
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-= name_table =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-= //
+
+auto name_table::intern(u64 const hash, std::span<byte const> const text)
+  -> std::span<byte const> {
+  auto &target{ shard_of(hash) };
+  if (auto const found{ find_in(
+        target.slots.load(std::memory_order_acquire), hash
+      ) };
+      found != nullptr) [[likely]] {
+    check_collision(found, text);
+    return found->text();
+  }
+
+  std::lock_guard const lock{ target.insert_mutex };
+
+  auto table{ target.slots.load(std::memory_order_relaxed) };
+  if (auto const found{ find_in(table, hash) }; found != nullptr) {
+    check_collision(found, text);
+    return found->text();
+  }
+
+  // Keeps the load factor under 1/2 so probe chains stay short
+  auto const count{ target.count.load(std::memory_order_relaxed) };
+  if (table == nullptr || (count + 1) * 2 > table->mask + 1) {
+    auto const capacity{
+      table == nullptr ? g_shard_initial_capacity : 2 * (table->mask + 1)
+    };
+    table = make_slots(capacity, table);
+    target.slots.store(table, std::memory_order_release);
+  }
+
+  auto const entry{ make_entry(hash, text) };
+  place(table, entry);
+  target.count.store(count + 1, std::memory_order_relaxed);
+  return entry->text();
+}
+
+auto name_table::find(u64 const hash) noexcept -> std::span<byte const> {
+  auto const entry{ find_in(
+    shard_of(hash).slots.load(std::memory_order_acquire), hash
+  ) };
+  return entry == nullptr ? std::span<byte const>{} : entry->text();
+}
+
+auto name_table::size() noexcept -> usize {
+  usize count{};
+  for (auto const &target : g_shards) {
+    count += target.count.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+} // namespace gzn::fnd
@@ -67,23 +67,15 @@ static auto on_vulkan_error(
 
 } // namespace
 
-struct struct_sizes {
-  static constexpr auto pipeline_bytes_count{ sizeof(vk_pipeline) };
-  static constexpr auto buffer_bytes_count{ sizeof(vk_buffer) };
-};
-
-struct gen_counter_size {
-  static constexpr auto pipeline_bytes_count{ sizeof(fnd::gen_counter) };
-  static constexpr auto buffer_bytes_count{ sizeof(fnd::gen_counter) };
-};
-
+/// Carves the storage of consecutive resource pools
 struct offset_accumulator {
   std::span<byte> iter;
 
   template<class T>
   constexpr auto set(usize const count) noexcept {
-    auto place{ iter.subspan(0, count) };
-    iter = iter.subspan(count);
+    auto const bytes_count{ fnd::non_owning_pool<T>::get_size_for(count) };
+    auto       place{ iter.subspan(0, bytes_count) };
+    iter = iter.subspan(std::size(place));
     return place;
   }
 };
@@ -98,7 +90,10 @@ auto vulkan::is_available() -> bool {
 
 auto vulkan::calc_required_space_for(render_capacities const &caps) noexcept
   -> usize {
-  return caps.total_size<struct_sizes>() + caps.total_size<gen_counter_size>();
+  using fnd::non_owning_pool;
+  return non_owning_pool<vk_pipeline>::get_size_for(caps.pipelines_count) +
+         non_owning_pool<vk_buffer>::get_size_for(caps.buffers_count) +
+         non_owning_pool<vk_sampler>::get_size_for(caps.samples_count);
 }
 
 auto vulkan::make_context_on(
@@ -0,0 +1,521 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gzn/fnd/allocators.hpp>
+#include <gzn/fnd/allocators/block-pool.hpp>
+#include <gzn/fnd/allocators/buddy.hpp>
+#include <gzn/fnd/allocators/frame-arena.hpp>
+#include <gzn/fnd/allocators/slab.hpp>
+#include <gzn/fnd/allocators/trace.hpp>
+#include <gzn/fnd/allocators/virtual-arena.hpp>
+#include <mimalloc.h>
+#include <nanobench.h>
+
+#if defined(GZN_PLATFORM_LINUX)
+#  include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_memalign(size_t alignment, size_t bytes_count);
+void  __libc_free(void *memory);
+}
+#endif
+
+// Set to a file written with `allocation_trace::write_to_file` to replay a
+// trace recorded from the app next to the synthetic ones.
+char constexpr TRACE_ENV_VARIABLE[]{ "GZN_ALLOCATION_TRACE" };
+
+gzn::usize constexpr ARENA_BYTES_COUNT{ 256 * 1024 * 1024 };
+gzn::usize constexpr RSS_SAMPLE_PERIOD{ 4096 };
+gzn::u32 constexpr POOL_BLOCK_BYTES_COUNT{ 256 };
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-= traces =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+struct trace_op {
+  bool     allocate{};
+  gzn::u32 slot{};
+  gzn::u32 bytes_count{};
+  gzn::u32 alignment{};
+};
+
+/// Operations replayed by one thread. Blocks are freed by the thread which
+/// allocated them, whatever thread freed them in the recording.
+using thread_trace = std::vector<trace_op>;
+
+struct trace {
+  std::string               name;
+  std::vector<thread_trace> threads;
+  gzn::u32                  slots_count{};
+};
+
+[[nodiscard]]
+auto make_random_lifetimes_trace(
+  gzn::u32 const threads_count,
+  gzn::u32 const allocations_count
+) -> trace {
+  trace result{};
+  result.name = std::format("random lifetimes x{}", threads_count);
+
+  for (gzn::u32 t{}; t < threads_count; ++t) {
+    std::mt19937                            rng{ t + 1 };
+    std::geometric_distribution<gzn::u32>   size_class{ 0.15 };
+    std::uniform_int_distribution<gzn::u32> lifetime{ 1, 512 };
+
+    thread_trace                            ops{};
+    std::vector<std::pair<gzn::u32, gzn::u32>> live{};
+    for (gzn::u32 i{}; i < allocations_count; ++i) {
+      auto const slot{ result.slots_count++ };
+      auto const bytes_count{ 16 + 8 * std::min(size_class(rng), 510u) };
+      ops.push_back({ true, slot, bytes_count, 16 });
+      live.emplace_back(i + lifetime(rng), slot);
+
+      std::erase_if(live, [&ops, i](auto const &entry) {
+        if (entry.first > i) { return false; }
+        ops.push_back({ .slot = entry.second, .alignment = 16 });
+        return true;
+      });
+    }
+    for (auto const &[_, slot] : live) {
+      ops.push_back({ .slot = slot, .alignment = 16 });
+    }
+    result.threads.push_back(std::move(ops));
+  }
+  return result;
+}
+
+[[nodiscard]]
+auto make_frame_trace(gzn::u32 const frames_count, gzn::u32 const per_frame)
+  -> trace {
+  trace result{};
+  result.name = "per-frame bulk free";
+
+  std::mt19937                            rng{ 42 };
+  std::uniform_int_distribution<gzn::u32> bytes{ 8, 2048 };
+
+  thread_trace ops{};
+  for (gzn::u32 frame{}; frame < frames_count; ++frame) {
+    auto const first{ result.slots_count };
+    for (gzn::u32 i{}; i < per_frame; ++i) {
+      ops.push_back({ true, result.slots_count++, bytes(rng), 16 });
+    }
+    for (auto slot{ first }; slot < result.slots_count; ++slot) {
+      ops.push_back({ .slot = slot, .alignment = 16 });
+    }
+  }
+  result.threads.push_back(std::move(ops));
+  return result;
+}
+
+[[nodiscard]]
+auto load_trace(char const *path) -> trace {
+  trace result{};
+  result.name = std::format("recorded: {}", path);
+
+  auto file{ std::fopen(path, "r") };
+  if (file == nullptr) {
+    std::fprintf(stderr, "failed to open allocation trace '%s'\n", path);
+    return result;
+  }
+
+  struct live_block {
+    gzn::u32 slot{};
+    gzn::u32 thread{};
+  };
+
+  std::unordered_map<gzn::u64, live_block> live{};
+  std::unordered_map<gzn::u32, gzn::u32>   thread_indices{};
+  gzn::fnd::allocation_event               event{};
+
+  while (gzn::fnd::allocation_trace::read_from_file(file, event)) {
+    if (event.kind == gzn::fnd::allocation_event_kind::allocate) {
+      auto [it, inserted]{ thread_indices.try_emplace(
+        event.thread_index, static_cast<gzn::u32>(std::size(thread_indices))
+      ) };
+      if (inserted) { result.threads.emplace_back(); }
+
+      auto const slot{ result.slots_count++ };
+      live[event.id] = { slot, it->second };
+      result.threads[it->second].push_back(
+        { true, slot, event.bytes_count, event.alignment }
+      );
+    } else if (auto found{ live.find(event.id) }; found != std::end(live)) {
+      auto const [slot, thread]{ found->second };
+      result.threads[thread].push_back(
+        { .slot = slot, .alignment = event.alignment }
+      );
+      live.erase(found);
+    }
+  }
+  std::fclose(file);
+  return result;
+}
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-= allocators =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+struct mimalloc_raw {
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return mi_malloc_aligned(bytes_count, alignment);
+  }
+
+  void deallocate(void *memory, gzn::u32, gzn::u32) { mi_free(memory); }
+
+  void reset() {}
+};
+
+struct glibc_malloc {
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+#if defined(__GLIBC__)
+    return __libc_memalign(alignment, bytes_count);
+#else
+    return std::aligned_alloc(alignment, (bytes_count + alignment - 1) &
+                                           ~(alignment - 1));
+#endif
+  }
+
+  void deallocate(void *memory, gzn::u32, gzn::u32) {
+#if defined(__GLIBC__)
+    __libc_free(memory);
+#else
+    std::free(memory);
+#endif
+  }
+
+  void reset() {}
+};
+
+struct base {
+  gzn::fnd::base_allocator alloc{ "bench-allocators" };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return alloc.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    alloc.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() {}
+};
+
+struct stack_arena {
+  using arena_type = gzn::fnd::stack_arena_allocator<ARENA_BYTES_COUNT>;
+
+  std::unique_ptr<arena_type> arena{ std::make_unique<arena_type>() };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    if (arena->available_bytes_count() < bytes_count + alignment) {
+      return nullptr;
+    }
+    return arena->allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    arena->deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() { arena->reset(); }
+};
+
+struct slab {
+  gzn::fnd::slab_allocator alloc{ "bench-allocators" };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return alloc.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    alloc.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() {}
+};
+
+// Serves POOL_BLOCK_BYTES_COUNT blocks only: bigger requests go to the
+// parent, so a trace mostly made of them measures base_allocator. Pool-sized
+// requests aligned stricter than the block get nullptr and are skipped.
+struct block_pool {
+  gzn::fnd::base_allocator         parent{ "bench-allocators" };
+  gzn::fnd::block_pool_allocator<> alloc{ parent, POOL_BLOCK_BYTES_COUNT };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return alloc.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    alloc.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() {}
+};
+
+// Same limits as block_pool
+struct shared_block_pool {
+  gzn::fnd::base_allocator                parent{ "bench-allocators" };
+  gzn::fnd::shared_block_pool_allocator<> alloc{ parent,
+                                                 POOL_BLOCK_BYTES_COUNT };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return alloc.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    alloc.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() {}
+};
+
+// Frees are no-ops, memory comes back on reset only: a trace never reuses a
+// block within one replay, so its RSS is the sum of all the allocations
+struct frame_arena {
+  gzn::fnd::base_allocator          parent{ "bench-allocators" };
+  gzn::fnd::frame_arena_allocator<> arena{ parent };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return arena.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    arena.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() { arena.reset(); }
+};
+
+// Same limits as frame_arena. Rewinds instead of resetting so warmed-up
+// replays keep the committed pages, like frame_arena keeps its chunks.
+struct virtual_arena {
+  gzn::fnd::virtual_arena_allocator arena{};
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return arena.allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    arena.deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() { arena.rewind({}); }
+};
+
+// Fixed ARENA_BYTES_COUNT span: requests which don't fit in it get nullptr
+// and are skipped, every block is rounded up to a power of two of at least
+// the minimal block.
+struct buddy {
+  using allocator_type = gzn::fnd::buddy_allocator<>;
+
+  gzn::fnd::base_allocator        meta{ "bench-allocators" };
+  std::unique_ptr<gzn::byte[]>    memory{
+    std::make_unique_for_overwrite<gzn::byte[]>(ARENA_BYTES_COUNT)
+  };
+  std::unique_ptr<allocator_type> alloc{ std::make_unique<allocator_type>(
+    meta, std::span{ memory.get(), ARENA_BYTES_COUNT }
+  ) };
+
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment) -> void * {
+    return alloc->allocate(bytes_count, alignment, 0);
+  }
+
+  void deallocate(void *memory, gzn::u32 bytes_count, gzn::u32 alignment) {
+    alloc->deallocate(memory, bytes_count, alignment);
+  }
+
+  void reset() {}
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- replay -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// //
+//
+[[nodiscard]]
+auto current_rss_bytes() -> gzn::usize {
+#if defined(GZN_PLATFORM_LINUX)
+  auto file{ std::fopen("/proc/self/statm", "r") };
+  if (file == nullptr) { return 0; }
+  unsigned long pages{}, resident{};
+  auto const count{ std::fscanf(file, "%lu %lu", &pages, &resident) };
+  std::fclose(file);
+  return count == 2 ? resident * static_cast<gzn::usize>(sysconf(_SC_PAGESIZE))
+                    : 0;
+#else
+  return 0;
+#endif
+}
+
+struct replay_stats {
+  std::vector<gzn::u64> latencies_ns{};
+  gzn::usize            peak_rss_bytes{};
+};
+
+template<class Allocator>
+void replay_thread(
+  Allocator               &alloc,
+  thread_trace const      &ops,
+  std::vector<void *>     &slots,
+  std::vector<gzn::u32>   &sizes,
+  replay_stats            *stats
+) {
+  using clock = std::chrono::steady_clock;
+
+  for (gzn::usize i{}; i < std::size(ops); ++i) {
+    auto const &op{ ops[i] };
+    auto const  start{ stats ? clock::now() : clock::time_point{} };
+
+    if (op.allocate) {
+      slots[op.slot] = alloc.allocate(op.bytes_count, op.alignment);
+      sizes[op.slot] = op.bytes_count;
+      ankerl::nanobench::doNotOptimizeAway(slots[op.slot]);
+    } else if (auto memory{ slots[op.slot] }; memory) {
+      alloc.deallocate(memory, sizes[op.slot], op.alignment);
+    }
+
+    if (stats) {
+      auto const elapsed{ clock::now() - start };
+      stats->latencies_ns.push_back(static_cast<gzn::u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+      ));
+      if (i % RSS_SAMPLE_PERIOD == 0) {
+        stats->peak_rss_bytes =
+          std::max(stats->peak_rss_bytes, current_rss_bytes());
+      }
+    }
+  }
+}
+
+template<class Allocator>
+void replay(
+  Allocator             &alloc,
+  trace const           &trace,
+  std::vector<void *>   &slots,
+  std::vector<gzn::u32> &sizes,
+  replay_stats          *stats = nullptr
+) {
+  alloc.reset();
+  if (std::size(trace.threads) == 1) {
+    replay_thread(alloc, trace.threads.front(), slots, sizes, stats);
+    return;
+  }
+
+  std::vector<replay_stats> threads_stats(
+    stats ? std::size(trace.threads) : 0
+  );
+  {
+    std::vector<std::jthread> threads{};
+    for (gzn::usize t{}; t < std::size(trace.threads); ++t) {
+      threads.emplace_back([&, t] {
+        replay_thread(
+          alloc,
+          trace.threads[t],
+          slots,
+          sizes,
+          stats ? &threads_stats[t] : nullptr
+        );
+      });
+    }
+  }
+
+  if (stats) {
+    for (auto const &thread_stats : threads_stats) {
+      stats->latencies_ns.insert(
+        std::end(stats->latencies_ns),
+        std::begin(thread_stats.latencies_ns),
+        std::end(thread_stats.latencies_ns)
+      );
+      stats->peak_rss_bytes =
+        std::max(stats->peak_rss_bytes, thread_stats.peak_rss_bytes);
+    }
+  }
+}
+
+template<class Allocator>
+void run_bench(
+  ankerl::nanobench::Bench &bench,
+  std::string_view const    name,
+  trace const              &trace,
+  bool const                is_thread_safe = true
+) {
+  if (std::size(trace.threads) > 1 && !is_thread_safe) { return; }
+
+  Allocator             alloc{};
+  std::vector<void *>   slots(trace.slots_count);
+  std::vector<gzn::u32> sizes(trace.slots_count);
+
+  gzn::usize ops_count{};
+  for (auto const &ops : trace.threads) { ops_count += std::size(ops); }
+
+  replay_stats stats{};
+  stats.latencies_ns.reserve(ops_count);
+  auto const baseline_rss_bytes{ current_rss_bytes() };
+  replay(alloc, trace, slots, sizes, &stats);
+
+  // Latencies and RSS come from the first, cold replay; throughput from the
+  // warmed-up ones.
+  bench.batch(ops_count);
+  bench.run(std::format("{:16} | {}", name, trace.name), [&] {
+    replay(alloc, trace, slots, sizes);
+  });
+
+  auto &latencies{ stats.latencies_ns };
+  if (std::empty(latencies)) { return; }
+  auto const p99{ std::begin(latencies) + (std::size(latencies) * 99) / 100 };
+  std::nth_element(std::begin(latencies), p99, std::end(latencies));
+  std::printf(
+    "  %-16s | p99: %6llu ns | RSS growth: %8.2f MiB\n",
+    std::data(std::string{ name }),
+    static_cast<unsigned long long>(*p99),
+    static_cast<double>(
+      stats.peak_rss_bytes - std::min(stats.peak_rss_bytes, baseline_rss_bytes)
+    ) / (1024.0 * 1024.0)
+  );
+}
+
+int main() {
+  using namespace ankerl;
+
+  std::vector<trace> traces{};
+  traces.push_back(make_random_lifetimes_trace(1, 200'000));
+  traces.push_back(make_random_lifetimes_trace(4, 100'000));
+  traces.push_back(make_frame_trace(32, 4096));
+  if (auto path{ std::getenv(TRACE_ENV_VARIABLE) }; path) {
+    traces.push_back(load_trace(path));
+  }
+
+  nanobench::Bench bench{};
+  bench.title("allocation traces replay").unit("op").relative(true);
+  bench.minEpochIterations(2);
+
+  for (auto const &trace : traces) {
+    run_bench<glibc_malloc>(bench, "glibc malloc", trace);
+    run_bench<mimalloc_raw>(bench, "mimalloc", trace);
+    run_bench<base>(bench, "base_allocator", trace);
+    run_bench<slab>(bench, "slab", trace);
+    run_bench<block_pool>(bench, "block_pool", trace, false);
+    run_bench<shared_block_pool>(bench, "shared_pool", trace);
+    run_bench<stack_arena>(bench, "stack_arena", trace, false);
+    run_bench<frame_arena>(bench, "frame_arena", trace, false);
+    run_bench<virtual_arena>(bench, "virtual_arena", trace, false);
+    run_bench<buddy>(bench, "buddy", trace, false);
+  }
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <barrier>
+#include <format>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gzn/fnd/containers/concurrent-pool.hpp>
+#include <nanobench.h>
+
+namespace {
+
+using namespace gzn;
+
+u32 constexpr operations_count{ 10'000 };
+u32 constexpr held_count{ 32 };
+
+/// The single-threaded pool behind a mutex, the baseline
+struct locked_pool {
+  using handle_type = fnd::pool<u64>::handle_type;
+
+  std::mutex     mutex{};
+  fnd::pool<u64> values;
+
+  explicit locked_pool(usize const capacity)
+    : values{ fnd::any_allocator{}, capacity } {}
+
+  auto insert(u64 const value) -> handle_type {
+    std::scoped_lock const lock{ mutex };
+    return values.insert(value);
+  }
+
+  auto remove(handle_type const handle) -> bool {
+    std::scoped_lock const lock{ mutex };
+    return values.remove(handle);
+  }
+};
+
+/// Every worker creates and destroys resources in batches of `held_count`
+template<class Pool>
+void churn(Pool &pool) {
+  std::vector<typename Pool::handle_type> held{};
+  held.reserve(held_count);
+  for (u32 i{}; i < operations_count; ++i) {
+    held.push_back(pool.insert(i));
+    if (held.size() == held_count) {
+      for (auto const handle : held) { pool.remove(handle); }
+      held.clear();
+    }
+  }
+  for (auto const handle : held) { pool.remove(handle); }
+}
+
+/// Threads started once, so a timed round covers only the churn: `run`
+/// releases every worker for one round and waits for all of them
+template<class Pool>
+struct churn_workers {
+  std::barrier<>           start;
+  std::barrier<>           done;
+  std::atomic<bool>        stop{};
+  std::vector<std::thread> threads{};
+
+  churn_workers(Pool &pool, u32 const threads_count)
+    : start{ threads_count + 1 }
+    , done{ threads_count + 1 } {
+    for (u32 t{}; t < threads_count; ++t) {
+      threads.emplace_back([this, &pool] {
+        while (true) {
+          start.arrive_and_wait();
+          if (stop.load(std::memory_order_relaxed)) { return; }
+          churn(pool);
+          done.arrive_and_wait();
+        }
+      });
+    }
+  }
+
+  ~churn_workers() {
+    stop.store(true, std::memory_order_relaxed);
+    start.arrive_and_wait();
+    for (auto &thread : threads) { thread.join(); }
+  }
+
+  void run() {
+    start.arrive_and_wait();
+    done.arrive_and_wait();
+  }
+};
+
+} // namespace
+
+int main() {
+  ankerl::nanobench::Bench bench{};
+  bench.relative(true);
+
+  for (u32 const threads_count : { 1u, 4u }) {
+    auto const capacity{ threads_count * held_count };
+    bench.batch(threads_count * operations_count * 2);
+
+    {
+      locked_pool                pool{ capacity };
+      churn_workers<locked_pool> workers{ pool, threads_count };
+      bench.run(
+        std::format("mutex + pool ({} threads)", threads_count),
+        [&workers] { workers.run(); }
+      );
+    }
+
+    {
+      fnd::concurrent_pool<u64> pool{ fnd::any_allocator{}, capacity };
+      churn_workers<fnd::concurrent_pool<u64>> workers{ pool, threads_count };
+      bench.run(
+        std::format("concurrent_pool ({} threads)", threads_count),
+        [&workers] { workers.run(); }
+      );
+    }
+  }
+}
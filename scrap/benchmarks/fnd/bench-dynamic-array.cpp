@@ -1,9 +1,78 @@
+#include <array>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <gzn/fnd/containers/dynamic-array.hpp>
 #include <mimalloc.h>
 #include <nanobench.h>
 
+namespace {
+
+/// 256 bytes, trivially copyable
+struct large_pod {
+  std::array<gzn::u64, 32> values{};
+};
+
+/// Same payload behind a non-trivial move, opted into bitwise relocation
+struct large_relocatable {
+  bool static constexpr is_trivially_relocatable{ true };
+
+  std::array<gzn::u64, 31> values{};
+  gzn::u64                *owner{ nullptr };
+
+  large_relocatable() = default;
+
+  large_relocatable(large_relocatable &&other) noexcept
+    : values{ other.values }
+    , owner{ std::exchange(other.owner, nullptr) } {}
+
+  auto operator=(large_relocatable &&other) noexcept -> large_relocatable & {
+    values = other.values;
+    owner  = std::exchange(other.owner, nullptr);
+    return *this;
+  }
+};
+
+gzn::usize constexpr large_elements_count{ 512 };
+
+template<class Array>
+auto grow_large(Array &&growing) {
+  for (gzn::usize i{}; i < large_elements_count; ++i) {
+    growing.emplace_back();
+  }
+  return growing.size();
+}
+
+template<class Array>
+auto erase_front_large(Array &&erasing) {
+  for (gzn::usize i{}; i < large_elements_count; ++i) {
+    erasing.emplace_back();
+  }
+  while (!erasing.empty()) { erasing.erase(erasing.begin()); }
+  return erasing.capacity();
+}
+
+template<class T>
+void run_large_bench(ankerl::nanobench::Bench &bench, std::string name) {
+  gzn::fnd::base_allocator alloc{};
+
+  bench.run("std::vector<" + name + "> grow", [] {
+    return grow_large(std::vector<T>{});
+  });
+  bench.run("dynamic_array<" + name + "> grow", [&alloc] {
+    return grow_large(gzn::fnd::dynamic_array<T>{ alloc });
+  });
+  bench.run("std::vector<" + name + "> erase front", [] {
+    return erase_front_large(std::vector<T>{});
+  });
+  bench.run("dynamic_array<" + name + "> erase front", [&alloc] {
+    return erase_front_large(gzn::fnd::dynamic_array<T>{ alloc });
+  });
+}
+
+} // namespace
+
 int main() {
   using namespace gzn;
   using namespace ankerl;
@@ -36,4 +105,24 @@ int main() {
     for (auto const value : pushing_values) { growing.push_back(value); }
     return growing.size() + growing.capacity();
   });
+
+  bench.run("std::vector append range", [] {
+    std::vector<size_t> growing;
+    growing.insert(
+      std::end(growing), std::begin(pushing_values), std::end(pushing_values)
+    );
+    return growing.size() + growing.capacity();
+  });
+
+  bench.run(
+    "dynamic_array append range",
+    [alloc{ fnd::base_allocator{} }]() mutable {
+      fnd::dynamic_array<size_t> growing{ alloc };
+      growing.append_range(pushing_values);
+      return growing.size() + growing.capacity();
+    }
+  );
+
+  run_large_bench<large_pod>(bench, "large_pod");
+  run_large_bench<large_relocatable>(bench, "large_relocatable");
 }
@@ -0,0 +1,103 @@
+#include <format>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gzn/fnd/containers/dictionary.hpp>
+#include <gzn/fnd/containers/flat-map.hpp>
+#include <nanobench.h>
+
+namespace {
+
+using namespace gzn;
+
+using sorted_map    = fnd::flat_map<u64, u32>;
+using eytzinger_map = fnd::flat_map<
+  u64,
+  u32,
+  fnd::base_allocator,
+  fnd::flat_map_eytzinger_twicks<fnd::record<u64, u32>>>;
+
+/// Every lookup is a hit, looked up in a shuffled order
+usize constexpr lookups_count{ 4'096 };
+
+template<class Map>
+void run_find(
+  ankerl::nanobench::Bench &bench,
+  std::string_view const    name,
+  usize const               count,
+  Map const                &map,
+  std::vector<u64> const   &lookups
+) {
+  bench.run(std::format("{} find hit ({})", name, count), [&] {
+    u32 sum{};
+    for (auto const key : lookups) {
+      if constexpr (requires { map.find(key)->second; }) {
+        sum += map.find(key)->second;
+      } else {
+        sum += map.find(key)->value;
+      }
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
+
+void run_flat_map_bench(ankerl::nanobench::Bench &bench, usize const count) {
+  std::mt19937_64 gen{ count };
+
+  std::vector<fnd::record<u64, u32>> records{};
+  for (u32 i{}; i < count; ++i) { records.push_back({ gen(), i }); }
+
+  std::vector<u64> lookups{};
+  for (usize i{}; i < lookups_count; ++i) {
+    lookups.push_back(records[gen() % count].key);
+  }
+
+  fnd::base_allocator alloc{};
+
+  std::map<u64, u32>      std_values{};
+  fnd::hash_map<u64, u32> hash_values{ alloc };
+  sorted_map const        sorted_values{ alloc, records };
+  eytzinger_map const     eytzinger_values{ alloc, records };
+  for (auto const &[key, value] : records) {
+    std_values.emplace(key, value);
+    hash_values.insert(key, value);
+  }
+
+  bench.batch(count);
+  bench.run(std::format("std::map insert ({})", count), [&] {
+    std::map<u64, u32> values{};
+    for (auto const &[key, value] : records) { values.emplace(key, value); }
+    ankerl::nanobench::doNotOptimizeAway(values.size());
+  });
+  bench.run(std::format("fnd::flat_map insert ({})", count), [&] {
+    sorted_map values{ alloc };
+    for (auto const &[key, value] : records) { values.insert(key, value); }
+    ankerl::nanobench::doNotOptimizeAway(values.size());
+  });
+  bench.run(std::format("fnd::flat_map insert_range ({})", count), [&] {
+    sorted_map values{ alloc };
+    values.insert_range(records);
+    ankerl::nanobench::doNotOptimizeAway(values.size());
+  });
+
+  bench.batch(lookups_count);
+  run_find(bench, "std::map", count, std_values, lookups);
+  run_find(bench, "fnd::hash_map", count, hash_values, lookups);
+  run_find(bench, "fnd::flat_map", count, sorted_values, lookups);
+  run_find(
+    bench, "fnd::flat_map eytzinger", count, eytzinger_values, lookups
+  );
+}
+
+} // namespace
+
+int main() {
+  ankerl::nanobench::Bench bench{};
+  bench.relative(true);
+  bench.warmup(3);
+
+  for (usize const count : { 16uz, 256uz, 4'096uz }) {
+    run_flat_map_bench(bench, count);
+  }
+}
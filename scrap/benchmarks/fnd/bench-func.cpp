@@ -23,6 +23,9 @@ private:
 
 auto small_function(int x) -> int { return x; }
 
+/// Fits `heavy_dude` captures inline
+gzn::usize constexpr huge_storage_bytes_count{ 256 };
+
 int main() {
   using namespace gzn;
   using namespace ankerl;
@@ -59,6 +62,27 @@ int main() {
     return std::function<int(int)>{ [heavy_dude](int x) { return x; } };
   });
 
+  bench.run("[gzn] huge lambda creation | inline storage", [heavy_dude] {
+    return fnd::move_only_func<int(int), huge_storage_bytes_count>{
+      alloc, [heavy_dude](int x) { return x; }
+    };
+  });
+
+  bench.run("[gzn] small lambda creation | inplace_func", [] {
+    return fnd::inplace_func<int(int)>{ [](int x) { return x; } };
+  });
+
+  bench.run("[gzn] huge lambda creation | inplace_func", [heavy_dude] {
+    return fnd::inplace_func<int(int), huge_storage_bytes_count>{
+      [heavy_dude](int x) { return x; }
+    };
+  });
+
+  bench.run("[gzn] huge lambda creation | function_ref", [heavy_dude] {
+    auto const lambda{ [heavy_dude](int x) { return x; } };
+    nanobench::doNotOptimizeAway(fnd::function_ref<int(int) const>{ lambda });
+  });
+
 
   bench.title("function calling");
   bench.run(
@@ -94,6 +118,32 @@ int main() {
      } } }]() mutable { return fn(param); }
   );
 
+  bench.run(
+    "[gzn] lambda | huge capture | inline storage",
+    [param,
+     fn{ fnd::move_only_func<int(int), huge_storage_bytes_count>{
+       alloc, [heavy_dude](int x) { return x; } } }]() mutable {
+      return fn(param);
+    }
+  );
+
+  bench.run(
+    "[gzn] lambda | huge capture | inplace_func",
+    [param,
+     fn{ fnd::inplace_func<int(int), huge_storage_bytes_count>{
+       [heavy_dude](int x) { return x; } } }]() mutable {
+      return fn(param);
+    }
+  );
+
+  auto const huge_lambda{ [heavy_dude](int x) { return x; } };
+  bench.run(
+    "[gzn] lambda | huge capture | function_ref",
+    [param, fn{ fnd::function_ref<int(int) const>{ huge_lambda } }] {
+      return fn(param);
+    }
+  );
+
   func_test obj{ param };
   using method_signature = int(func_test<int> &, int);
   bench.run(
@@ -0,0 +1,157 @@
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gzn/fnd/containers/dictionary.hpp>
+#include <gzn/fnd/name.hpp>
+#include <nanobench.h>
+
+#include "common/genstr.hpp"
+
+namespace {
+
+using namespace gzn;
+
+struct name_hash {
+  auto operator()(fnd::s8name const &name) const noexcept -> size_t {
+    return name.hash();
+  }
+};
+
+template<class Key>
+struct std_map_of {
+  using type = std::unordered_map<Key, u32>;
+};
+
+template<>
+struct std_map_of<fnd::s8name> {
+  using type = std::unordered_map<fnd::s8name, u32, name_hash>;
+};
+
+/// `hits` are stored in the maps, `misses` are not
+template<class Key>
+struct key_set {
+  std::vector<Key> hits;
+  std::vector<Key> misses;
+};
+
+template<class Key>
+auto make_key(std::mt19937_64 &gen) -> Key {
+  if constexpr (std::same_as<Key, u64>) {
+    return gen();
+  } else {
+    // Resource-like paths: shared prefix, random tail
+    auto const tail_length{ 8 + gen() % 24 };
+    return Key{ "assets/" + cmn::genstr<char>(tail_length) };
+  }
+}
+
+template<class Key>
+auto make_key_set(usize const count) -> key_set<Key> {
+  std::mt19937_64 gen{ count };
+  key_set<Key>    keys{};
+  keys.hits.reserve(count);
+  keys.misses.reserve(count);
+  for (usize i{}; i < count; ++i) {
+    keys.hits.push_back(make_key<Key>(gen));
+    keys.misses.push_back(make_key<Key>(gen));
+  }
+  return keys;
+}
+
+template<class Key>
+void run_map_bench(
+  ankerl::nanobench::Bench &bench,
+  std::string_view const    key_name,
+  usize const               count
+) {
+  using std_map = typename std_map_of<Key>::type;
+  using gzn_map = fnd::hash_map<Key, u32>;
+
+  auto const keys{ make_key_set<Key>(count) };
+  fnd::base_allocator alloc{};
+
+  std_map std_values{};
+  gzn_map gzn_values{ alloc };
+  for (u32 i{}; auto const &key : keys.hits) {
+    std_values.emplace(key, i);
+    gzn_values.insert(key, i++);
+  }
+
+  bench.batch(count);
+
+  bench.run(
+    std::format("std::unordered_map<{}> insert ({})", key_name, count),
+    [&] {
+      std_map values{};
+      for (u32 i{}; auto const &key : keys.hits) { values.emplace(key, i++); }
+      ankerl::nanobench::doNotOptimizeAway(values.size());
+    }
+  );
+  bench.run(
+    std::format("fnd::hash_map<{}> insert ({})", key_name, count),
+    [&] {
+      gzn_map values{ alloc };
+      for (u32 i{}; auto const &key : keys.hits) { values.insert(key, i++); }
+      ankerl::nanobench::doNotOptimizeAway(values.size());
+    }
+  );
+
+  bench.run(
+    std::format("std::unordered_map<{}> find hit ({})", key_name, count),
+    [&] {
+      u32 sum{};
+      for (auto const &key : keys.hits) {
+        sum += std_values.find(key)->second;
+      }
+      ankerl::nanobench::doNotOptimizeAway(sum);
+    }
+  );
+  bench.run(
+    std::format("fnd::hash_map<{}> find hit ({})", key_name, count),
+    [&] {
+      u32 sum{};
+      for (auto const &key : keys.hits) {
+        sum += gzn_values.find(key)->value;
+      }
+      ankerl::nanobench::doNotOptimizeAway(sum);
+    }
+  );
+
+  bench.run(
+    std::format("std::unordered_map<{}> find miss ({})", key_name, count),
+    [&] {
+      usize found{};
+      for (auto const &key : keys.misses) {
+        found += std_values.contains(key);
+      }
+      ankerl::nanobench::doNotOptimizeAway(found);
+    }
+  );
+  bench.run(
+    std::format("fnd::hash_map<{}> find miss ({})", key_name, count),
+    [&] {
+      usize found{};
+      for (auto const &key : keys.misses) {
+        found += gzn_values.contains(key);
+      }
+      ankerl::nanobench::doNotOptimizeAway(found);
+    }
+  );
+}
+
+} // namespace
+
+int main() {
+  ankerl::nanobench::Bench bench{};
+  bench.relative(true);
+  bench.warmup(3);
+
+  for (usize const count : { 1'000uz, 100'000uz }) {
+    run_map_bench<u64>(bench, "u64", count);
+    run_map_bench<std::string>(bench, "string", count);
+    run_map_bench<fnd::s8name>(bench, "s8name", count);
+  }
+}
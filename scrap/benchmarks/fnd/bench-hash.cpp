@@ -1,6 +1,10 @@
 #include <concepts>
+#include <format>
+#include <string>
+#include <random>
 #include <vector>
 
+#include <gzn/fnd/hash-tree.hpp>
 #include <gzn/fnd/hash.hpp>
 #include <nanobench.h>
 
@@ -35,6 +39,68 @@ auto run_hash_bench(ankerl::nanobench::Bench &bench) {
   });
 }
 
+/// Hashes `count` keys of `length` chars one by one and in batches
+template<gzn::usize L>
+void run_hash_batch_bench(ankerl::nanobench::Bench &bench) {
+  gzn::usize constexpr count{ 4'096 };
+
+  std::vector<std::string> strings{};
+  for (gzn::usize i{}; i < count; ++i) {
+    strings.push_back(cmn::genstr<char>(L));
+  }
+  std::vector<gzn::fnd::hash_key_span<char>> keys{};
+  for (auto const &str : strings) {
+    keys.emplace_back(std::data(str), std::size(str));
+  }
+  std::vector<gzn::u64> digests(count);
+
+  bench.batch(count);
+  bench.run(std::format("rapidhash loop({:4})", L), [&] {
+    for (gzn::usize i{}; i < count; ++i) {
+      digests[i] = rapidhash(std::data(keys[i]), std::size(keys[i]));
+    }
+    ankerl::nanobench::doNotOptimizeAway(digests.back());
+  });
+  bench.run(std::format("gzn::fnd::hash loop({:4})", L), [&] {
+    for (gzn::usize i{}; i < count; ++i) {
+      digests[i] = gzn::fnd::hash<char>({ .key = keys[i] });
+    }
+    ankerl::nanobench::doNotOptimizeAway(digests.back());
+  });
+  bench.run(std::format("gzn::fnd::hash_batch({:4})", L), [&] {
+    gzn::fnd::hash_batch<char>(keys, digests);
+    ankerl::nanobench::doNotOptimizeAway(digests.back());
+  });
+  bench.batch(1);
+}
+
+void run_hash_tree_bench(ankerl::nanobench::Bench &bench) {
+  gzn::usize constexpr bytes_count{ gzn::usize{ 64 } << 20 };
+
+  std::mt19937_64       gen{ 5 };
+  std::vector<gzn::u64> words(bytes_count / sizeof(gzn::u64));
+  for (auto &word : words) { word = gen(); }
+  auto const data{ std::as_bytes(std::span{ words }) };
+
+  bench.batch(bytes_count).unit("byte");
+  bench.run("gzn::fnd::hash(64 MiB)", [&] {
+    ankerl::nanobench::doNotOptimizeAway(
+      gzn::fnd::hash<std::byte>({ .key = data })
+    );
+  });
+  for (gzn::u32 const threads_count : { 1u, 2u, 4u, 0u }) {
+    bench.run(
+      std::format("gzn::fnd::hash_tree(64 MiB, {} threads)", threads_count),
+      [&] {
+        ankerl::nanobench::doNotOptimizeAway(gzn::fnd::hash_tree({
+          .data = data, .threads_count = threads_count
+        }));
+      }
+    );
+  }
+  bench.batch(1).unit("op");
+}
+
 int main() {
   using namespace ankerl;
 
@@ -98,4 +164,10 @@ int main() {
   run_hash_bench<char32_t, 32>(bench);
   run_hash_bench<char32_t, 100>(bench);
   run_hash_bench<char32_t, 1000>(bench);
+
+  run_hash_batch_bench<4>(bench);
+  run_hash_batch_bench<8>(bench);
+  run_hash_batch_bench<16>(bench);
+
+  run_hash_tree_bench(bench);
 }
@@ -0,0 +1,237 @@
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gzn/fnd/containers/mpmc-queue.hpp>
+#include <gzn/fnd/containers/spsc-ring.hpp>
+#include <nanobench.h>
+
+namespace {
+
+using namespace gzn;
+
+u64 constexpr items_count{ 100'000 };
+usize constexpr queue_capacity{ 1'024 };
+
+/// std::deque behind a mutex, the baseline
+template<class T>
+class locked_queue {
+public:
+  auto try_push(T const &value) -> bool {
+    std::scoped_lock const lock{ m_mutex };
+    if (m_values.size() == queue_capacity) { return false; }
+    m_values.push_back(value);
+    return true;
+  }
+
+  auto try_pop(T &out) -> bool {
+    std::scoped_lock const lock{ m_mutex };
+    if (m_values.empty()) { return false; }
+    out = m_values.front();
+    m_values.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex    m_mutex{};
+  std::deque<T> m_values{};
+};
+
+/// Threads started once, so a timed round covers only the hand-off: `run`
+/// releases every worker for one round and waits for all of them. Each
+/// worker calls `work` with its index once per round.
+template<class Work>
+struct round_workers {
+  std::barrier<>           start;
+  std::barrier<>           done;
+  std::atomic<bool>        stop{};
+  Work                     work;
+  std::vector<std::thread> threads{};
+
+  round_workers(u32 const threads_count, Work work_)
+    : start{ threads_count + 1 }
+    , done{ threads_count + 1 }
+    , work{ std::move(work_) } {
+    for (u32 t{}; t < threads_count; ++t) {
+      threads.emplace_back([this, t] {
+        while (true) {
+          start.arrive_and_wait();
+          if (stop.load(std::memory_order_relaxed)) { return; }
+          work(t);
+          done.arrive_and_wait();
+        }
+      });
+    }
+  }
+
+  ~round_workers() {
+    stop.store(true, std::memory_order_relaxed);
+    start.arrive_and_wait();
+    for (auto &thread : threads) { thread.join(); }
+  }
+
+  void run() {
+    start.arrive_and_wait();
+    done.arrive_and_wait();
+  }
+};
+
+/// `producers` threads push `items_count` values in total, `consumers`
+/// threads pop them
+template<class Queue>
+void transfer(
+  ankerl::nanobench::Bench &bench,
+  std::string const        &name,
+  Queue                    &queue,
+  u32 const                 producers,
+  u32 const                 consumers
+) {
+  auto const       total{ items_count / producers * producers };
+  std::atomic<u64> popped{};
+
+  round_workers workers{
+    producers + consumers, [&queue, &popped, producers, total](u32 const t) {
+      if (t < producers) {
+        for (u64 i{}; i < items_count / producers; ++i) {
+          while (!queue.try_push(i)) { std::this_thread::yield(); }
+        }
+        return;
+      }
+
+      u64 value{};
+      while (popped.load(std::memory_order_relaxed) < total) {
+        if (queue.try_pop(value)) {
+          popped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      ankerl::nanobench::doNotOptimizeAway(value);
+    }
+  };
+
+  bench.run(name, [&popped, &workers] {
+    popped.store(0, std::memory_order_relaxed);
+    workers.run();
+  });
+}
+
+/// Producer pushes batches with one publication each, consumer drains in
+/// batches
+void transfer_batched(
+  ankerl::nanobench::Bench &bench,
+  std::string const        &name,
+  fnd::spsc_ring<u64>      &ring
+) {
+  round_workers workers{ 2, [&ring](u32 const t) {
+    std::array<u64, 64> batch{};
+    if (t == 0) {
+      for (u64 sent{}; sent < items_count;) {
+        auto const left{ std::min<u64>(std::size(batch), items_count - sent)
+        };
+        auto const pushed{ ring.push_n(std::data(batch), left) };
+        if (pushed == 0) { std::this_thread::yield(); }
+        sent += pushed;
+      }
+      return;
+    }
+
+    for (u64 received{}; received < items_count;) {
+      auto const popped{ ring.pop_n(std::data(batch), std::size(batch)) };
+      if (popped == 0) { std::this_thread::yield(); }
+      received += popped;
+    }
+  } };
+
+  bench.run(name, [&workers] { workers.run(); });
+}
+
+/// Round trip of one value through two rings, the hand-off latency.
+/// Waiting sides yield, so the numbers stay meaningful on few cores.
+void ping_pong(
+  ankerl::nanobench::Bench &bench,
+  std::string const        &name,
+  fnd::spsc_ring<u64>      &there,
+  fnd::spsc_ring<u64>      &back,
+  u64 const                 rounds_count
+) {
+  round_workers workers{ 2, [&there, &back, rounds_count](u32 const t) {
+    for (u64 i{}, value{}; i < rounds_count; ++i) {
+      if (t == 0) {
+        while (!there.try_push(i)) { std::this_thread::yield(); }
+        while (!back.try_pop(value)) { std::this_thread::yield(); }
+      } else {
+        while (!there.try_pop(value)) { std::this_thread::yield(); }
+        while (!back.try_push(value)) { std::this_thread::yield(); }
+      }
+    }
+  } };
+
+  bench.run(name, [&workers] { workers.run(); });
+}
+
+} // namespace
+
+int main() {
+  fnd::base_allocator alloc{};
+
+  ankerl::nanobench::Bench bench{};
+  bench.relative(true);
+  bench.batch(items_count);
+
+  {
+    locked_queue<u64> queue{};
+    transfer(bench, "mutex + deque 1P/1C", queue, 1, 1);
+  }
+  {
+    fnd::spsc_ring<u64> ring{ alloc, queue_capacity };
+    transfer(bench, "spsc_ring 1P/1C", ring, 1, 1);
+  }
+  {
+    fnd::spsc_ring<u64> ring{ alloc, queue_capacity };
+    transfer_batched(bench, "spsc_ring 1P/1C batched", ring);
+  }
+  {
+    fnd::mpmc_queue<u64> queue{ alloc, queue_capacity };
+    transfer(bench, "mpmc_queue 1P/1C", queue, 1, 1);
+  }
+
+  for (u32 const threads_count : { 2u, 4u }) {
+    {
+      locked_queue<u64> queue{};
+      transfer(
+        bench,
+        std::format("mutex + deque {0}P/{0}C", threads_count),
+        queue,
+        threads_count,
+        threads_count
+      );
+    }
+    {
+      fnd::mpmc_queue<u64> queue{ alloc, queue_capacity };
+      transfer(
+        bench,
+        std::format("mpmc_queue {0}P/{0}C", threads_count),
+        queue,
+        threads_count,
+        threads_count
+      );
+    }
+  }
+
+  u64 constexpr rounds_count{ 10'000 };
+
+  ankerl::nanobench::Bench latency{};
+  latency.batch(rounds_count);
+
+  fnd::spsc_ring<u64> there{ alloc, 2 };
+  fnd::spsc_ring<u64> back{ alloc, 2 };
+  ping_pong(latency, "spsc_ring round trip", there, back, rounds_count);
+}
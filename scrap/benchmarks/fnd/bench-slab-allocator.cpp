@@ -0,0 +1,112 @@
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <format>
+#include <thread>
+#include <vector>
+
+#include <gzn/fnd/allocators.hpp>
+#include <gzn/fnd/allocators/slab.hpp>
+#include <mimalloc.h>
+#include <nanobench.h>
+
+gzn::u32 constexpr BLOCKS_PER_ROUND{ 256 };
+gzn::u32 constexpr ROUNDS_PER_THREAD{ 64 };
+
+struct mimalloc_raw {
+  [[nodiscard]]
+  auto allocate(gzn::u32 bytes_count, gzn::u32 alignment, gzn::u32, gzn::u32)
+    -> void * {
+    return mi_malloc_aligned(bytes_count, alignment);
+  }
+
+  void deallocate(void *memory, gzn::u32 count, gzn::u32 alignment) {
+    mi_free_size_aligned(memory, count, alignment);
+  }
+};
+
+template<class Allocator>
+void churn(Allocator &alloc, gzn::u32 const bytes_count) {
+  std::array<void *, BLOCKS_PER_ROUND> blocks{};
+  for (gzn::u32 round{}; round < ROUNDS_PER_THREAD; ++round) {
+    for (auto &block : blocks) {
+      block = alloc.allocate(bytes_count, 16, 0, 0);
+      ankerl::nanobench::doNotOptimizeAway(block);
+    }
+    for (auto block : blocks) { alloc.deallocate(block, bytes_count, 16); }
+  }
+}
+
+/// Threads started once, so a timed round covers only the churn: `run`
+/// releases every worker for one round and waits for all of them
+template<class Allocator>
+struct churn_workers {
+  std::barrier<>           start;
+  std::barrier<>           done;
+  std::atomic<bool>        stop{};
+  std::vector<std::thread> threads{};
+
+  churn_workers(gzn::u32 const threads_count, gzn::u32 const bytes_count)
+    : start{ threads_count + 1 }
+    , done{ threads_count + 1 } {
+    for (gzn::u32 t{}; t < threads_count; ++t) {
+      threads.emplace_back([this, bytes_count] {
+        Allocator alloc{};
+        while (true) {
+          start.arrive_and_wait();
+          if (stop.load(std::memory_order_relaxed)) { return; }
+          churn(alloc, bytes_count);
+          done.arrive_and_wait();
+        }
+      });
+    }
+  }
+
+  ~churn_workers() {
+    stop.store(true, std::memory_order_relaxed);
+    start.arrive_and_wait();
+    for (auto &thread : threads) { thread.join(); }
+  }
+
+  void run() {
+    start.arrive_and_wait();
+    done.arrive_and_wait();
+  }
+};
+
+template<class Allocator>
+void run_bench(
+  ankerl::nanobench::Bench &bench,
+  std::string_view const    name,
+  gzn::u32 const            threads_count,
+  gzn::u32 const            bytes_count
+) {
+  auto const title{
+    std::format("{:16} | {:2} threads | {:4} bytes", name, threads_count,
+                bytes_count)
+  };
+  churn_workers<Allocator> workers{ threads_count, bytes_count };
+  bench.batch(threads_count * ROUNDS_PER_THREAD * BLOCKS_PER_ROUND * 2);
+  bench.run(title, [&workers] { workers.run(); });
+}
+
+int main() {
+  using namespace gzn;
+  using namespace ankerl;
+
+  nanobench::Bench bench{};
+  bench.title("small blocks alloc/free").unit("op").relative(true);
+  bench.minEpochIterations(4);
+
+  for (auto const bytes_count : { 24u, 64u, 200u }) {
+    for (auto const threads_count : { 1u, 4u, 16u }) {
+      run_bench<mimalloc_raw>(bench, "mimalloc", threads_count, bytes_count);
+      run_bench<fnd::base_allocator>(
+        bench, "base_allocator", threads_count, bytes_count
+      );
+      run_bench<fnd::slab_allocator>(
+        bench, "slab_allocator", threads_count, bytes_count
+      );
+    }
+  }
+}
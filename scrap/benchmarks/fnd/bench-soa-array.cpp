@@ -0,0 +1,46 @@
+#include <array>
+#include <vector>
+
+#include <gzn/fnd/containers/soa-array.hpp>
+#include <nanobench.h>
+
+namespace {
+
+using namespace gzn;
+
+struct entity {
+  std::array<float, 3> position{};
+  std::array<float, 4> rotation{};
+  std::array<float, 3> scale{};
+  u32                  flags{};
+};
+
+usize constexpr entities_count{ 100'000 };
+
+} // namespace
+
+int main() {
+  ankerl::nanobench::Bench bench{};
+  bench.relative(true);
+  bench.batch(entities_count);
+
+  fnd::base_allocator alloc{};
+
+  std::vector<entity> aos(entities_count);
+  fnd::soa_array<float, float, float, std::array<float, 4>, u32> soa{ alloc };
+  soa.resize(entities_count);
+  for (usize i{}; i < entities_count; ++i) {
+    aos[i].position[1] = static_cast<float>(i);
+    std::get<1>(soa[i]) = static_cast<float>(i);
+  }
+
+  bench.run("array of structs: move y", [&] {
+    for (auto &value : aos) { value.position[1] += 1.0f; }
+    ankerl::nanobench::doNotOptimizeAway(aos.front());
+  });
+
+  bench.run("soa_array: move y", [&] {
+    for (auto &y : soa.column<1>()) { y += 1.0f; }
+    ankerl::nanobench::doNotOptimizeAway(soa.column<1>().front());
+  });
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+
+#include <gzn/fnd/allocators/tracking.hpp>
+
+namespace cmn {
+
+/// base_allocator counting into the registry entry of its label, tests give
+/// each one a label of their own
+using tracked_allocator =
+  gzn::fnd::tracking_allocator<gzn::fnd::base_allocator>;
+
+[[nodiscard]]
+inline auto allocations_count(tracked_allocator const &alloc) -> gzn::u64 {
+  return alloc.get_stats()->allocations_count.load(std::memory_order_relaxed);
+}
+
+/// 0 once everything allocated through `alloc` is given back
+[[nodiscard]]
+inline auto live_bytes_count(tracked_allocator const &alloc) -> gzn::u64 {
+  return alloc.get_stats()->live_bytes_count.load(std::memory_order_relaxed);
+}
+
+} // namespace cmn
@@ -1,5 +1,19 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 #include <gzn/fnd/allocators.hpp>
+#include <gzn/fnd/allocators/block-pool.hpp>
+#include <gzn/fnd/allocators/buddy.hpp>
+#include <gzn/fnd/allocators/frame-arena.hpp>
+#include <gzn/fnd/allocators/slab.hpp>
+#include <gzn/fnd/allocators/trace.hpp>
+#include <gzn/fnd/allocators/tracking.hpp>
+#include <gzn/fnd/allocators/virtual-arena.hpp>
 
 struct float2 {
   float x{}, y{};
@@ -43,4 +57,422 @@ TEST_CASE("test: gzn::fnd::allocators", "[fnd][allocators]") {
     base.deallocate(mem, bytes_count);
   } // SECTION("base_allocator")
 
+  SECTION("slab_allocator") {
+    gzn::fnd::slab_allocator slab{ "test-slab" };
+
+    void *small{ slab.allocate(sizeof(vertex), alignof(vertex), 0) };
+    REQUIRE(small != nullptr);
+    new (small) vertex{};
+    slab.deallocate(small, sizeof(vertex), alignof(vertex));
+
+    // The freed block is the first one to be reused by the same size class
+    void *reused{ slab.allocate(sizeof(vertex), alignof(vertex), 0) };
+    REQUIRE(reused == small);
+    slab.deallocate(reused, sizeof(vertex), alignof(vertex));
+
+    // An offset breaking the alignment goes to the backing allocator, and
+    // its block back there rather than onto a slab free list
+    auto const shifted{ static_cast<std::byte *>(slab.allocate(48, 16, 8)) };
+    REQUIRE(shifted != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(shifted + 8) % 16 == 0);
+    slab.deallocate(shifted, 48, 16);
+    REQUIRE(slab.allocate(sizeof(vertex), alignof(vertex), 0) == small);
+    slab.deallocate(small, sizeof(vertex), alignof(vertex));
+
+    constexpr gzn::u32 large_bytes_count{ 4096 };
+    void              *large{ slab.allocate(large_bytes_count) };
+    REQUIRE(large != nullptr);
+    slab.deallocate(large, large_bytes_count);
+
+    constexpr gzn::u32 blocks_count{ 4096 };
+    std::vector<void *> blocks(blocks_count, nullptr);
+    for (auto &block : blocks) {
+      block = slab.allocate(64, 16, 0);
+      REQUIRE(block != nullptr);
+    }
+
+    // Free everything from another thread through the remote free lists
+    std::jthread{ [&] {
+      for (auto block : blocks) { slab.deallocate(block, 64, 16); }
+    } }.join();
+
+    for (auto &block : blocks) {
+      block = slab.allocate(64, 16, 0);
+      REQUIRE(block != nullptr);
+    }
+    for (auto block : blocks) { slab.deallocate(block, 64, 16); }
+  } // SECTION("slab_allocator")
+
+  SECTION("frame_arena_allocator") {
+    gzn::fnd::base_allocator                        base{ "test-alloc" };
+    gzn::fnd::frame_arena_allocator<gzn::fnd::base_allocator> arena{ base,
+                                                                     256 };
+
+    auto first{ arena.allocate(sizeof(vertex), alignof(vertex), 0) };
+    REQUIRE(first != nullptr);
+
+    auto const mark{ arena.mark() };
+    auto       second{ arena.allocate(100, 64, 0) };
+    REQUIRE(second != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+
+    // Doesn't fit into the first chunk, so the arena chains a new one
+    auto huge{ arena.allocate(1000, 16, 0) };
+    REQUIRE(huge != nullptr);
+    REQUIRE(arena.reserved_bytes_count() >= 256 + 1000);
+
+    arena.rewind(mark);
+    REQUIRE(arena.allocate(100, 64, 0) == second);
+
+    auto const reserved{ arena.reserved_bytes_count() };
+    arena.reset();
+    REQUIRE(arena.allocate(sizeof(vertex), alignof(vertex), 0) == first);
+    REQUIRE(arena.allocate(1000, 16, 0) == huge);
+    REQUIRE(arena.reserved_bytes_count() == reserved);
+  } // SECTION("frame_arena_allocator")
+
+  SECTION("frame_allocator") {
+    gzn::fnd::base_allocator                          base{ "test-alloc" };
+    gzn::fnd::frame_allocator<2, gzn::fnd::base_allocator> frames{ base, 256 };
+
+    auto frame0{ frames.allocate(32, 16, 0) };
+    frames.next_frame();
+    auto frame1{ frames.allocate(32, 16, 0) };
+    REQUIRE(frame0 != frame1);
+    REQUIRE(frames.frame_index() == 1);
+
+    frames.next_frame();
+    REQUIRE(frames.frame_index() == 0);
+    REQUIRE(frames.allocate(32, 16, 0) == frame0);
+  } // SECTION("frame_allocator")
+
+  SECTION("base_allocator flags") {
+    namespace flags = gzn::fnd::allocation_flags;
+
+    gzn::fnd::base_allocator base{ "test-flags" };
+
+    auto zeroed{ static_cast<std::byte *>(
+      base.allocate(4096, 64, 0, flags::zeroed)
+    ) };
+    REQUIRE(zeroed != nullptr);
+    REQUIRE(std::all_of(zeroed, zeroed + 4096, [](auto const value) {
+      return value == std::byte{};
+    }));
+    base.deallocate(zeroed, 4096, 64);
+
+    auto constexpr huge_bytes_count{ 4u * 1024 * 1024 };
+    auto huge{ base.allocate(huge_bytes_count, 16, 0, flags::huge_pages) };
+    REQUIRE(huge != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(huge) % (2 * 1024 * 1024) == 0);
+    base.deallocate(huge, huge_bytes_count, 16);
+
+    REQUIRE(flags::numa_node_of(flags::numa_node(3)) == 3);
+    auto local{
+      base.allocate(256, 16, 0, flags::numa_node(0) | flags::zeroed)
+    };
+    REQUIRE(local != nullptr);
+    base.deallocate(local, 256, 16);
+
+    // Opting in still falls back when the node can't reserve huge pages
+    gzn::fnd::base_allocator::set_numa_reservation(1);
+    auto reserved{ base.allocate(256, 16, 0, flags::numa_node(1)) };
+    REQUIRE(reserved != nullptr);
+    base.deallocate(reserved, 256, 16);
+    gzn::fnd::base_allocator::set_numa_reservation(0);
+  } // SECTION("base_allocator flags")
+
+  SECTION("tracking_allocator") {
+    using gzn::fnd::allocation_stats;
+
+    gzn::fnd::tracking_allocator<gzn::fnd::base_allocator> tracker{
+      "test-tracking"
+    };
+    auto stats{ tracker.get_stats() };
+    REQUIRE(stats != nullptr);
+    REQUIRE(stats->get_label() == "test-tracking");
+
+    auto small{ tracker.allocate(16, 16, 0) };
+    auto big{ tracker.allocate(1000, 16, 0) };
+    REQUIRE(stats->live_bytes_count == 1016);
+    REQUIRE(stats->allocations_count == 2);
+    REQUIRE(stats->histogram[allocation_stats::bucket_of(16)] == 1);
+    REQUIRE(stats->histogram[allocation_stats::bucket_of(1000)] == 1);
+    REQUIRE(stats->has_leaks());
+
+    tracker.deallocate(big, 1000, 16);
+    tracker.deallocate(small, 16, 16);
+    REQUIRE(stats->live_bytes_count == 0);
+    REQUIRE(stats->peak_bytes_count == 1016);
+    REQUIRE_FALSE(stats->has_leaks());
+
+    gzn::fnd::tracking_allocator<gzn::fnd::base_allocator> same{
+      "test-tracking"
+    };
+    REQUIRE(same.get_stats() == stats);
+    REQUIRE(gzn::fnd::allocation_registry::find("test-tracking") == stats);
+
+    std::string const long_label(
+      gzn::fnd::constants::allocation_label_max_length + 8, 'l'
+    );
+    gzn::fnd::tracking_allocator<gzn::fnd::base_allocator> long_tracker{
+      long_label.c_str()
+    };
+    gzn::fnd::tracking_allocator<gzn::fnd::base_allocator> long_same{
+      long_label.c_str()
+    };
+    REQUIRE(long_tracker.get_stats() != nullptr);
+    REQUIRE(long_same.get_stats() == long_tracker.get_stats());
+    REQUIRE(gzn::fnd::allocation_registry::find(long_label) ==
+            long_tracker.get_stats());
+
+    REQUIRE(allocation_stats::bucket_of(1) == 0);
+    REQUIRE(allocation_stats::bucket_of(17) == 1);
+    REQUIRE(allocation_stats::bucket_of(1u << 30) ==
+            gzn::fnd::constants::allocation_histogram_buckets_count - 1);
+  } // SECTION("tracking_allocator")
+
+  SECTION("tracing_allocator") {
+    using gzn::fnd::allocation_event;
+    using gzn::fnd::allocation_event_kind;
+    using gzn::fnd::allocation_trace;
+
+    std::vector<allocation_event> events{};
+    allocation_trace::set_sink(
+      [](allocation_event const &event, void *user_data) {
+        static_cast<std::vector<allocation_event> *>(user_data)->push_back(
+          event
+        );
+      },
+      &events
+    );
+
+    gzn::fnd::tracing_allocator<gzn::fnd::base_allocator> tracer{ "trace" };
+    auto block{ tracer.allocate(48, 16, 0) };
+    tracer.deallocate(block, 48, 16);
+    allocation_trace::set_sink(nullptr);
+    REQUIRE_FALSE(allocation_trace::is_enabled());
+
+    REQUIRE(std::size(events) == 2);
+    REQUIRE(events[0].kind == allocation_event_kind::allocate);
+    REQUIRE(events[1].kind == allocation_event_kind::deallocate);
+    REQUIRE(events[0].id == events[1].id);
+    REQUIRE(events[0].bytes_count == 48);
+
+    auto file{ std::tmpfile() };
+    REQUIRE(file != nullptr);
+    for (auto const &event : events) {
+      allocation_trace::write_to_file(event, file);
+    }
+    std::rewind(file);
+
+    allocation_event event{};
+    REQUIRE(allocation_trace::read_from_file(file, event));
+    REQUIRE(event.kind == allocation_event_kind::allocate);
+    REQUIRE(event.id == events[0].id);
+    REQUIRE(event.alignment == 16);
+    REQUIRE(allocation_trace::read_from_file(file, event));
+    REQUIRE(event.kind == allocation_event_kind::deallocate);
+    REQUIRE_FALSE(allocation_trace::read_from_file(file, event));
+    std::fclose(file);
+  } // SECTION("tracing_allocator")
+
+  SECTION("block_pool_allocator") {
+    gzn::fnd::base_allocator base{ "test-alloc" };
+    gzn::fnd::block_pool_allocator<gzn::fnd::base_allocator> pool{
+      base, sizeof(vertex), alignof(vertex), 1024
+    };
+
+    // Packed: the free-list link needs more alignment than the blocks
+    static_assert(alignof(vertex) < alignof(void *));
+    static_assert(sizeof(vertex) % alignof(void *) != 0);
+
+    std::vector<void *> blocks{};
+    for (auto i{ 0 }; i < 256; ++i) {
+      auto block{ pool.allocate(sizeof(vertex), alignof(vertex), 0) };
+      REQUIRE(block != nullptr);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(block) % alignof(void *) == 0);
+      blocks.push_back(block);
+    }
+
+    auto last{ blocks.back() };
+    pool.deallocate(last, sizeof(vertex), alignof(vertex));
+    REQUIRE(pool.allocate(sizeof(vertex), alignof(vertex), 0) == last);
+
+    auto huge{ pool.allocate(4096, 16, 0) };
+    REQUIRE(huge != nullptr);
+    pool.deallocate(huge, 4096, 16);
+
+    // Block-sized requests a block can't serve aren't forwarded either:
+    // their deallocation would be taken for a pool block
+    REQUIRE(pool.allocate(sizeof(vertex), 64, 0) == nullptr);
+    REQUIRE(pool.allocate(sizeof(vertex), alignof(vertex), 2) == nullptr);
+
+    for (auto block : blocks) {
+      pool.deallocate(block, sizeof(vertex), alignof(vertex));
+    }
+  } // SECTION("block_pool_allocator")
+
+  SECTION("shared_block_pool_allocator") {
+    gzn::fnd::base_allocator base{ "test-alloc" };
+    gzn::fnd::shared_block_pool_allocator<gzn::fnd::base_allocator> pool{
+      base, 48, 16, 4096
+    };
+
+    auto constexpr threads_count{ 4 };
+    auto constexpr rounds_count{ 2000 };
+    std::vector<std::thread> threads{};
+    for (auto t{ 0 }; t < threads_count; ++t) {
+      threads.emplace_back([&pool, t] {
+        std::vector<int *> blocks{};
+        for (auto round{ 0 }; round < rounds_count; ++round) {
+          auto block{ static_cast<int *>(pool.allocate(48, 16, 0)) };
+          *block = t * rounds_count + round;
+          blocks.push_back(block);
+          if (round % 3 == 2) {
+            for (auto b : blocks) { pool.deallocate(b, 48, 16); }
+            blocks.clear();
+          }
+        }
+        for (auto b : blocks) { pool.deallocate(b, 48, 16); }
+      });
+    }
+    for (auto &thread : threads) { thread.join(); }
+
+    std::vector<void *> blocks{};
+    for (auto i{ 0 }; i < 64; ++i) { blocks.push_back(pool.allocate(48)); }
+    std::ranges::sort(blocks);
+    REQUIRE(std::ranges::adjacent_find(blocks) == std::end(blocks));
+    for (auto b : blocks) { pool.deallocate(b, 48); }
+  } // SECTION("shared_block_pool_allocator")
+
+  SECTION("virtual_arena_allocator") {
+    auto constexpr commit_bytes_count{
+      gzn::fnd::constants::virtual_arena_commit_bytes_count
+    };
+    gzn::fnd::virtual_arena_allocator arena{ 4 * commit_bytes_count };
+    REQUIRE(arena.reserved_bytes_count() == 4 * commit_bytes_count);
+    REQUIRE(arena.committed_bytes_count() == 0);
+
+    auto first{ static_cast<std::byte *>(arena.allocate(16, 16, 0)) };
+    REQUIRE(first != nullptr);
+    REQUIRE(arena.committed_bytes_count() == commit_bytes_count);
+    first[0] = std::byte{ 42 };
+
+    auto mark{ arena.mark() };
+    auto big{ static_cast<std::byte *>(
+      arena.allocate(2 * commit_bytes_count, 64, 0)
+    ) };
+    REQUIRE(big != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(big) % 64 == 0);
+    REQUIRE(arena.committed_bytes_count() == 3 * commit_bytes_count);
+    big[2 * commit_bytes_count - 1] = std::byte{ 1 };
+
+    arena.rewind(mark);
+    REQUIRE(arena.allocate(2 * commit_bytes_count, 64, 0) == big);
+
+    arena.reset();
+    REQUIRE(arena.committed_bytes_count() == 0);
+    auto again{ static_cast<std::byte *>(arena.allocate(16, 16, 0)) };
+    REQUIRE(again == first);
+    REQUIRE(again[0] == std::byte{ 0 });
+  } // SECTION("virtual_arena_allocator")
+
+  SECTION("try_expand") {
+    STATIC_REQUIRE(
+      gzn::fnd::util::expandable_allocator_type<gzn::fnd::base_allocator>
+    );
+    STATIC_REQUIRE(
+      gzn::fnd::util::reallocatable_allocator_type<gzn::fnd::base_allocator>
+    );
+    STATIC_REQUIRE_FALSE(
+      gzn::fnd::util::expandable_allocator_type<gzn::fnd::slab_allocator>
+    );
+
+    gzn::fnd::stack_arena_allocator<256> stack{};
+    auto first{ stack.allocate(16, 16, 0) };
+    REQUIRE(stack.try_expand(first, 16, 64));
+    auto second{ stack.allocate(16, 16, 0) };
+    REQUIRE_FALSE(stack.try_expand(first, 64, 128));
+    REQUIRE(stack.try_expand(second, 16, 32));
+    REQUIRE_FALSE(stack.try_expand(second, 32, 1024));
+
+    gzn::fnd::base_allocator                          base{ "test-alloc" };
+    gzn::fnd::frame_arena_allocator<gzn::fnd::base_allocator> arena{
+      base, 1024
+    };
+    auto block{ arena.allocate(32, 16, 0) };
+    REQUIRE(arena.try_expand(block, 32, 512));
+    REQUIRE(arena.allocate(16, 16, 0) ==
+            static_cast<std::byte *>(block) + 512);
+    REQUIRE_FALSE(arena.try_expand(block, 512, 600));
+
+    auto heap{ static_cast<int *>(base.allocate(64, 16, 0)) };
+    heap[0] = 42;
+    // Can't give the tail back, so it must not claim to shrink
+    REQUIRE_FALSE(base.try_expand(heap, 64, 16));
+    heap    = static_cast<int *>(base.reallocate(heap, 64, 4096, 16));
+    REQUIRE(heap != nullptr);
+    REQUIRE(heap[0] == 42);
+    base.deallocate(heap, 4096, 16);
+  } // SECTION("try_expand")
+
+  SECTION("buddy_offset_allocator") {
+    auto constexpr invalid{ gzn::fnd::constants::buddy_invalid_offset };
+
+    gzn::fnd::base_allocator                                   base{ "meta" };
+    gzn::fnd::buddy_offset_allocator<gzn::fnd::base_allocator> buddy{
+      base, 3 * 1024, 256
+    };
+    REQUIRE(buddy.stats().largest_free_block_bytes_count == 2048);
+    REQUIRE(buddy.stats().free_blocks_count == 2);
+
+    auto const a{ buddy.allocate(100) };
+    auto const b{ buddy.allocate(256) };
+    auto const c{ buddy.allocate(1000, 1024) };
+    REQUIRE(a != invalid);
+    REQUIRE(b != invalid);
+    REQUIRE(c != invalid);
+    REQUIRE(c % 1024 == 0);
+    REQUIRE(buddy.block_bytes_count(c) == 1024);
+    REQUIRE(buddy.stats().allocated_bytes_count == 1536);
+    REQUIRE(buddy.stats().fragmentation() > 0.0f);
+
+    REQUIRE(buddy.allocate(2048) == invalid);
+
+    buddy.deallocate(a);
+    buddy.deallocate(c);
+    buddy.deallocate(b);
+    auto const stats{ buddy.stats() };
+    REQUIRE(stats.allocated_bytes_count == 0);
+    REQUIRE(stats.allocations_count == 0);
+    REQUIRE(stats.free_blocks_count == 2);
+    REQUIRE(stats.fragmentation() < 0.34f);
+    REQUIRE(buddy.allocate(2048) == 0);
+  } // SECTION("buddy_offset_allocator")
+
+  SECTION("buddy_allocator") {
+    alignas(64) static std::byte storage[64 * 1024];
+
+    gzn::fnd::base_allocator                            base{ "meta" };
+    gzn::fnd::buddy_allocator<gzn::fnd::base_allocator> buddy{
+      base, storage, 64
+    };
+
+    std::vector<void *> blocks{};
+    for (auto i{ 1 }; i < 64; ++i) {
+      auto block{ buddy.allocate(static_cast<std::uint32_t>(i * 7), 16, 0) };
+      REQUIRE(block != nullptr);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(block) % 16 == 0);
+      blocks.push_back(block);
+    }
+    auto shifted{ buddy.allocate(40, 32, 8) };
+    REQUIRE((reinterpret_cast<std::uintptr_t>(shifted) + 8) % 32 == 0);
+    buddy.deallocate(shifted, 40, 32);
+    REQUIRE(buddy.allocate(40, 128, 8) == nullptr);
+
+    for (auto block : blocks) { buddy.deallocate(block, 0); }
+    REQUIRE(buddy.stats().allocated_bytes_count == 0);
+    REQUIRE(buddy.stats().largest_free_block_bytes_count == sizeof(storage));
+  } // SECTION("buddy_allocator")
+
 } // TEST_CASE("common", "[raw-data]")
@@ -0,0 +1,92 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/concurrent-pool.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+TEST_CASE("test: gzn::fnd::concurrent_pool", "[fnd][concurrent-pool]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-concurrent-pool" };
+
+  SECTION("single thread") {
+    fnd::concurrent_pool<u64> values{ alloc, 2 };
+    auto const a{ values.insert(1) };
+    auto const b{ values.insert(2) };
+    REQUIRE_FALSE(values.insert(3).is_valid());
+    REQUIRE(*values.get(a) == 1);
+
+    REQUIRE(values.remove(a));
+    REQUIRE_FALSE(values.remove(a));
+    REQUIRE(values.get(a) == nullptr);
+    REQUIRE(values.size() == 1);
+
+    auto const c{ values.insert(3) };
+    REQUIRE(c.location == a.location);
+    REQUIRE(values.get(a) == nullptr);
+    REQUIRE(*values.get(c) == 3);
+    REQUIRE(*values.get(b) == 2);
+  } // SECTION("single thread")
+
+  SECTION("stress") {
+    u32 constexpr threads_count{ 4 };
+    u32 constexpr iterations_count{ 20'000 };
+    u32 constexpr held_count{ 16 };
+
+    using pool_type = fnd::concurrent_pool<u64>;
+    pool_type values{ alloc, threads_count * held_count };
+
+    std::atomic<bool>                   done{ false };
+    std::atomic<usize>                  resolved{};
+    std::atomic<u64>                    failures{};
+    std::atomic<pool_type::handle_type> published{};
+    std::vector<std::thread>            writers{};
+
+    // Resolves whatever a writer published last, stale handles only miss
+    std::thread reader{ [&] {
+      while (!done.load(std::memory_order_acquire)) {
+        if (values.get(published.load(std::memory_order_relaxed))) {
+          resolved.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    } };
+
+    for (u32 t{}; t < threads_count; ++t) {
+      writers.emplace_back([&, t] {
+        std::vector<pool_type::handle_type> held{};
+        for (u32 i{}; i < iterations_count; ++i) {
+          u64 const value{ u64{ t } << 32 | i };
+          auto const handle{ values.insert(value) };
+          if (!handle.is_valid() || *values.get(handle) != value) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            continue;
+          }
+          held.push_back(handle);
+          published.store(handle, std::memory_order_relaxed);
+
+          if (held.size() == held_count) {
+            for (auto const h : held) {
+              if (!values.remove(h) || values.contains(h)) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+            held.clear();
+          }
+        }
+        for (auto const h : held) { values.remove(h); }
+      });
+    }
+
+    for (auto &writer : writers) { writer.join(); }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    REQUIRE(failures.load() == 0);
+    REQUIRE(values.size() == 0);
+  } // SECTION("stress")
+
+  REQUIRE(cmn::live_bytes_count(alloc) == 0);
+}
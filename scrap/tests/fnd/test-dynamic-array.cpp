@@ -1,9 +1,33 @@
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 
 #include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/allocators/virtual-arena.hpp>
 #include <gzn/fnd/containers/dynamic-array.hpp>
 
+namespace {
+
+struct relocatable {
+  bool static constexpr is_trivially_relocatable{ true };
+
+  std::unique_ptr<gzn::u64> value;
+};
+
+struct huge_pages_twicks {
+  gzn::u64 static constexpr grow_factor{
+    gzn::fnd::constants::default_grow_factor
+  };
+  gzn::u32 static constexpr allocation_flags{
+    gzn::fnd::allocation_flags::huge_pages
+  };
+};
+
+} // namespace
+
 TEST_CASE("test: gzn::fnd::dynamic_array", "[fnd][dynamic-array]") {
   using namespace gzn;
 
@@ -107,8 +131,14 @@ TEST_CASE("test: gzn::fnd::dynamic_array", "[fnd][dynamic-array]") {
     REQUIRE(arr0.capacity() == new_size);
 
     arr0.shrink_to_fit();
-    REQUIRE(arr0.data() != old_data);
+    REQUIRE(arr0.data() != nullptr);
     REQUIRE(arr0.size() == arr0.capacity());
+    REQUIRE(arr0[0].size == 1);
+
+    fnd::dynamic_array<std::string> arr1{ alloc };
+    arr1.emplace_back("a string long enough to live on the heap");
+    arr1.resize(64, arr1[0]);
+    REQUIRE(arr1[63] == arr1[0]);
 
   } // SECTION("reserve/reset/resize")
 
@@ -142,4 +172,170 @@ TEST_CASE("test: gzn::fnd::dynamic_array", "[fnd][dynamic-array]") {
 
   } // SECTION("data manipulation (push/pop/at)")
 
+  SECTION("insert & erase") {
+    fnd::dynamic_array<std::string> arr0{ alloc };
+    for (char c{ 'a' }; c <= 'e'; ++c) { arr0.push_back(std::string(1, c)); }
+
+    arr0.insert(arr0.begin(), arr0[4]);
+    REQUIRE(arr0.size() == 6);
+    REQUIRE(arr0[0] == "e");
+    REQUIRE(arr0[5] == "e");
+
+    std::array<std::string, 3> const extra{ "x", "y", "z" };
+    auto const gap{
+      arr0.insert(arr0.begin() + 2, std::begin(extra), std::end(extra))
+    };
+    REQUIRE(*gap == "x");
+    REQUIRE(arr0.size() == 9);
+
+    auto const next{ arr0.erase(arr0.begin() + 1, arr0.begin() + 4) };
+    REQUIRE(*next == "z");
+    REQUIRE(arr0.size() == 6);
+
+    arr0.fast_erase(arr0.begin());
+    std::array<std::string, 5> const expected{ "e", "z", "b", "c", "d" };
+    REQUIRE(std::equal(arr0.begin(), arr0.end(), std::begin(expected)));
+
+    arr0.clear();
+    REQUIRE(arr0.empty());
+    REQUIRE(arr0.data() != nullptr);
+  } // SECTION("insert & erase")
+
+  SECTION("trivially relocatable") {
+    gzn_static_assert(fnd::util::trivially_relocatable_type<relocatable>);
+    gzn_static_assert(fnd::util::trivially_relocatable_type<grow_info>);
+    gzn_static_assert(!fnd::util::trivially_relocatable_type<std::string>);
+
+    fnd::dynamic_array<relocatable> arr0{ alloc };
+    for (u64 i{}; i < 100; ++i) {
+      arr0.emplace_back(std::make_unique<u64>(i));
+    }
+    arr0.erase(arr0.begin(), arr0.begin() + 10);
+    arr0.emplace(arr0.begin(), std::make_unique<u64>(1'000));
+
+    REQUIRE(arr0.size() == 91);
+    REQUIRE(*arr0[0].value == 1'000);
+    REQUIRE(*arr0[1].value == 10);
+    REQUIRE(*arr0[90].value == 99);
+  } // SECTION("trivially relocatable")
+
+  SECTION("bulk operations") {
+    std::array<u32, 64> source{};
+    for (u32 i{}; auto &value : source) { value = i++; }
+
+    fnd::dynamic_array<u32> arr0{ alloc };
+    arr0.append_range(std::span{ source }.first(16));
+    auto const appended{ arr0.append_range(source) };
+    REQUIRE(arr0.size() == 80);
+    REQUIRE(*appended == 0);
+    REQUIRE(arr0[15] == 15);
+    REQUIRE(arr0[79] == 63);
+
+    arr0.assign(std::span{ source }.last(8));
+    REQUIRE(arr0.size() == 8);
+    REQUIRE(arr0[0] == 56);
+
+    arr0.assign(4, 7u);
+    REQUIRE(arr0.size() == 4);
+    REQUIRE(arr0[3] == 7);
+
+    arr0.resize_uninitialized(128);
+    REQUIRE(arr0.size() == 128);
+    REQUIRE(arr0.capacity() >= 128);
+    REQUIRE(arr0[3] == 7);
+
+    fnd::dynamic_array<std::string> arr1{ alloc };
+    arr1.emplace_back_n(3, "aa");
+    auto const tail{ arr1.emplace_back_n(2, "b") };
+    REQUIRE(arr1.size() == 5);
+    REQUIRE(arr1[2] == "aa");
+    REQUIRE(*tail == "b");
+
+    std::array<std::string, 2> const words{ "x", "y" };
+    arr1.assign(words);
+    REQUIRE(arr1.size() == 2);
+    REQUIRE(arr1[1] == "y");
+
+    // A part of the array itself, copied before the old elements go away
+    arr1.assign(std::array<std::string, 4>{ "long enough for the heap 0",
+                                            "long enough for the heap 1",
+                                            "long enough for the heap 2",
+                                            "long enough for the heap 3" });
+    arr1.assign(std::span{ arr1 }.subspan(1, 2));
+    REQUIRE(arr1.size() == 2);
+    REQUIRE(arr1[0] == "long enough for the heap 1");
+    REQUIRE(arr1[1] == "long enough for the heap 2");
+
+    arr0.assign(std::span{ arr0 }.last(2));
+    REQUIRE(arr0.size() == 2);
+    arr0.assign(3, arr0[0]);
+    REQUIRE(arr0[2] == arr0[0]);
+  } // SECTION("bulk operations")
+
+  SECTION("in-place growth") {
+    fnd::virtual_arena_allocator arena{ 1024 * 1024 };
+    fnd::dynamic_array<u64, fnd::virtual_arena_allocator> arr0{ arena, 16 };
+
+    auto const old_data{ std::data(arr0) };
+    for (u64 i{}; i < 10'000; ++i) { arr0.emplace_back(i); }
+    REQUIRE(arr0.data() == old_data);
+    REQUIRE(arr0.size() == 10'000);
+    REQUIRE(arr0[9'999] == 9'999);
+    REQUIRE(arena.allocated_bytes_count() == arr0.capacity_in_bytes());
+
+    arr0.shrink_to_fit();
+    REQUIRE(arr0.data() == old_data);
+    REQUIRE(arena.allocated_bytes_count() == arr0.size_in_bytes());
+
+    fnd::dynamic_array<u64> arr1{ alloc };
+    for (u64 i{}; i < 10'000; ++i) { arr1.emplace_back(i); }
+    REQUIRE(arr1[0] == 0);
+    REQUIRE(arr1[9'999] == 9'999);
+
+    // base_allocator can't shrink in place, the elements move to a block
+    // of the right size
+    fnd::dynamic_array<std::string> arr2{ alloc, 1'000 };
+    arr2.emplace_back_n(10, "text");
+    auto const wide_data{ std::data(arr2) };
+    REQUIRE(arr2.shrink_to_fit() == 10);
+    REQUIRE(arr2.data() != wide_data);
+    REQUIRE(arr2.capacity() == 10);
+    REQUIRE(arr2[9] == "text");
+  } // SECTION("in-place growth")
+
+  SECTION("allocation flags survive growth") {
+    usize constexpr huge_page{ 2 * 1024 * 1024 };
+    auto const      is_huge_page_aligned{ [](void const *data) {
+      return reinterpret_cast<std::uintptr_t>(data) % huge_page == 0;
+    } };
+
+    fnd::dynamic_array<u8, fnd::base_allocator, huge_pages_twicks> arr{
+      alloc, 2 * huge_page
+    };
+    REQUIRE(is_huge_page_aligned(arr.data()));
+    arr.reserve(4 * huge_page);
+    REQUIRE(is_huge_page_aligned(arr.data()));
+  } // SECTION("allocation flags survive growth")
+
+  SECTION("allocator context") {
+    fnd::dynamic_array<u64, fnd::any_allocator> arr0{};
+    REQUIRE(arr0.get_allocator().is_default());
+    arr0.emplace_back(1u);
+    REQUIRE(arr0[0] == 1);
+
+    fnd::stack_arena_allocator<1024> arena{};
+    {
+      fnd::scoped_allocator const scope{ arena };
+      REQUIRE(fnd::allocator_context::depth() == 1);
+
+      fnd::dynamic_array<u64, fnd::any_allocator> arr1{ 8 };
+      REQUIRE(arr1.get_allocator() == fnd::any_allocator{ arena });
+      for (u64 i{}; i < 8; ++i) { arr1.emplace_back(i); }
+      REQUIRE(arena.allocated_bytes_count() >= arr1.size_in_bytes());
+      REQUIRE(arr1[7] == 7);
+    }
+    REQUIRE(fnd::allocator_context::depth() == 0);
+    REQUIRE(fnd::allocator_context::current().is_default());
+  } // SECTION("allocator context")
+
 } // TEST_CASE("common", "[raw-data]")
@@ -0,0 +1,107 @@
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/flat-map.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+TEST_CASE("test: gzn::fnd::flat_map", "[fnd][flat-map]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-flat-map" };
+
+  using map_type = fnd::flat_map<int, std::string, decltype(alloc)>;
+  using record   = map_type::record_type;
+
+  SECTION("insert, find, erase") {
+    map_type map{ alloc };
+    REQUIRE(map.empty());
+    REQUIRE(map.find(1) == nullptr);
+
+    REQUIRE(map.insert(3, "three").inserted);
+    REQUIRE(map.insert(1, "one").inserted);
+    REQUIRE(map.insert(2, "two").inserted);
+    REQUIRE_FALSE(map.insert(2, "deux").inserted);
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.find(2)->value == "two");
+    REQUIRE(map.begin()->key == 1);
+    REQUIRE((map.end() - 1)->key == 3);
+
+    map.insert_or_assign(2, "deux");
+    REQUIRE(map.find(2)->value == "deux");
+    map[4] = "four";
+    REQUIRE(map.size() == 4);
+    REQUIRE(map[4] == "four");
+
+    REQUIRE(map.erase(1));
+    REQUIRE_FALSE(map.erase(1));
+    REQUIRE_FALSE(map.contains(1));
+    REQUIRE(map.begin()->key == 2);
+  } // SECTION("insert, find, erase")
+
+  SECTION("batched insert") {
+    map_type map{ alloc };
+    map.insert(5, "old five");
+    map.insert(1, "old one");
+
+    std::vector<record> const batch{
+      { 9, "nine" }, { 5, "five" }, { 3, "three" },
+      { 7, "seven" }, { 3, "three" }, { 0, "zero" },
+    };
+    map.insert_range(batch);
+    REQUIRE(map.size() == 6);
+    REQUIRE(map.find(5)->value == "old five");
+    REQUIRE(map.find(3)->value == "three");
+
+    int previous{ -1 };
+    for (auto const &[key, value] : map) {
+      REQUIRE(previous < key);
+      previous = key;
+    }
+  } // SECTION("batched insert")
+
+  SECTION("eytzinger layout") {
+    using fast_map = fnd::flat_map<
+      int,
+      int,
+      decltype(alloc),
+      fnd::flat_map_eytzinger_twicks<fnd::record<int, int>>>;
+    using slow_map = fnd::flat_map<int, int, decltype(alloc)>;
+
+    std::vector<fnd::record<int, int>> batch{};
+    for (int i{}; i < 1'000; ++i) { batch.push_back({ i * 7 % 1'001, i }); }
+
+    fast_map fast{ alloc, batch };
+    slow_map slow{ alloc, batch };
+    REQUIRE(fast.size() == slow.size());
+    for (int key{ -1 }; key < 1'005; ++key) {
+      REQUIRE(fast.lower_bound(key) - fast.begin() ==
+              slow.lower_bound(key) - slow.begin());
+      REQUIRE(fast.contains(key) == slow.contains(key));
+    }
+
+    fast.erase(7);
+    fast.insert(7, 1);
+    fast.insert(2'000, 2);
+    REQUIRE(fast.find(7)->value == 1);
+    REQUIRE(fast.find(2'000)->value == 2);
+    REQUIRE(fast.lower_bound(1'500)->key == 2'000);
+  } // SECTION("eytzinger layout")
+
+  SECTION("set") {
+    fnd::flat_set<int, decltype(alloc)> set{ alloc };
+    REQUIRE(set.insert(4).second);
+    REQUIRE_FALSE(set.insert(4).second);
+
+    std::vector<int> const batch{ 8, 2, 6, 2, 4 };
+    set.insert_range(batch);
+    REQUIRE(set.size() == 4);
+    REQUIRE(*set.begin() == 2);
+    REQUIRE(set.contains(6));
+    REQUIRE_FALSE(set.contains(5));
+  } // SECTION("set")
+
+  REQUIRE(cmn::allocations_count(alloc) > 0);
+  REQUIRE(cmn::live_bytes_count(alloc) == 0);
+}
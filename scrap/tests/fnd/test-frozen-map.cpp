@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/frozen-map.hpp>
+#include <gzn/fnd/name.hpp>
+
+namespace {
+
+using namespace gzn;
+using namespace gzn::fnd::name_literals;
+
+enum class color : u8 { none, red, green, blue };
+
+auto constexpr colors_by_code{
+  fnd::make_frozen_map<u32, color>({
+    { 0xFF'00'00, color::red   },
+    { 0x00'FF'00, color::green },
+    { 0x00'00'FF, color::blue  },
+  })
+};
+
+auto constexpr colors_by_name{
+  fnd::make_frozen_map<fnd::s8name_view, color>({
+    { "red"_name,   color::red   },
+    { "green"_name, color::green },
+    { "blue"_name,  color::blue  },
+  })
+};
+
+gzn_static_assert(colors_by_code.find(0x00'FF'00u)->value == color::green);
+gzn_static_assert(colors_by_code.find(0x12'34'56u) == nullptr);
+gzn_static_assert(colors_by_code.find(0x00'00'FF)->value == color::blue);
+gzn_static_assert(colors_by_code.find(u64{ 0xFF'00'00 })->value == color::red);
+gzn_static_assert(colors_by_name.find("blue"_name)->value == color::blue);
+gzn_static_assert(!colors_by_name.contains("cyan"_name));
+
+} // namespace
+
+TEST_CASE("test: gzn::fnd::frozen_map", "[fnd][frozen-map]") {
+  SECTION("lookup") {
+    REQUIRE(colors_by_code.size() == 3);
+    REQUIRE(colors_by_code.find(0xFF'00'00u)->value == color::red);
+    REQUIRE(colors_by_code.find(0u) == nullptr);
+
+    fnd::s8name const green{ "green" };
+    REQUIRE(colors_by_name.find(green)->value == color::green);
+    REQUIRE(colors_by_name.find(fnd::s8name{ "yellow" }) == nullptr);
+  } // SECTION("lookup")
+
+  SECTION("many keys") {
+    auto constexpr squares{ [] consteval {
+      fnd::record<u64, u64> records[200]{};
+      for (u64 i{}; i < 200; ++i) { records[i] = { i * 7919, i * i }; }
+      return fnd::frozen_map<u64, u64, 200>{ std::move(records) };
+    }() };
+
+    for (u64 i{}; i < 200; ++i) {
+      REQUIRE(squares.find(i * 7919)->value == i * i);
+      REQUIRE(squares.find(i * 7919 + 1) == nullptr);
+    }
+
+    usize visited{};
+    for (auto const &record : squares) { visited += record.key % 7919 == 0; }
+    REQUIRE(visited == 200);
+  } // SECTION("many keys")
+}
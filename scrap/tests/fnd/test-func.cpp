@@ -0,0 +1,115 @@
+#include <array>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/func.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+namespace {
+
+auto twice(int const x) -> int { return x * 2; }
+
+struct length_of {
+  std::string text;
+
+  auto operator()() const -> gzn::usize { return std::size(text); }
+};
+
+} // namespace
+
+TEST_CASE("test: gzn::fnd::move_only_func", "[fnd][func]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-func" };
+
+  SECTION("inline capacity") {
+    std::array<u64, 6> const payload{ 1, 2, 3, 4, 5, 6 };
+    auto const               at{ [payload](usize const i) {
+      return payload[i];
+    } };
+
+    auto const before{ cmn::allocations_count(alloc) };
+    fnd::move_only_func<u64(usize)> small{ alloc, at };
+    REQUIRE(cmn::allocations_count(alloc) == before + 1);
+
+    fnd::move_only_func<u64(usize), 64> wide{ alloc, at };
+    REQUIRE(cmn::allocations_count(alloc) == before + 1);
+    REQUIRE(wide(2) == small(2));
+
+    auto moved{ std::move(small) };
+    REQUIRE_FALSE(small);
+    REQUIRE(moved(5) == 6);
+
+    moved = nullptr;
+    REQUIRE_FALSE(moved);
+    REQUIRE(cmn::live_bytes_count(alloc) == 0);
+  } // SECTION("inline capacity")
+
+  SECTION("copyable") {
+    std::array<u64, 8> const payload{ 1, 2, 3, 4, 5, 6, 7, 8 };
+    fnd::copyable_func<u64(usize) const> const original{
+      alloc, [payload](usize const i) { return payload[i]; }
+    };
+
+    auto copy{ original };
+    REQUIRE(copy(3) == 4);
+    copy = original;
+    REQUIRE(copy(7) == 8);
+
+    fnd::move_only_func<u64(usize) const> const owned{ alloc, original };
+    REQUIRE(owned(0) == 1);
+    REQUIRE(original(0) == 1);
+  } // SECTION("copyable")
+
+  REQUIRE(cmn::live_bytes_count(alloc) == 0);
+}
+
+TEST_CASE("test: gzn::fnd::inplace_func", "[fnd][func]") {
+  using namespace gzn;
+
+  std::array<u64, 4> const payload{ 1, 2, 3, 4 };
+  fnd::inplace_func<u64(usize), 48> func{ [payload](usize const i) {
+    return payload[i];
+  } };
+  REQUIRE(func(2) == 3);
+
+  auto moved{ std::move(func) };
+  REQUIRE_FALSE(func);
+  REQUIRE(moved(3) == 4);
+
+  fnd::inplace_func<int(int)> pointer{ &twice };
+  REQUIRE(pointer(21) == 42);
+  REQUIRE_FALSE(fnd::inplace_func<int(int)>{ nullptr });
+
+  fnd::inplace_func<usize()> owning{ std::in_place_type<length_of>,
+                                     "captured" };
+  fnd::inplace_func<usize()> other{};
+  swap(owning, other);
+  REQUIRE_FALSE(owning);
+  REQUIRE(other() == 8);
+}
+
+TEST_CASE("test: gzn::fnd::function_ref", "[fnd][func]") {
+  using namespace gzn;
+
+  auto const sum{ [](fnd::function_ref<int(int) const> const func) {
+    int total{};
+    for (int i{}; i < 4; ++i) { total += func(i); }
+    return total;
+  } };
+
+  int  calls{};
+  auto counting{ [&calls](int const x) {
+    ++calls;
+    return x;
+  } };
+  REQUIRE(sum(counting) == 6);
+  REQUIRE(calls == 4);
+  REQUIRE(sum(twice) == 12);
+
+  auto const negate{ [](int const x) noexcept { return -x; } };
+  fnd::function_ref<int(int) noexcept> const noexcept_ref{ negate };
+  REQUIRE(noexcept_ref(5) == -5);
+  static_assert(sizeof(noexcept_ref) == 2 * sizeof(void *));
+}
@@ -0,0 +1,152 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/dictionary.hpp>
+#include <gzn/fnd/name.hpp>
+
+TEST_CASE("test: gzn::fnd::hash_map", "[fnd][hash-map]") {
+  using namespace gzn;
+
+  fnd::base_allocator alloc{};
+
+  SECTION("constructors") {
+    fnd::hash_map<int, double> const map0{ alloc };
+    REQUIRE(map0.empty());
+    REQUIRE(map0.capacity() == 0);
+    REQUIRE(map0.find(42) == nullptr);
+    REQUIRE(map0.begin() == map0.end());
+
+    fnd::hash_map<int, double> const map1{ alloc, 100 };
+    REQUIRE(map1.empty());
+    REQUIRE(map1.capacity() >= 100);
+
+    fnd::hash_map<int, double> map2{
+      alloc,
+      { { 1, 1.0 }, { 2, 2.0 }, { 3, 3.0 } }
+    };
+    REQUIRE(map2.size() == 3);
+    REQUIRE(map2.find(2)->value == 2.0);
+
+    fnd::hash_map<int, double> const map3{ map2 };
+    REQUIRE(map3.size() == 3);
+    REQUIRE(map3.find(3)->value == 3.0);
+
+    fnd::hash_map<int, double> const map4{ std::move(map2) };
+    REQUIRE(map4.size() == 3);
+    REQUIRE(map4.find(1)->value == 1.0);
+
+    REQUIRE(map2.empty());
+    REQUIRE(map2.capacity() == 0);
+    REQUIRE(map2.find(1) == nullptr);
+  } // SECTION("constructors")
+
+  SECTION("insert, find & erase") {
+    fnd::hash_map<u32, u32> map{ alloc };
+    u32 constexpr count{ 10'000 };
+
+    for (u32 i{}; i < count; ++i) {
+      auto const result{ map.insert(i, i * 2) };
+      REQUIRE(result.inserted);
+      REQUIRE(result.record->key == i);
+    }
+    REQUIRE(map.size() == count);
+    REQUIRE_FALSE(map.insert(7, 0).inserted);
+    REQUIRE(map.find(7u)->value == 14);
+
+    for (u32 i{}; i < count; ++i) {
+      auto const record{ map.find(i) };
+      REQUIRE(record != nullptr);
+      REQUIRE(record->value == i * 2);
+    }
+    REQUIRE(map.find(count) == nullptr);
+
+    for (u32 i{}; i < count; i += 2) { REQUIRE(map.erase(i)); }
+    REQUIRE_FALSE(map.erase(0u));
+    REQUIRE(map.size() == count / 2);
+    for (u32 i{}; i < count; ++i) { REQUIRE(map.contains(i) == (i % 2 != 0)); }
+
+    usize visited{};
+    for (auto const &record : map) {
+      REQUIRE(record.key % 2 != 0);
+      ++visited;
+    }
+    REQUIRE(visited == count / 2);
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.find(1u) == nullptr);
+  } // SECTION("insert, find & erase")
+
+  SECTION("mixed key types") {
+    fnd::hash_map<u64, int> map{ alloc };
+    map[u64{ 1 }] = 10;
+
+    REQUIRE(map.find(1) != nullptr);
+    REQUIRE(map.find(1)->value == 10);
+    REQUIRE(map.contains(u8{ 1 }));
+
+    map[1] = 20;
+    REQUIRE(map.size() == 1);
+    REQUIRE(map.find(u64{ 1 })->value == 20);
+
+    REQUIRE_FALSE(map.try_emplace(1, 30).inserted);
+    REQUIRE(map.erase(1));
+    REQUIRE(map.empty());
+  } // SECTION("mixed key types")
+
+  SECTION("churn keeps capacity bounded") {
+    fnd::hash_map<u64, u64> map{ alloc, 64 };
+    auto const capacity{ map.capacity() };
+
+    for (u64 i{}; i < 100'000; ++i) {
+      map[i] = i;
+      if (i >= 32) { REQUIRE(map.erase(i - 32)); }
+    }
+    REQUIRE(map.size() == 32);
+    REQUIRE(map.capacity() == capacity);
+  } // SECTION("churn keeps capacity bounded")
+
+  SECTION("string keys") {
+    fnd::hash_map<std::string, int> map{ alloc };
+    map["alpha"] = 1;
+    map["beta"]  = 2;
+    map[""]      = 3;
+
+    REQUIRE(map.find(std::string_view{ "alpha" })->value == 1);
+    REQUIRE(map.find(std::string_view{ "beta" })->value == 2);
+    REQUIRE(map.find(std::string_view{}) != nullptr);
+    REQUIRE(map.find(std::string_view{ "gamma" }) == nullptr);
+
+    auto const result{ map.insert_or_assign(std::string{ "alpha" }, 10) };
+    REQUIRE_FALSE(result.inserted);
+    REQUIRE(map.find(std::string{ "alpha" })->value == 10);
+
+    std::string const beta{ "beta" };
+    REQUIRE(map.find(beta.c_str())->value == 2);
+    REQUIRE(fnd::key_hasher{}(beta.c_str()) ==
+            fnd::key_hasher{}(std::string_view{ "beta" }));
+    REQUIRE(fnd::key_hasher{}(static_cast<char const *>(nullptr)) ==
+            fnd::key_hasher{}(std::string_view{}));
+  } // SECTION("string keys")
+
+  SECTION("name keys") {
+    using namespace fnd::name_literals;
+
+    fnd::hash_map<fnd::s8name, int> map{ alloc };
+    map.insert(fnd::s8name{ "textures/albedo" }, 1);
+    map.insert(fnd::s8name{ "shaders/lit" }, 2);
+
+    REQUIRE(map.find("textures/albedo"_name)->value == 1);
+    REQUIRE(map.find(fnd::s8name{ "shaders/lit" })->value == 2);
+    REQUIRE(map.find("shaders/unlit"_name) == nullptr);
+  } // SECTION("name keys")
+
+  SECTION("allocator context") {
+    fnd::hash_map<int, int, fnd::any_allocator> map{
+      { { 1, 2 }, { 3, 4 } }
+    };
+    REQUIRE(map.get_allocator().is_default());
+    REQUIRE(map.find(3)->value == 4);
+  } // SECTION("allocator context")
+}
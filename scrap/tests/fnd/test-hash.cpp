@@ -1,9 +1,15 @@
+#include <cstdio>
+#include <filesystem>
 #include <memory_resource>
+#include <random>
+#include <string_view>
 #include <thread>
 
 #include <catch2/catch_test_macros.hpp>
 #include <gzn/fnd/allocators.hpp>
+#include <gzn/fnd/hash-tree.hpp>
 #include <gzn/fnd/hash.hpp>
+#include <gzn/fnd/mapped-file.hpp>
 
 #include "common/genstr.hpp"
 
@@ -85,3 +91,144 @@ TEST_CASE("test: gzn::fnd::hash", "[fnd][hash]") {
   REQUIRE(std::size(elements) / 8zu >= enthropy);
 
 } // TEST_CASE("common", "[raw-data]")
+
+TEST_CASE("test: gzn::fnd::hasher", "[fnd][hash]") {
+  using namespace gzn;
+
+  std::mt19937_64   gen{ 42 };
+  std::vector<byte> data(2'000);
+  for (auto &value : data) { value = static_cast<byte>(gen()); }
+
+  auto const one_shot{ [](std::span<byte const> const key) {
+    return fnd::hash<byte>({ .key = key, .seed = 7 });
+  } };
+
+  SECTION("same digest as one-shot") {
+    for (usize length{}; length <= std::size(data); length += 1 + length / 8) {
+      std::span<byte const> const key{ std::data(data), length };
+
+      fnd::hasher whole{ 7 };
+      whole.update(key);
+      REQUIRE(whole.finalize() == one_shot(key));
+
+      fnd::hasher chunked{ 7 };
+      for (auto rest{ key }; !std::empty(rest);) {
+        auto const count{ std::min<usize>(1 + gen() % 300, std::size(rest)) };
+        chunked.update(rest.first(count));
+        rest = rest.subspan(count);
+      }
+      REQUIRE(chunked.finalize() == one_shot(key));
+    }
+  } // SECTION("same digest as one-shot")
+
+  SECTION("characters") {
+    std::string_view const text{ "assets/shaders/forward.spv" };
+    for (usize length{}; length <= std::size(text); ++length) {
+      fnd::basic_hasher<char> chunked{};
+      chunked.update({ std::data(text), length / 2 });
+      chunked.update({ std::data(text) + length / 2, length - length / 2 });
+      REQUIRE(
+        chunked.finalize() ==
+        fnd::hash<char>({ .key{ std::data(text), length } })
+      );
+    }
+  } // SECTION("characters")
+
+  SECTION("every byte counts") {
+    std::span<byte const> const key{ std::data(data), 1'000 };
+    auto const                  digest{ one_shot(key) };
+    for (usize i{}; i < std::size(key); ++i) {
+      auto changed{ data };
+      changed[i] ^= byte{ 1 };
+      REQUIRE(one_shot({ std::data(changed), std::size(key) }) != digest);
+    }
+  } // SECTION("every byte counts")
+}
+
+TEST_CASE("test: gzn::fnd::hash_batch", "[fnd][hash]") {
+  using namespace gzn;
+
+  std::mt19937_64   gen{ 7 };
+  std::vector<char> text(4'000);
+  for (auto &value : text) { value = static_cast<char>(gen()); }
+
+  std::vector<fnd::hash_key_span<char>> keys{};
+  for (usize offset{}; std::size(keys) < 1'000;) {
+    // Mostly short keys with a few long ones in between
+    auto const length{ gen() % 8 == 0 ? 17 + gen() % 40 : gen() % 17 };
+    keys.emplace_back(std::data(text) + offset, length);
+    offset = (offset + length) % (std::size(text) - 64);
+  }
+
+  for (u64 const seed : { 0ull, 0x1234'5678ull }) {
+    std::vector<u64> digests(std::size(keys));
+    fnd::hash_batch<char>(keys, digests, seed);
+    for (usize i{}; i < std::size(keys); ++i) {
+      REQUIRE(
+        digests[i] == fnd::hash<char>({ .key = keys[i], .seed = seed })
+      );
+    }
+  }
+}
+
+TEST_CASE("test: gzn::fnd::hash_tree", "[fnd][hash]") {
+  using namespace gzn;
+
+  std::mt19937_64   gen{ 11 };
+  std::vector<byte> data(100'000);
+  for (auto &value : data) { value = static_cast<byte>(gen()); }
+
+  auto const tree{ [&](std::span<byte const> const key, u32 threads_count) {
+    return fnd::hash_tree({
+      .data          = key,
+      .seed          = 3,
+      .leaf_bytes    = 4'096,
+      .threads_count = threads_count,
+    });
+  } };
+
+  SECTION("independent of threads count") {
+    for (usize const length : { 0uz, 1uz, 4'096uz, 4'097uz, 100'000uz }) {
+      std::span<byte const> const key{ std::data(data), length };
+      auto const                  digest{ tree(key, 1) };
+      for (u32 const threads_count : { 0u, 2u, 3u, 8u, 64u }) {
+        REQUIRE(tree(key, threads_count) == digest);
+      }
+    }
+  } // SECTION("independent of threads count")
+
+  SECTION("every leaf counts") {
+    auto const digest{ tree(data, 4) };
+    for (usize i{}; i < std::size(data); i += 997) {
+      auto changed{ data };
+      changed[i] ^= byte{ 1 };
+      REQUIRE(tree(changed, 4) != digest);
+    }
+    REQUIRE(tree({ std::data(data), std::size(data) - 1 }, 4) != digest);
+    REQUIRE(fnd::hash_tree({ .data = data, .leaf_bytes = 4'096 }) != digest);
+  } // SECTION("every leaf counts")
+
+  SECTION("mapped file") {
+    auto const path{
+      std::filesystem::temp_directory_path() / "gzn-test-hash-tree.bin"
+    };
+    auto const file{ std::fopen(path.string().c_str(), "wb") };
+    REQUIRE(file != nullptr);
+    std::fwrite(std::data(data), 1, std::size(data), file);
+    std::fclose(file);
+
+    {
+      fnd::mapped_file mapped{ path.string().c_str() };
+      REQUIRE(mapped.is_valid());
+      REQUIRE(mapped.size() == std::size(data));
+      REQUIRE(tree(mapped.bytes(), 4) == tree(data, 1));
+
+      auto const moved{ std::move(mapped) };
+      REQUIRE_FALSE(mapped.is_valid());
+      REQUIRE(moved.is_valid());
+    }
+    std::filesystem::remove(path);
+
+    REQUIRE_FALSE(fnd::mapped_file{ path.string().c_str() }.is_valid());
+  } // SECTION("mapped file")
+}
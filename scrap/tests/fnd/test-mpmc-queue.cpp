@@ -0,0 +1,72 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/mpmc-queue.hpp>
+
+TEST_CASE("test: gzn::fnd::mpmc_queue", "[fnd][mpmc-queue]") {
+  using namespace gzn;
+
+  fnd::base_allocator alloc{};
+
+  SECTION("single thread") {
+    fnd::mpmc_queue<std::unique_ptr<u32>> queue{ alloc, 2 };
+    REQUIRE(queue.capacity() == 2);
+
+    REQUIRE(queue.try_push(std::make_unique<u32>(1)));
+    REQUIRE(queue.try_emplace(std::make_unique<u32>(2)));
+    REQUIRE_FALSE(queue.try_push(std::make_unique<u32>(3)));
+    REQUIRE(queue.size() == 2);
+
+    std::unique_ptr<u32> value{};
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(*value == 1);
+    REQUIRE(queue.try_push(std::make_unique<u32>(3)));
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(*value == 2);
+
+    // Left in the queue, the destructor has to release it
+    REQUIRE(queue.size() == 1);
+  } // SECTION("single thread")
+
+  SECTION("contention") {
+    u32 constexpr producers_count{ 4 };
+    u32 constexpr consumers_count{ 4 };
+    u64 constexpr per_producer{ 50'000 };
+
+    u64 constexpr total{ producers_count * per_producer };
+
+    fnd::mpmc_queue<u64>     queue{ alloc, 128 };
+    std::atomic<u64>         sum{};
+    std::atomic<u64>         popped{};
+    std::vector<std::thread> threads{};
+
+    for (u32 p{}; p < producers_count; ++p) {
+      threads.emplace_back([&queue] {
+        for (u64 i{ 1 }; i <= per_producer; ++i) {
+          while (!queue.try_push(i)) { std::this_thread::yield(); }
+        }
+      });
+    }
+    for (u32 c{}; c < consumers_count; ++c) {
+      threads.emplace_back([&] {
+        u64 local_sum{};
+        u64 value{};
+        while (popped.load(std::memory_order_relaxed) < total) {
+          if (queue.try_pop(value)) {
+            local_sum += value;
+            popped.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+        sum.fetch_add(local_sum, std::memory_order_relaxed);
+      });
+    }
+    for (auto &thread : threads) { thread.join(); }
+
+    REQUIRE(popped.load() == total);
+    REQUIRE(sum.load() == total * (per_producer + 1) / 2);
+    REQUIRE(queue.empty());
+  } // SECTION("contention")
+}
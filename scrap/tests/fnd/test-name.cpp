@@ -1,4 +1,10 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/name-table.hpp>
 #include <gzn/fnd/name.hpp>
 
 TEST_CASE("test: gzn::fnd::name", "[fnd][owner]") {
@@ -23,3 +29,75 @@ TEST_CASE("test: gzn::fnd::name", "[fnd][owner]") {
   }
 
 } // TEST_CASE("common", "[raw-data]")
+
+TEST_CASE("test: gzn::fnd::name_table", "[fnd][name]") {
+  using namespace gzn;
+
+  auto const bytes_of{ [](std::string_view const text) {
+    return std::as_bytes(std::span{ text });
+  } };
+  auto const text_of{ [](std::span<byte const> const bytes) {
+    return std::string_view{
+      reinterpret_cast<char const *>(std::data(bytes)), std::size(bytes)
+    };
+  } };
+
+  SECTION("intern and find") {
+    auto const size{ fnd::name_table::size() };
+    std::string text{ "textures/albedo" };
+    auto const  hash{ fnd::hash<char>({ .key = text }) };
+
+    auto const interned{ fnd::name_table::intern(hash, bytes_of(text)) };
+    REQUIRE(text_of(interned) == "textures/albedo");
+    REQUIRE(std::data(interned) != static_cast<void *>(std::data(text)));
+    REQUIRE(fnd::name_table::size() == size + 1);
+
+    text = "overwritten";
+    REQUIRE(text_of(fnd::name_table::find(hash)) == "textures/albedo");
+    REQUIRE(
+      std::data(fnd::name_table::intern(hash, interned)) == std::data(interned)
+    );
+    REQUIRE(fnd::name_table::size() == size + 1);
+    REQUIRE(std::empty(fnd::name_table::find(hash + 1)));
+  } // SECTION("intern and find")
+
+  SECTION("concurrent interning") {
+    usize constexpr threads_count{ 4 };
+    usize constexpr names_count{ 2'000 };
+
+    std::vector<std::string> texts{};
+    for (usize i{}; i < names_count; ++i) {
+      texts.push_back("entities/" + std::to_string(i));
+    }
+
+    std::atomic<usize>        mismatches{};
+    std::vector<std::jthread> threads{};
+    for (usize t{}; t < threads_count; ++t) {
+      threads.emplace_back([&] {
+        for (auto const &text : texts) {
+          auto const hash{ fnd::hash<char>({ .key = text }) };
+          auto const interned{ fnd::name_table::intern(hash, bytes_of(text)) };
+          if (text_of(interned) != text) { mismatches.fetch_add(1); }
+        }
+      });
+    }
+    threads.clear();
+    REQUIRE(mismatches.load() == 0);
+
+    for (auto const &text : texts) {
+      auto const hash{ fnd::hash<char>({ .key = text }) };
+      REQUIRE(text_of(fnd::name_table::find(hash)) == text);
+    }
+  } // SECTION("concurrent interning")
+
+#if defined(GZN_INTERNED_NAMES)
+  SECTION("interned names") {
+    REQUIRE(sizeof(fnd::s8name) == sizeof(u64));
+
+    fnd::s8name const name{ "shaders/lit" };
+    REQUIRE(name.str_view() == "shaders/lit");
+    REQUIRE(name == fnd::s8name{ std::string{ "shaders/lit" } });
+    REQUIRE(fnd::s8name{ name.view() }.size() == 11);
+  } // SECTION("interned names")
+#endif
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/pool.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+TEST_CASE("test: gzn::fnd::pool", "[fnd][pool]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-pool" };
+
+  SECTION("insert/remove") {
+    fnd::pool<std::string> strings{ alloc, 4 };
+    REQUIRE(strings.is_valid());
+    REQUIRE(strings.empty());
+
+    auto const a{ strings.insert("a") };
+    auto const b{ strings.emplace(64uz, 'b') };
+    auto const c{ strings.insert("c") };
+    REQUIRE(strings.size() == 3);
+    REQUIRE(*strings.get(b) == std::string(64, 'b'));
+
+    REQUIRE(strings.remove(a));
+    REQUIRE_FALSE(strings.remove(a));
+    REQUIRE(strings.get(a) == nullptr);
+    REQUIRE(*strings.get(c) == "c");
+    REQUIRE(*strings.get(b) == std::string(64, 'b'));
+
+    auto const d{ strings.insert("d") };
+    REQUIRE(d.location == a.location);
+    REQUIRE_FALSE(d == a);
+    REQUIRE(strings.get(a) == nullptr);
+    REQUIRE(*strings.get(d) == "d");
+
+    strings.insert("e");
+    REQUIRE(strings.full());
+    REQUIRE_FALSE(strings.insert("f").is_valid());
+
+    std::vector<std::string> values{ strings.begin(), strings.end() };
+    std::ranges::sort(values);
+    REQUIRE(values.size() == 4);
+    REQUIRE(values[0] == std::string(64, 'b'));
+    REQUIRE(values[3] == "e");
+
+    for (usize i{}; i < strings.size(); ++i) {
+      auto const handle{ strings.handle_at(i) };
+      REQUIRE(strings.get(handle) == strings.begin() + i);
+    }
+
+    strings.clear();
+    REQUIRE(strings.empty());
+    REQUIRE(strings.get(d) == nullptr);
+  } // SECTION("insert/remove")
+
+  SECTION("generations") {
+    fnd::pool<u32> narrow{ alloc, 1 };
+    auto const first{ narrow.insert(0) };
+    for (u32 i{}; i < 128; ++i) {
+      narrow.remove(narrow.handle_at(0));
+      narrow.insert(i);
+    }
+    // 8-bit generations wrap after 128 reuses
+    REQUIRE(narrow.contains(first));
+
+    fnd::pool<u32, fnd::gen_counter32> wide{ alloc, 1 };
+    auto const wide_first{ wide.insert(0) };
+    for (u32 i{}; i < 128; ++i) {
+      wide.remove(wide.handle_at(0));
+      wide.insert(i);
+    }
+    REQUIRE_FALSE(wide.contains(wide_first));
+    REQUIRE(*wide.get(wide.handle_at(0)) == 127);
+  } // SECTION("generations")
+
+  SECTION("external storage") {
+    using pool_type = fnd::non_owning_pool<u64>;
+    alignas(pool_type::storage_alignment)
+      byte storage[pool_type::get_size_for(8)];
+
+    pool_type values{ storage, 8 };
+    for (u64 i{}; i < 8; ++i) { values.insert(i); }
+    values.remove(values.handle_at(0));
+    REQUIRE(values.size() == 7);
+    REQUIRE(values.values()[0] == 7);
+  } // SECTION("external storage")
+
+  REQUIRE(cmn::live_bytes_count(alloc) == 0);
+}
@@ -0,0 +1,176 @@
+#include <array>
+#include <span>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/small-array.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+TEST_CASE("test: gzn::fnd::small_array", "[fnd][small-array]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-small-array" };
+
+  SECTION("inline storage") {
+    auto const before{ cmn::allocations_count(alloc) };
+
+    fnd::small_array<int, 4, decltype(alloc)> arr{ alloc };
+    REQUIRE(arr.is_inline());
+    REQUIRE(arr.capacity() == 4);
+    REQUIRE(arr.front() == nullptr);
+
+    for (int i{}; i < 4; ++i) { arr.push_back(i); }
+    REQUIRE(arr.is_inline());
+    REQUIRE(arr.size() == 4);
+    REQUIRE(*arr.back() == 3);
+    REQUIRE(cmn::allocations_count(alloc) == before);
+
+    arr.push_back(4);
+    REQUIRE_FALSE(arr.is_inline());
+    REQUIRE(arr.capacity() > 4);
+    REQUIRE(cmn::allocations_count(alloc) == before + 1);
+    for (int i{}; i < 5; ++i) { REQUIRE(arr[i] == i); }
+
+    arr.pop_back();
+    REQUIRE(arr.shrink_to_fit() == 4);
+    REQUIRE(arr.is_inline());
+    for (int i{}; i < 4; ++i) { REQUIRE(arr[i] == i); }
+    REQUIRE(cmn::live_bytes_count(alloc) == 0);
+  } // SECTION("inline storage")
+
+  SECTION("push an element of a full heap array") {
+    // The tracking allocator can't resize in place, base_allocator can
+    fnd::base_allocator      base{};
+    fnd::small_array<u64, 2> arr{ base };
+    arr.push_back(100);
+    // Every growth of the heap block goes through a resize in place
+    for (u32 i{}; i < 1000; ++i) { arr.push_back(arr[0]); }
+    REQUIRE(arr.size() == 1001);
+    REQUIRE(*arr.back() == 100);
+
+    fnd::small_array<std::string, 1> strings{ base };
+    strings.push_back(std::string(32, 'a'));
+    strings.push_back(std::string(32, 'b'));
+    for (u32 i{}; i < 100; ++i) { strings.push_back(strings[0]); }
+    REQUIRE(*strings.back() == std::string(32, 'a'));
+  } // SECTION("push an element of a full heap array")
+
+  SECTION("non-trivial elements") {
+    using strings = fnd::small_array<std::string, 2, decltype(alloc)>;
+
+    strings arr{
+      alloc,
+      { std::string{ "a" }, std::string{ "b" } }
+    };
+    REQUIRE(arr.is_inline());
+
+    arr.push_back(std::string(64, 'c'));
+    arr.push_back(arr[0]);
+    REQUIRE(arr.size() == 4);
+    REQUIRE(arr[3] == "a");
+    REQUIRE(arr[2] == std::string(64, 'c'));
+
+    REQUIRE(*arr.erase(arr.begin() + 1) == std::string(64, 'c'));
+    REQUIRE(arr.size() == 3);
+
+    strings const copy{ arr };
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy[2] == "a");
+
+    strings moved{ std::move(arr) };
+    REQUIRE(moved.size() == 3);
+    REQUIRE(arr.empty());
+    REQUIRE(arr.is_inline());
+
+    strings small{ alloc };
+    small.emplace_back("x");
+    strings moved_inline{ std::move(small) };
+    REQUIRE(moved_inline.is_inline());
+    REQUIRE(moved_inline[0] == "x");
+    REQUIRE(small.empty());
+
+    moved_inline = std::move(moved);
+    REQUIRE(moved_inline.size() == 3);
+    REQUIRE(moved_inline[0] == "a");
+
+    moved_inline.resize(1);
+    REQUIRE(moved_inline.size() == 1);
+    moved_inline.resize(3, "z");
+    REQUIRE(moved_inline[2] == "z");
+    moved_inline.resize(8, moved_inline[0]);
+    REQUIRE(moved_inline[7] == "a");
+  } // SECTION("non-trivial elements")
+
+  SECTION("bulk operations") {
+    using strings = fnd::small_array<std::string, 4, decltype(alloc)>;
+
+    std::array const values{
+      std::string(32, 'a'), std::string(32, 'b'), std::string(32, 'c')
+    };
+
+    strings arr{ alloc };
+    REQUIRE(*arr.append_range(values) == values[0]);
+    REQUIRE(arr.is_inline());
+
+    auto const tail{ arr.append_range(values) };
+    REQUIRE_FALSE(arr.is_inline());
+    REQUIRE(tail == arr.begin() + 3);
+    REQUIRE(arr.size() == 6);
+    REQUIRE(arr[5] == values[2]);
+
+    auto const gap{
+      arr.insert(arr.begin() + 1, values.begin(), values.begin() + 2)
+    };
+    REQUIRE(gap == arr.begin() + 1);
+    REQUIRE(arr.size() == 8);
+    REQUIRE(arr[0] == values[0]);
+    REQUIRE(arr[1] == values[0]);
+    REQUIRE(arr[2] == values[1]);
+    REQUIRE(arr[3] == values[1]);
+    REQUIRE(arr[7] == values[2]);
+
+    REQUIRE(*arr.emplace_back_n(3, std::string(4, 'x')) == "xxxx");
+    REQUIRE(arr.size() == 11);
+    REQUIRE(arr[10] == "xxxx");
+
+    arr.assign(std::span{ arr }.subspan(8, 3));
+    REQUIRE(arr.size() == 3);
+    REQUIRE(arr.is_inline());
+    REQUIRE(arr[0] == "xxxx");
+
+    arr.assign(5, arr[0]);
+    REQUIRE(arr.size() == 5);
+    REQUIRE(arr[4] == "xxxx");
+
+    arr.assign(values);
+    REQUIRE(arr.size() == 3);
+    REQUIRE(arr[1] == values[1]);
+
+    fnd::small_array<u8, 16, decltype(alloc)> bytes{ alloc };
+    bytes.resize_uninitialized(64);
+    REQUIRE(bytes.size() == 64);
+    REQUIRE_FALSE(bytes.is_inline());
+  } // SECTION("bulk operations")
+
+  SECTION("shrink on the heap") {
+    fnd::small_array<std::string, 2, decltype(alloc)> arr{ alloc, 64 };
+    for (int i{}; i < 8; ++i) { arr.push_back(std::string(32, 'a')); }
+
+    auto const before{ arr.data() };
+    REQUIRE(arr.shrink_to_fit() == 8);
+    REQUIRE(arr.capacity() == 8);
+    REQUIRE(arr.data() != before);
+    REQUIRE(arr[7] == std::string(32, 'a'));
+  } // SECTION("shrink on the heap")
+
+  SECTION("allocator context") {
+    fnd::small_array<int, 8, fnd::any_allocator> arr{};
+    REQUIRE(arr.get_allocator().is_default());
+
+    std::array constexpr values{ 1, 2, 3 };
+    fnd::small_array<int, 8> const from_range{ alloc.get_allocator(), values };
+    REQUIRE(from_range.size() == 3);
+    REQUIRE(from_range.is_inline());
+  } // SECTION("allocator context")
+}
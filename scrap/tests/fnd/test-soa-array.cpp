@@ -0,0 +1,93 @@
+#include <bit>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/soa-array.hpp>
+
+#include "common/tracked-allocator.hpp"
+
+TEST_CASE("test: gzn::fnd::soa_array", "[fnd][soa-array]") {
+  using namespace gzn;
+
+  cmn::tracked_allocator alloc{ "test-soa-array" };
+
+  using entities = fnd::basic_soa_array<
+    decltype(alloc),
+    fnd::soa_array_twicks,
+    float,
+    u8,
+    std::string>;
+
+  SECTION("columns") {
+    entities arr{ alloc };
+    REQUIRE(arr.empty());
+    REQUIRE(arr.column<0>().empty());
+
+    for (u32 i{}; i < 100; ++i) {
+      arr.emplace_back(static_cast<float>(i), u8(i % 2), std::to_string(i));
+    }
+    REQUIRE(arr.size() == 100);
+    REQUIRE(cmn::allocations_count(alloc) > 1);
+
+    auto const xs{ arr.column<0>() };
+    auto const flags{ arr.column<1>() };
+    REQUIRE(xs.size() == 100);
+    REQUIRE(std::bit_cast<usize>(xs.data()) % 64 == 0);
+    REQUIRE(std::bit_cast<usize>(flags.data()) % 64 == 0);
+
+    float sum{};
+    for (auto const x : xs) { sum += x; }
+    REQUIRE(sum == 4'950.0f);
+    for (auto &x : arr.column<0>()) { x *= 2.0f; }
+
+    auto const [x, flag, name] { arr[51] };
+    REQUIRE(x == 102.0f);
+    REQUIRE(flag == 1);
+    REQUIRE(name == "51");
+  } // SECTION("columns")
+
+  SECTION("swap erase") {
+    entities arr{ alloc, 4 };
+    REQUIRE(arr.capacity() == 4);
+    arr.push_back(0.0f, 0, "zero");
+    arr.push_back(1.0f, 1, "one");
+    arr.push_back(2.0f, 2, "two");
+
+    arr.swap_erase(0);
+    REQUIRE(arr.size() == 2);
+    REQUIRE(std::get<0>(arr[0]) == 2.0f);
+    REQUIRE(std::get<1>(arr[0]) == 2);
+    REQUIRE(std::get<2>(arr[0]) == "two");
+
+    arr.swap_erase(1);
+    arr.pop_back();
+    REQUIRE(arr.empty());
+  } // SECTION("swap erase")
+
+  SECTION("copy, move & resize") {
+    entities arr{ alloc };
+    arr.resize(10);
+    REQUIRE(arr.size() == 10);
+    REQUIRE(std::get<2>(arr[9]).empty());
+    std::get<2>(arr[3]) = std::string(64, 's');
+
+    entities const copy{ arr };
+    REQUIRE(copy.size() == 10);
+    REQUIRE(std::get<2>(copy[3]) == std::string(64, 's'));
+
+    entities moved{ std::move(arr) };
+    REQUIRE(arr.empty());
+    REQUIRE(moved.size() == 10);
+
+    moved.resize(2);
+    REQUIRE(moved.shrink_to_fit() == 2);
+    REQUIRE(moved.capacity() == 2);
+    moved.emplace_back(1.0f, 1, std::get<2>(moved[0]));
+
+    moved.reset();
+    arr = copy;
+    REQUIRE(arr.size() == 10);
+  } // SECTION("copy, move & resize")
+
+  REQUIRE(cmn::live_bytes_count(alloc) == 0);
+}
@@ -0,0 +1,84 @@
+#include <array>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <gzn/fnd/containers/spsc-ring.hpp>
+
+TEST_CASE("test: gzn::fnd::spsc_ring", "[fnd][spsc-ring]") {
+  using namespace gzn;
+
+  fnd::base_allocator alloc{};
+
+  SECTION("single thread") {
+    fnd::spsc_ring<std::unique_ptr<u32>> ring{ alloc, 3 };
+    REQUIRE(ring.capacity() == 4);
+    REQUIRE(ring.empty());
+
+    for (u32 i{}; i < 4; ++i) {
+      REQUIRE(ring.try_push(std::make_unique<u32>(i)));
+    }
+    REQUIRE_FALSE(ring.try_push(std::make_unique<u32>(4)));
+
+    std::unique_ptr<u32> value{};
+    REQUIRE(ring.try_pop(value));
+    REQUIRE(*value == 0);
+    REQUIRE(ring.try_emplace(std::make_unique<u32>(4)));
+    REQUIRE(ring.size() == 4);
+
+    std::array<std::unique_ptr<u32>, 8> out{};
+    REQUIRE(ring.pop_n(std::data(out), std::size(out)) == 4);
+    REQUIRE(*out[0] == 1);
+    REQUIRE(*out[3] == 4);
+    REQUIRE_FALSE(ring.try_pop(value));
+
+    // Left in the ring, the destructor has to release it
+    REQUIRE(ring.try_push(std::make_unique<u32>(5)));
+  } // SECTION("single thread")
+
+  SECTION("batches wrap around") {
+    fnd::spsc_ring<u32> ring{ alloc, 8 };
+    std::array<u32, 6> in{};
+    std::array<u32, 6> out{};
+
+    for (u32 round{}; round < 10; ++round) {
+      std::iota(std::begin(in), std::end(in), round * 6);
+      REQUIRE(ring.push_n(std::data(in), std::size(in)) == 6);
+      REQUIRE(ring.push_n(std::data(in), std::size(in)) == 2);
+      REQUIRE(ring.pop_n(std::data(out), std::size(out)) == 6);
+      REQUIRE(out == in);
+
+      u32 tail[2]{};
+      REQUIRE(ring.pop_n(tail, 2) == 2);
+      REQUIRE(tail[1] == round * 6 + 1);
+    }
+  } // SECTION("batches wrap around")
+
+  SECTION("two threads") {
+    u64 constexpr count{ 200'000 };
+    fnd::spsc_ring<u64> ring{ alloc, 64 };
+
+    std::thread producer{ [&ring] {
+      std::array<u64, 16> batch{};
+      for (u64 next{}; next < count;) {
+        std::iota(std::begin(batch), std::end(batch), next);
+        auto const left{ std::min<u64>(std::size(batch), count - next) };
+        next += ring.push_n(std::data(batch), left);
+      }
+    } };
+
+    u64  expected{};
+    bool ordered{ true };
+    while (expected < count) {
+      if (u64 value{}; ring.try_pop(value)) {
+        ordered = ordered && value == expected;
+        ++expected;
+      }
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(ring.empty());
+  } // SECTION("two threads")
+}